@@ -18,6 +18,10 @@ function(add_onnx_global_defines target)
   if(ONNX_USE_LITE_PROTO)
     target_compile_definitions(${target} PUBLIC "ONNX_USE_LITE_PROTO=1")
   endif()
+
+  if(ONNX_LAZY_SCHEMAS)
+    target_compile_definitions(${target} PUBLIC "ONNX_LAZY_SCHEMAS=1")
+  endif()
 endfunction()
 
 function(add_whole_archive_flag lib output_var)
@@ -1,13 +1,20 @@
 #include "onnx/checker.h"
+#include "onnx/common/file_utils.h"
 #include "onnx/defs/schema.h"
 #include "onnx/defs/tensor_proto_util.h"
 #include "onnx/proto_utils.h"
 #include "onnx/string_utils.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <fstream>
-#include <iterator>
+#include <system_error>
+#include <thread>
 #include <unordered_set>
 
+#include <sys/stat.h>
+
 namespace ONNX_NAMESPACE {
 namespace checker {
 
@@ -38,6 +45,94 @@ namespace checker {
     }                                         \
   } while (0)
 
+namespace {
+
+// Empty slots of LexicalScopeContext's index hold 0, so stored hashes are odd.
+size_t IndexedHash(size_t hash) {
+  return hash | 1;
+}
+
+} // namespace
+
+void LexicalScopeContext::add(const std::string& name) {
+  if (indexed_size_ != output_names.size()) {
+    refresh_index();
+  }
+  if (output_names.insert(name).second) {
+    index(std::hash<std::string>()(name));
+    indexed_size_ = output_names.size();
+  }
+}
+
+bool LexicalScopeContext::this_graph_has(const std::string& name) const {
+  return has(name, std::hash<std::string>()(name));
+}
+
+bool LexicalScopeContext::this_or_ancestor_graph_has(
+    const std::string& name) const {
+  const size_t hash = std::hash<std::string>()(name);
+  for (const LexicalScopeContext* scope = this; scope;
+       scope = scope->parent_context_) {
+    if (scope->has(name, hash)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LexicalScopeContext::has(const std::string& name, size_t hash) const {
+  if (indexed_size_ != output_names.size()) {
+    return output_names.count(name) != 0;
+  }
+  if (hash_slots_.empty()) {
+    return false;
+  }
+  const size_t key = IndexedHash(hash);
+  const size_t mask = hash_slots_.size() - 1;
+  for (size_t i = key & mask; hash_slots_[i] != 0; i = (i + 1) & mask) {
+    if (hash_slots_[i] == key) {
+      // Only the hash is indexed, so confirm the name itself.
+      return output_names.count(name) != 0;
+    }
+  }
+  return false;
+}
+
+void LexicalScopeContext::refresh_index() {
+  hash_slots_.clear();
+  indexed_size_ = 0;
+  for (const auto& name : output_names) {
+    index(std::hash<std::string>()(name));
+    ++indexed_size_;
+  }
+}
+
+void LexicalScopeContext::index(size_t hash) {
+  // Keep the load factor at or below 1/2 so probe sequences stay short.
+  if (2 * (indexed_size_ + 1) > hash_slots_.size()) {
+    std::vector<size_t> old_slots(
+        std::max<size_t>(16, 2 * hash_slots_.size()), 0);
+    old_slots.swap(hash_slots_);
+    const size_t mask = hash_slots_.size() - 1;
+    for (size_t slot : old_slots) {
+      if (slot != 0) {
+        size_t i = slot & mask;
+        while (hash_slots_[i] != 0) {
+          i = (i + 1) & mask;
+        }
+        hash_slots_[i] = slot;
+      }
+    }
+  }
+  const size_t key = IndexedHash(hash);
+  const size_t mask = hash_slots_.size() - 1;
+  size_t i = key & mask;
+  while (hash_slots_[i] != 0) {
+    i = (i + 1) & mask;
+  }
+  hash_slots_[i] = key;
+}
+
 void check_value_info(
     const ValueInfoProto& value_info,
     const CheckerContext& ctx) {
@@ -81,6 +176,82 @@ void check_value_info(
   }
 }
 
+int64_t ExternalDataFileCache::get_file_size(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = file_sizes_.find(path);
+  if (it != file_sizes_.end()) {
+    return it->second;
+  }
+  int64_t file_size = -1;
+#ifdef _WIN32
+  struct _stat64 st;
+  bool is_file = _stat64(path.c_str(), &st) == 0 && (st.st_mode & _S_IFREG);
+#else
+  struct stat st;
+  bool is_file = stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+#endif
+  if (is_file && std::ifstream(path)) {
+    file_size = static_cast<int64_t>(st.st_size);
+  }
+  file_sizes_.emplace(path, file_size);
+  return file_size;
+}
+
+bool ValidationCache::contains(const std::string& key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return validated_.count(key) != 0;
+}
+
+std::shared_ptr<const ValidationCache::ScopeNames> ValidationCache::find(
+    const std::string& key) const {
+  static const std::shared_ptr<const ScopeNames> no_names =
+      std::make_shared<ScopeNames>();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = validated_.find(key);
+  if (it == validated_.end()) {
+    return nullptr;
+  }
+  return it->second ? it->second : no_names;
+}
+
+void ValidationCache::insert(
+    const std::string& key,
+    std::shared_ptr<const ScopeNames> names) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  validated_[key] = std::move(names);
+}
+
+void ValidationCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  validated_.clear();
+}
+
+size_t ValidationCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return validated_.size();
+}
+
+// Parse the value of an integer entry ("offset" or "length") of the
+// external_data field of tensor.
+static int64_t parse_external_data_integer(
+    const TensorProto& tensor,
+    const StringStringEntryProto& entry) {
+  const std::string& value = entry.value();
+  if (value.empty() ||
+      value.find_first_not_of("0123456789") != std::string::npos ||
+      value.size() > 18) {
+    fail_check(
+        "TensorProto ( tensor name: ",
+        tensor.name(),
+        ") has an invalid external data ",
+        entry.key(),
+        ": '",
+        value,
+        "'. It must be a non-negative integer.");
+  }
+  return static_cast<int64_t>(std::stoll(value));
+}
+
 void check_tensor(const TensorProto& tensor, const CheckerContext& ctx) {
   enforce_has_field(tensor, data_type);
   if (tensor.data_type() == TensorProto::UNDEFINED) {
@@ -122,26 +293,51 @@ void check_tensor(const TensorProto& tensor, const CheckerContext& ctx) {
           value_field);
     }
 
-    bool has_location = false;
+    const std::string* location = nullptr;
+    int64_t offset = 0;
+    int64_t length = -1;
     for (const StringStringEntryProto& entry : tensor.external_data()) {
-      if (entry.has_key() && entry.has_value() && entry.key() == "location") {
-        has_location = true;
-        if (!std::ifstream(ctx.get_model_dir() + entry.value())) {
-          fail_check(
-              "Data of TensorProto ( tensor name: ",
-              tensor.name(),
-              ") should be stored in ",
-              ctx.get_model_dir() + entry.value(),
-              ", but it doesn't exist or is not accessible.");
-        }
+      if (!entry.has_key() || !entry.has_value()) {
+        continue;
+      }
+      if (entry.key() == "location") {
+        location = &entry.value();
+      } else if (entry.key() == "offset") {
+        offset = parse_external_data_integer(tensor, entry);
+      } else if (entry.key() == "length") {
+        length = parse_external_data_integer(tensor, entry);
       }
     }
-    if (!has_location) {
+    if (!location) {
       fail_check(
           "TensorProto ( tensor name: ",
           tensor.name(),
           ") is stored externally but doesn't have a location.");
     }
+    const std::string data_path = ctx.get_model_dir() + *location;
+    int64_t file_size = ctx.get_external_data_cache().get_file_size(data_path);
+    if (file_size < 0) {
+      fail_check(
+          "Data of TensorProto ( tensor name: ",
+          tensor.name(),
+          ") should be stored in ",
+          data_path,
+          ", but it doesn't exist or is not accessible.");
+    }
+    if (offset + (length < 0 ? 0 : length) > file_size) {
+      fail_check(
+          "Data of TensorProto ( tensor name: ",
+          tensor.name(),
+          ") is stored in ",
+          data_path,
+          " at offset ",
+          offset,
+          length < 0 ? "" : " with length ",
+          length < 0 ? "" : ONNX_NAMESPACE::to_string(length),
+          ", which is outside of the file of size ",
+          file_size,
+          ".");
+    }
     return;
   }
   int64_t nelem = 1;
@@ -519,19 +715,30 @@ void check_node(
   }
 
   // Resolve domain for node
-  const auto& opset_imports = ctx.get_opset_imports();
-  auto dit = opset_imports.find(node.domain());
-  if (dit == opset_imports.end()) {
+  SchemaResolutionCache* schema_cache = ctx.get_schema_cache();
+  const int* imported_version = nullptr;
+  if (schema_cache) {
+    imported_version = schema_cache->GetDomainVersion(node.domain());
+  } else {
+    const auto& opset_imports = ctx.get_opset_imports();
+    auto dit = opset_imports.find(node.domain());
+    if (dit != opset_imports.end()) {
+      imported_version = &dit->second;
+    }
+  }
+  if (!imported_version) {
     fail_check("No opset import for domain '" + node.domain() + "'");
   }
-  auto domain_version = dit->second;
+  auto domain_version = *imported_version;
 
   for (const auto& attr : node.attribute()) {
     check_attribute(attr, ctx, lex_ctx);
   }
 
-  const auto* schema = ctx.get_schema_registry()->GetSchema(
-      node.op_type(), domain_version, node.domain());
+  const auto* schema = schema_cache
+      ? schema_cache->GetSchema(node.op_type(), node.domain())
+      : ctx.get_schema_registry()->GetSchema(
+            node.op_type(), domain_version, node.domain());
   if (!schema) {
     if (node.domain() == ONNX_DOMAIN || node.domain() == AI_ONNX_ML_DOMAIN ||
         node.domain() == "ai.onnx" || node.domain() == AI_ONNX_TRAINING_DOMAIN) {
@@ -557,17 +764,378 @@ void check_node(
   }
 }
 
-void check_graph(
+// Run check(i) for every i in [0, count) on up to num_threads threads.
+// Returns the exception raised for each index (null if the check passed), so
+// that callers can rethrow them in the same order as a sequential check.
+template <typename Check>
+std::vector<std::exception_ptr>
+run_parallel_checks(size_t count, int num_threads, const Check& check) {
+  std::vector<std::exception_ptr> errors(count);
+  std::atomic<size_t> next_index{0};
+  auto worker = [&]() {
+    for (size_t i = next_index++; i < count; i = next_index++) {
+      try {
+        check(i);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+
+  size_t num_workers =
+      std::min(count, static_cast<size_t>(std::max(num_threads, 1)));
+  std::vector<std::thread> workers;
+  try {
+    for (size_t t = 1; t < num_workers; ++t) {
+      workers.emplace_back(worker);
+    }
+  } catch (const std::system_error&) {
+    // Out of threads: the ones started and this thread do all the checks.
+  }
+  worker();
+  for (auto& w : workers) {
+    w.join();
+  }
+  return errors;
+}
+
+// Prefix of the ValidationCache keys of protos checked under ctx. It holds
+// every setting the result of check_node or check_sparse_tensor depends on.
+static std::string validation_cache_prefix(const CheckerContext& ctx) {
+  std::vector<std::pair<std::string, int>> opsets(
+      ctx.get_opset_imports().begin(), ctx.get_opset_imports().end());
+  std::sort(opsets.begin(), opsets.end());
+  std::string prefix = ONNX_NAMESPACE::MakeString(
+      ctx.get_ir_version(),
+      ctx.is_main_graph() ? ";main;" : ";sub;",
+      static_cast<const void*>(ctx.get_schema_registry()),
+      ";",
+      OpSchemaRegistry::GetGeneration(),
+      ";",
+      ctx.get_model_dir().size(),
+      ":",
+      ctx.get_model_dir());
+  for (const auto& opset : opsets) {
+    prefix += ONNX_NAMESPACE::MakeString(
+        ";", opset.first.size(), ":", opset.first, "=", opset.second);
+  }
+  prefix += '\0';
+  return prefix;
+}
+
+// Sparse tensors stored in external files are never cached, since the files
+// may change between checks.
+static bool is_sparse_tensor_cacheable(const SparseTensorProto& sparse) {
+  return sparse.values().data_location() != TensorProto::EXTERNAL &&
+      sparse.indices().data_location() != TensorProto::EXTERNAL;
+}
+
+static bool has_external_data(const NodeProto& node);
+
+static bool has_external_data(const GraphProto& graph) {
+  for (const auto& init : graph.initializer()) {
+    if (init.data_location() == TensorProto::EXTERNAL) {
+      return true;
+    }
+  }
+  for (const auto& sparse_init : graph.sparse_initializer()) {
+    if (!is_sparse_tensor_cacheable(sparse_init)) {
+      return true;
+    }
+  }
+  for (const auto& node : graph.node()) {
+    if (has_external_data(node)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Whether a tensor attribute of node, or of a node of its subgraphs, or an
+// initializer of its subgraphs, is stored in an external file.
+static bool has_external_data(const NodeProto& node) {
+  for (const auto& attr : node.attribute()) {
+    if (attr.has_t() && attr.t().data_location() == TensorProto::EXTERNAL) {
+      return true;
+    }
+    for (const auto& tensor : attr.tensors()) {
+      if (tensor.data_location() == TensorProto::EXTERNAL) {
+        return true;
+      }
+    }
+    if (attr.has_sparse_tensor() &&
+        !is_sparse_tensor_cacheable(attr.sparse_tensor())) {
+      return true;
+    }
+    for (const auto& sparse_tensor : attr.sparse_tensors()) {
+      if (!is_sparse_tensor_cacheable(sparse_tensor)) {
+        return true;
+      }
+    }
+    if (attr.has_g() && has_external_data(attr.g())) {
+      return true;
+    }
+    for (const auto& graph : attr.graphs()) {
+      if (has_external_data(graph)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Nodes with subgraphs are only cached if they hold at most this many bytes
+// per node of their subgraphs, so that serializing them for their key costs
+// less than checking the nodes it saves. Large tensors, such as weights of a
+// Loop body, make them cheaper to check than to key.
+constexpr size_t kMaxCachedBytesPerNode = 4096;
+
+static size_t count_subgraph_nodes(const GraphProto& graph);
+
+static size_t count_subgraph_nodes(const NodeProto& node) {
+  size_t count = 0;
+  for (const auto& attr : node.attribute()) {
+    if (attr.has_g()) {
+      count += count_subgraph_nodes(attr.g());
+    }
+    for (const auto& graph : attr.graphs()) {
+      count += count_subgraph_nodes(graph);
+    }
+  }
+  return count;
+}
+
+static size_t count_subgraph_nodes(const GraphProto& graph) {
+  size_t count = graph.node_size();
+  for (const auto& node : graph.node()) {
+    count += count_subgraph_nodes(node);
+  }
+  return count;
+}
+
+// Whether the validation of node is cached: only nodes with subgraphs, which
+// save checking every node of the subgraphs, and not those using external
+// data, as the files may change between checks.
+static bool is_node_cacheable(const NodeProto& node) {
+  const size_t subgraph_nodes = count_subgraph_nodes(node);
+  return subgraph_nodes > 0 &&
+      node.ByteSizeLong() <= kMaxCachedBytesPerNode * subgraph_nodes &&
+      !has_external_data(node);
+}
+
+static void collect_scope_names(
+    const NodeProto& node,
+    const LexicalScopeContext& lex_ctx,
+    ValidationCache::ScopeNames& names);
+
+// Adds to names those graph, nested in the scope of parent_lex, shares with
+// the scopes enclosing the node being collected, following the lookups of
+// check_graph.
+static void collect_scope_names(
+    const GraphProto& graph,
+    const LexicalScopeContext& parent_lex,
+    ValidationCache::ScopeNames& names) {
+  LexicalScopeContext lex_ctx{parent_lex};
+  for (const auto& value_info : graph.input()) {
+    lex_ctx.add(value_info.name());
+  }
+  for (const auto& init : graph.initializer()) {
+    lex_ctx.add(init.name());
+  }
+  for (const auto& sparse_init : graph.sparse_initializer()) {
+    lex_ctx.add(sparse_init.values().name());
+  }
+  for (const auto& node : graph.node()) {
+    for (const auto& input : node.input()) {
+      if (!input.empty() && !lex_ctx.this_or_ancestor_graph_has(input)) {
+        names.read.push_back(input);
+      }
+    }
+    collect_scope_names(node, lex_ctx, names);
+    for (const auto& output : node.output()) {
+      // Outputs are unique, as the subgraphs are valid.
+      if (!output.empty()) {
+        names.defined.push_back(output);
+        lex_ctx.add(output);
+      }
+    }
+  }
+}
+
+static void collect_scope_names(
+    const NodeProto& node,
+    const LexicalScopeContext& lex_ctx,
+    ValidationCache::ScopeNames& names) {
+  for (const auto& attr : node.attribute()) {
+    if (attr.has_g()) {
+      collect_scope_names(attr.g(), lex_ctx, names);
+    }
+    for (const auto& graph : attr.graphs()) {
+      collect_scope_names(graph, lex_ctx, names);
+    }
+  }
+}
+
+// The names the subgraphs of node, known to be valid, share with the scopes
+// enclosing it.
+static std::shared_ptr<const ValidationCache::ScopeNames> scope_names_of(
+    const NodeProto& node) {
+  std::shared_ptr<ValidationCache::ScopeNames> names =
+      std::make_shared<ValidationCache::ScopeNames>();
+  collect_scope_names(node, LexicalScopeContext(), *names);
+  std::sort(names->read.begin(), names->read.end());
+  names->read.erase(
+      std::unique(names->read.begin(), names->read.end()), names->read.end());
+  return names;
+}
+
+// Whether the subgraphs of a cached node with the given scope names are valid
+// in the scope of lex_ctx.
+static bool scope_names_hold(
+    const ValidationCache::ScopeNames& names,
+    const LexicalScopeContext& lex_ctx) {
+  for (const auto& name : names.read) {
+    if (!lex_ctx.this_or_ancestor_graph_has(name)) {
+      return false;
+    }
+  }
+  for (const auto& name : names.defined) {
+    if (lex_ctx.this_or_ancestor_graph_has(name)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void check_sparse_tensor_cached(
+    const SparseTensorProto& sparse_tensor_proto,
+    const CheckerContext& ctx,
+    const std::string& cache_prefix) {
+  ValidationCache* cache = ctx.get_validation_cache();
+  if (!cache || !is_sparse_tensor_cacheable(sparse_tensor_proto)) {
+    check_sparse_tensor(sparse_tensor_proto, ctx);
+    return;
+  }
+  std::string key = cache_prefix + 's';
+  sparse_tensor_proto.AppendToString(&key);
+  if (cache->contains(key)) {
+    return;
+  }
+  check_sparse_tensor(sparse_tensor_proto, ctx);
+  cache->insert(key);
+}
+
+std::string Diagnostic::to_string() const {
+  if (!node) {
+    return message;
+  }
+  return ONNX_NAMESPACE::MakeString(
+      message, "\n\n==> Context: Bad node spec: ", ProtoDebugString(*node));
+}
+
+static void record_diagnostic(
+    std::vector<Diagnostic>* diagnostics,
+    DiagnosticCode code,
+    const GraphProto* graph,
+    const NodeProto* node,
+    int node_index,
+    std::string message) {
+  Diagnostic diagnostic;
+  diagnostic.code = code;
+  if (graph) {
+    diagnostic.graph_name = graph->name();
+  }
+  diagnostic.node_index = node_index;
+  if (node) {
+    diagnostic.op_type = node->op_type();
+  }
+  diagnostic.message = std::move(message);
+  diagnostic.node = node;
+  diagnostics->push_back(std::move(diagnostic));
+}
+
+// Run check. If ctx collects diagnostics, a ValidationError it throws is
+// recorded and false is returned; otherwise the error propagates, with a dump
+// of node (if any) appended.
+template <typename Check>
+static bool run_check(
+    const CheckerContext& ctx,
+    DiagnosticCode code,
+    const GraphProto* graph,
+    const NodeProto* node,
+    int node_index,
+    Check check) {
+  std::vector<Diagnostic>* diagnostics = ctx.get_diagnostics();
+  try {
+    check();
+  } catch (ValidationError& ex) {
+    if (!diagnostics) {
+      if (node) {
+        ex.AppendContext("Bad node spec: " + ProtoDebugString(*node));
+      }
+      throw;
+    }
+    record_diagnostic(diagnostics, code, graph, node, node_index, ex.what());
+    return false;
+  }
+  return true;
+}
+
+static void check_graph_impl(
     const GraphProto& graph,
     const CheckerContext& ctx,
-    const LexicalScopeContext& parent_lex) {
-  enforce_non_empty_field(graph, name);
+    const LexicalScopeContext& parent_lex,
+    bool scopes_only);
 
-  for (const auto& value_info : graph.input()) {
-    check_value_info(value_info, ctx);
+// Repeat only the name scoping checks of the subgraphs of a node that is
+// otherwise known to be valid: a cached node may still use outer scope values
+// that are no longer defined by the edited graph around it.
+static void check_node_scopes(
+    const NodeProto& node,
+    const CheckerContext& ctx,
+    const LexicalScopeContext& lex_ctx) {
+  for (const auto& attr : node.attribute()) {
+    if (!attr.has_g() && attr.graphs_size() == 0) {
+      continue;
+    }
+    CheckerContext subgraph_ctx(ctx);
+    subgraph_ctx.set_is_main_graph(false);
+    if (attr.has_g()) {
+      check_graph_impl(attr.g(), subgraph_ctx, lex_ctx, true);
+    }
+    for (const auto& graph : attr.graphs()) {
+      check_graph_impl(graph, subgraph_ctx, lex_ctx, true);
+    }
   }
-  for (const auto& value_info : graph.output()) {
-    check_value_info(value_info, ctx);
+}
+
+// With scopes_only set, only graph names, topological order and SSA form are
+// checked, for graphs whose contents are already known to be valid.
+static void check_graph_impl(
+    const GraphProto& graph,
+    const CheckerContext& ctx,
+    const LexicalScopeContext& parent_lex,
+    bool scopes_only) {
+  std::vector<Diagnostic>* diagnostics = ctx.get_diagnostics();
+  run_check(ctx, DiagnosticCode::InvalidGraph, &graph, nullptr, -1, [&]() {
+    enforce_non_empty_field(graph, name);
+  });
+
+  if (!scopes_only) {
+    auto check_value_infos =
+        [&](const google::protobuf::RepeatedPtrField<ValueInfoProto>& infos) {
+          for (const auto& value_info : infos) {
+            run_check(
+                ctx,
+                DiagnosticCode::InvalidValueInfo,
+                &graph,
+                nullptr,
+                -1,
+                [&]() { check_value_info(value_info, ctx); });
+          }
+        };
+    check_value_infos(graph.input());
+    check_value_infos(graph.output());
   }
 
   // Inherit values available in outer scope
@@ -579,38 +1147,97 @@ void check_graph(
     // TODO: If shadowing isn't allowed, this should maybe use
     // this_or_ancestor_graph_has
     if (lex_ctx.this_graph_has(value_info.name())) {
-      fail_check(
-          "Graph must be in single static assignment (SSA) form, however '",
-          value_info.name(),
-          "' has been used as graph input names multiple times.");
+      run_check(ctx, DiagnosticCode::NotSSA, &graph, nullptr, -1, [&]() {
+        fail_check(
+            "Graph must be in single static assignment (SSA) form, however '",
+            value_info.name(),
+            "' has been used as graph input names multiple times.");
+      });
+      continue;
     }
     lex_ctx.add(value_info.name());
   }
 
-  for (const auto& init : graph.initializer()) {
+  // Tensor contents are independent of each other, so in parallel mode they
+  // are validated up front. Failures are rethrown below at the position the
+  // sequential check would have raised them, keeping errors deterministic.
+  const bool check_contents = !scopes_only;
+  const bool parallel = check_contents && ctx.get_num_threads() > 1;
+  ValidationCache* cache = scopes_only ? nullptr : ctx.get_validation_cache();
+  const std::string cache_prefix =
+      cache ? validation_cache_prefix(ctx) : std::string();
+  std::vector<std::exception_ptr> init_errors;
+  std::vector<std::exception_ptr> sparse_init_errors;
+  if (parallel) {
+    init_errors = run_parallel_checks(
+        graph.initializer_size(), ctx.get_num_threads(), [&](size_t i) {
+          check_tensor(graph.initializer(static_cast<int>(i)), ctx);
+        });
+    sparse_init_errors = run_parallel_checks(
+        graph.sparse_initializer_size(),
+        ctx.get_num_threads(),
+        [&](size_t i) {
+          check_sparse_tensor_cached(
+              graph.sparse_initializer(static_cast<int>(i)),
+              ctx,
+              cache_prefix);
+        });
+  }
+
+  for (int i = 0; i < graph.initializer_size(); ++i) {
+    const auto& init = graph.initializer(i);
     if (ctx.get_ir_version() <= 0x00000003) {
       // Initializers are a subset of graph inputs for IR_VERSION <= 3
       if (!lex_ctx.this_graph_has(init.name())) {
-        fail_check(init.name() + " in initializer but not in graph input");
+        run_check(
+            ctx,
+            DiagnosticCode::InvalidInitializer,
+            &graph,
+            nullptr,
+            -1,
+            [&]() {
+              fail_check(
+                  init.name() + " in initializer but not in graph input");
+            });
       }
     } else {
       // An initializer is allowed to have the same name as an input,
       // but is not required to (for IR_VERSION >= 4)
       lex_ctx.add(init.name());
     }
-    check_tensor(init, ctx);
+    if (check_contents) {
+      run_check(
+          ctx, DiagnosticCode::InvalidInitializer, &graph, nullptr, -1, [&]() {
+            if (!parallel) {
+              check_tensor(init, ctx);
+            } else if (init_errors[i]) {
+              std::rethrow_exception(init_errors[i]);
+            }
+          });
+    }
   }
 
   // TODO: Need to check that sparse-initializers names are distinct from
   // initializer names. It looks like the existing checker does not check for
   // certain duplication of names: e.g., two entries in the initializer list
   // with same name. Will add a new integrated check.
-  for (const auto& sparse_init : graph.sparse_initializer()) {
-    check_sparse_tensor(sparse_init, ctx);
+  for (int i = 0; i < graph.sparse_initializer_size(); ++i) {
+    const auto& sparse_init = graph.sparse_initializer(i);
+    if (check_contents) {
+      run_check(
+          ctx, DiagnosticCode::InvalidInitializer, &graph, nullptr, -1, [&]() {
+            if (!parallel) {
+              check_sparse_tensor_cached(sparse_init, ctx, cache_prefix);
+            } else if (sparse_init_errors[i]) {
+              std::rethrow_exception(sparse_init_errors[i]);
+            }
+          });
+    }
     lex_ctx.add(sparse_init.values().name());
   }
 
-  for (const auto& node : graph.node()) {
+  for (int node_index = 0; node_index < graph.node_size(); ++node_index) {
+    const auto& node = graph.node(node_index);
     // nodes must be in topologically sorted order
     for (const auto& input : node.input()) {
       // explicit optional input
@@ -618,12 +1245,28 @@ void check_graph(
         continue;
       }
       if (!lex_ctx.this_or_ancestor_graph_has(input)) {
-        fail_check(
-            "Nodes in a graph must be topologically sorted, however input '",
-            input,
-            "' of node: \n",
-            ProtoDebugString(node),
-            "\n is not output of any previous nodes.");
+        if (!diagnostics) {
+          fail_check(
+              "Nodes in a graph must be topologically sorted, however input '",
+              input,
+              "' of node: \n",
+              ProtoDebugString(node),
+              "\n is not output of any previous nodes.");
+        }
+        // The node dump is left to Diagnostic::to_string.
+        record_diagnostic(
+            diagnostics,
+            DiagnosticCode::UnsortedNode,
+            &graph,
+            &node,
+            node_index,
+            ONNX_NAMESPACE::MakeString(
+                "Nodes in a graph must be topologically sorted, however "
+                "input '",
+                input,
+                "' of node ",
+                node_index,
+                " is not output of any previous nodes."));
       }
     }
 
@@ -631,11 +1274,30 @@ void check_graph(
     // find that outputs from control flow ops are colliding with names in the
     // inner block
 
-    try {
-      check_node(node, ctx, lex_ctx);
-    } catch (ValidationError& ex) {
-      ex.AppendContext("Bad node spec: " + ProtoDebugString(node));
-      throw ex;
+    const bool cache_node = cache && is_node_cacheable(node);
+    std::string node_key;
+    if (cache_node) {
+      node_key = cache_prefix + 'n';
+      node.AppendToString(&node_key);
+    }
+    std::shared_ptr<const ValidationCache::ScopeNames> cached_names =
+        cache_node ? cache->find(node_key) : nullptr;
+    if (cached_names && scope_names_hold(*cached_names, lex_ctx)) {
+      // Valid as before: its subgraphs see the outer names they did then.
+    } else if (!check_contents || cached_names) {
+      // Reports the scope errors of the subgraphs.
+      check_node_scopes(node, ctx, lex_ctx);
+    } else {
+      // Errors in subgraphs are recorded without failing the node itself.
+      const size_t recorded = diagnostics ? diagnostics->size() : 0;
+      bool valid = run_check(
+          ctx, DiagnosticCode::InvalidNode, &graph, &node, node_index, [&]() {
+            check_node(node, ctx, lex_ctx);
+          });
+      if (valid && cache_node &&
+          (!diagnostics || diagnostics->size() == recorded)) {
+        cache->insert(node_key, scope_names_of(node));
+      }
     }
     // check for SSA form
     for (const auto& output : node.output()) {
@@ -645,16 +1307,34 @@ void check_graph(
       }
 
       if (lex_ctx.this_or_ancestor_graph_has(output)) {
-        fail_check(
+        std::string message = ONNX_NAMESPACE::MakeString(
             "Graph must be in single static assignment (SSA) form, however '",
             output,
             "' has been used as output names multiple times.");
+        if (!diagnostics) {
+          throw ValidationError(message);
+        }
+        record_diagnostic(
+            diagnostics,
+            DiagnosticCode::NotSSA,
+            &graph,
+            &node,
+            node_index,
+            std::move(message));
+        continue;
       }
       lex_ctx.add(output);
     }
   }
 }
 
+void check_graph(
+    const GraphProto& graph,
+    const CheckerContext& ctx,
+    const LexicalScopeContext& parent_lex) {
+  check_graph_impl(graph, ctx, parent_lex, false);
+}
+
 void check_function(
     const FunctionProto& function,
     const CheckerContext& ctx,
@@ -670,6 +1350,8 @@ void check_function(
     opsets[domain] = static_cast<int>(version);
   }
   ctx_copy.set_opset_imports(opsets);
+  ctx_copy.set_schema_cache(std::make_shared<SchemaResolutionCache>(
+      ctx_copy.get_opset_imports(), ctx_copy.get_schema_registry()));
 
   LexicalScopeContext lex_ctx{parent_lex};
 
@@ -742,7 +1424,8 @@ void check_function(
   }
 }
 
-void check_model(const ModelProto& model, CheckerContext& ctx) {
+// Model level checks, which must pass before the graph can be checked.
+static void check_model_header(const ModelProto& model, CheckerContext& ctx) {
   if (!model.ir_version()) {
     fail_check("The model does not have an ir_version set properly.");
   }
@@ -777,35 +1460,49 @@ void check_model(const ModelProto& model, CheckerContext& ctx) {
           "model with IR version < 3 cannot have opset_import specified");
   }
   ctx.set_opset_imports(opset_imports);
+}
+
+void check_model(const ModelProto& model, CheckerContext& ctx) {
+  // Without valid IR version and opset imports, every node would fail.
+  bool valid = run_check(
+      ctx, DiagnosticCode::InvalidModel, nullptr, nullptr, -1, [&]() {
+        check_model_header(model, ctx);
+      });
+  if (!valid) {
+    return;
+  }
+  // The caches live for this run only, so they are installed on a copy and
+  // not left on the caller's context.
+  CheckerContext run_ctx = ctx;
+  run_ctx.set_external_data_cache(std::make_shared<ExternalDataFileCache>());
+  run_ctx.set_schema_cache(std::make_shared<SchemaResolutionCache>(
+      run_ctx.get_opset_imports(), run_ctx.get_schema_registry()));
   LexicalScopeContext lex_ctx;
-  check_graph(model.graph(), ctx, lex_ctx);
+  check_graph(model.graph(), run_ctx, lex_ctx);
 }
 
 void check_model(const std::string& model_path) {
   ModelProto model;
-  std::fstream model_stream(model_path, std::ios::in | std::ios::binary);
-  if (!model_stream.good()) {
-    fail_check(
-        "Unable to open model file:",
-        model_path,
-        ". Please check if it is a valid file.");
-  }
-  std::string data{std::istreambuf_iterator<char>{model_stream},
-                   std::istreambuf_iterator<char>{}};
-  if (!ParseProtoFromBytes(&model, data.c_str(), data.size())) {
-    fail_check(
-        "Unable to parse model from file:",
-        model_path,
-        ". Please check if it is a valid protobuf file of model.");
+  {
+    // Unmapped as soon as parsing is done, so the file pages are not kept
+    // alive alongside the parsed model during checking.
+    MappedFile model_file(model_path);
+    if (!model_file.is_open()) {
+      fail_check(
+          "Unable to open model file:",
+          model_path,
+          ". Please check if it is a valid file.");
+    }
+    if (!ParseProtoFromBytes(&model, model_file.data(), model_file.size())) {
+      fail_check(
+          "Unable to parse model from file:",
+          model_path,
+          ". Please check if it is a valid protobuf file of model.");
+    }
   }
 
   CheckerContext ctx;
-  std::string model_dir;
-  size_t pos = model_path.find_last_of("\\/");
-  if (pos != std::string::npos) {
-    model_dir = model_path.substr(0, pos + 1);
-  }
-  ctx.set_model_dir(model_dir);
+  ctx.set_model_dir(GetDirectoryOfPath(model_path));
   check_model(model, ctx);
 }
 
@@ -814,6 +1511,276 @@ void check_model(const ModelProto& model) {
   check_model(model, ctx);
 }
 
+std::vector<Diagnostic> collect_model_diagnostics(const ModelProto& model) {
+  std::vector<Diagnostic> diagnostics;
+  CheckerContext ctx;
+  ctx.set_diagnostics(&diagnostics);
+  check_model(model, ctx);
+  return diagnostics;
+}
+
+namespace {
+
+// Minimal cursor over the protobuf wire format of a serialized message.
+// Unlike CodedInputStream it works with 64-bit offsets, so it can walk
+// messages beyond protobuf's 2GB limit and skip over payloads without
+// reading them.
+class WireFormatReader final {
+ public:
+  struct Field {
+    uint32_t number;
+    int wire_type;
+    // Raw bytes of the whole field, tag included.
+    const char* begin;
+    uint64_t size;
+    // Payload of a length-delimited field.
+    const char* payload;
+    uint64_t payload_size;
+  };
+
+  WireFormatReader(const char* data, uint64_t size)
+      : data_(data), size_(size) {}
+
+  bool done() const {
+    return pos_ >= size_;
+  }
+
+  // Read the next field. Returns false if the input is malformed.
+  bool next(Field* field) {
+    const uint64_t begin = pos_;
+    uint64_t tag = 0;
+    if (!read_varint(&tag) || (tag >> 3) == 0 || (tag >> 3) > 0x1FFFFFFF) {
+      return false;
+    }
+    field->number = static_cast<uint32_t>(tag >> 3);
+    field->wire_type = static_cast<int>(tag & 7);
+    field->payload = nullptr;
+    field->payload_size = 0;
+    switch (field->wire_type) {
+      case 0: { // varint
+        uint64_t value = 0;
+        if (!read_varint(&value)) {
+          return false;
+        }
+        break;
+      }
+      case 1: // fixed64
+        if (!skip(8)) {
+          return false;
+        }
+        break;
+      case 2: { // length-delimited
+        uint64_t length = 0;
+        if (!read_varint(&length)) {
+          return false;
+        }
+        field->payload = data_ + pos_;
+        field->payload_size = length;
+        if (!skip(length)) {
+          return false;
+        }
+        break;
+      }
+      case 5: // fixed32
+        if (!skip(4)) {
+          return false;
+        }
+        break;
+      default: // groups are not used by ONNX
+        return false;
+    }
+    field->begin = data_ + begin;
+    field->size = pos_ - begin;
+    return true;
+  }
+
+ private:
+  bool read_varint(uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64 && pos_ < size_; shift += 7) {
+      const uint8_t byte = static_cast<uint8_t>(data_[pos_++]);
+      *value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool skip(uint64_t count) {
+    if (count > size_ - pos_) {
+      return false;
+    }
+    pos_ += count;
+    return true;
+  }
+
+  const char* data_;
+  uint64_t size_;
+  uint64_t pos_ = 0;
+};
+
+// Build a copy of a serialized TensorProto that keeps every header field
+// (name, dims, data_type, data_location, external_data, ...) but none of its
+// data. check_tensor only looks at which value fields are set, so each value
+// field present in the input is represented by a single placeholder element.
+bool build_tensor_header(
+    const char* data,
+    uint64_t size,
+    TensorProto* tensor) {
+  std::string header;
+  bool has_float_data = false;
+  bool has_int32_data = false;
+  bool has_string_data = false;
+  bool has_int64_data = false;
+  bool has_raw_data = false;
+  bool has_double_data = false;
+  bool has_uint64_data = false;
+
+  WireFormatReader reader(data, size);
+  WireFormatReader::Field field;
+  while (!reader.done()) {
+    if (!reader.next(&field)) {
+      return false;
+    }
+    // Length-delimited value fields are packed arrays or raw bytes, which are
+    // only present when non-empty. Anything else is an unpacked element.
+    // string_data elements are always present, even when empty.
+    const bool non_empty = field.wire_type != 2 || field.payload_size > 0;
+    switch (field.number) {
+      case TensorProto::kFloatDataFieldNumber:
+        has_float_data |= non_empty;
+        break;
+      case TensorProto::kInt32DataFieldNumber:
+        has_int32_data |= non_empty;
+        break;
+      case TensorProto::kStringDataFieldNumber:
+        has_string_data = true;
+        break;
+      case TensorProto::kInt64DataFieldNumber:
+        has_int64_data |= non_empty;
+        break;
+      case TensorProto::kRawDataFieldNumber:
+        has_raw_data = non_empty;
+        break;
+      case TensorProto::kDoubleDataFieldNumber:
+        has_double_data |= non_empty;
+        break;
+      case TensorProto::kUint64DataFieldNumber:
+        has_uint64_data |= non_empty;
+        break;
+      default:
+        header.append(field.begin, field.size);
+    }
+  }
+
+  if (!ParseProtoFromBytes(tensor, header.data(), header.size())) {
+    return false;
+  }
+  if (has_float_data)
+    tensor->add_float_data(0);
+  if (has_int32_data)
+    tensor->add_int32_data(0);
+  if (has_string_data)
+    tensor->add_string_data("");
+  if (has_int64_data)
+    tensor->add_int64_data(0);
+  if (has_raw_data)
+    tensor->set_raw_data(std::string(1, '\0'));
+  if (has_double_data)
+    tensor->add_double_data(0);
+  if (has_uint64_data)
+    tensor->add_uint64_data(0);
+  return true;
+}
+
+// Build a skeleton of the serialized ModelProto in which the initializers of
+// the main graph are replaced by their headers. Only the graph structure is
+// materialized, so the memory used is independent of the size of the
+// weights. Concatenating the wire format of repeated occurrences of the graph
+// field is equivalent to merging them, as the protobuf parser would.
+bool build_model_skeleton(const char* data, uint64_t size, ModelProto* model) {
+  std::string model_header;
+  std::string graph_header;
+  bool has_graph = false;
+  std::vector<TensorProto> initializers;
+
+  WireFormatReader model_reader(data, size);
+  WireFormatReader::Field model_field;
+  while (!model_reader.done()) {
+    if (!model_reader.next(&model_field)) {
+      return false;
+    }
+    if (model_field.number != ModelProto::kGraphFieldNumber ||
+        model_field.wire_type != 2) {
+      model_header.append(model_field.begin, model_field.size);
+      continue;
+    }
+
+    has_graph = true;
+    WireFormatReader graph_reader(
+        model_field.payload, model_field.payload_size);
+    WireFormatReader::Field graph_field;
+    while (!graph_reader.done()) {
+      if (!graph_reader.next(&graph_field)) {
+        return false;
+      }
+      if (graph_field.number != GraphProto::kInitializerFieldNumber ||
+          graph_field.wire_type != 2) {
+        graph_header.append(graph_field.begin, graph_field.size);
+        continue;
+      }
+      initializers.emplace_back();
+      if (!build_tensor_header(
+              graph_field.payload,
+              graph_field.payload_size,
+              &initializers.back())) {
+        return false;
+      }
+    }
+  }
+
+  if (!ParseProtoFromBytes(model, model_header.data(), model_header.size())) {
+    return false;
+  }
+  if (has_graph) {
+    GraphProto* graph = model->mutable_graph();
+    if (!ParseProtoFromBytes(graph, graph_header.data(), graph_header.size())) {
+      return false;
+    }
+    for (auto& initializer : initializers) {
+      graph->add_initializer()->Swap(&initializer);
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+void check_model_streaming(const std::string& model_path) {
+  ModelProto skeleton;
+  {
+    MappedFile model_file(model_path);
+    if (!model_file.is_open()) {
+      fail_check(
+          "Unable to open model file:",
+          model_path,
+          ". Please check if it is a valid file.");
+    }
+    if (!build_model_skeleton(
+            model_file.data(), model_file.size(), &skeleton)) {
+      fail_check(
+          "Unable to parse model from file:",
+          model_path,
+          ". Please check if it is a valid protobuf file of model.");
+    }
+  }
+
+  CheckerContext ctx;
+  ctx.set_model_dir(GetDirectoryOfPath(model_path));
+  check_model(skeleton, ctx);
+}
+
 #undef fail_check
 #undef enforce_has_field
 #undef enforce_has_repeated_field
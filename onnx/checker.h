@@ -1,8 +1,11 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include "onnx/defs/function.h"
 #include "onnx/defs/schema.h"
 #include "onnx/onnx-operators_pb.h"
@@ -33,6 +36,87 @@ class ValidationError final : public std::runtime_error {
   throw ONNX_NAMESPACE::checker::ValidationError( \
       ONNX_NAMESPACE::MakeString(__VA_ARGS__));
 
+// Per-check cache of the external data files referenced by tensors. Each
+// file is opened once to record its size, so models whose tensors share a
+// weights file check in one filesystem lookup per file instead of per tensor.
+// Safe to use from the parallel initializer checks.
+class ExternalDataFileCache final {
+ public:
+  // Returns the size in bytes of the file at path, or -1 if it doesn't exist
+  // or is not accessible.
+  int64_t get_file_size(const std::string& path);
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, int64_t> file_sizes_;
+};
+
+// Kind of check that failed, for validation errors recorded as diagnostics.
+enum class DiagnosticCode : uint8_t {
+  InvalidModel = 0,
+  InvalidGraph = 1,
+  InvalidValueInfo = 2,
+  InvalidInitializer = 3,
+  UnsortedNode = 4,
+  NotSSA = 5,
+  InvalidNode = 6,
+};
+
+// A validation error recorded instead of thrown, when the CheckerContext
+// collects diagnostics. Its text context is only rendered by to_string().
+struct Diagnostic {
+  DiagnosticCode code;
+  // Name of the (sub)graph the error was found in. Empty for model errors.
+  std::string graph_name;
+  // Index of the node within that graph, or -1 if not caused by a node.
+  int node_index = -1;
+  std::string op_type;
+  std::string message;
+  // The offending node. Only valid while the checked model is alive.
+  const NodeProto* node = nullptr;
+
+  // Full error text, as it would have been thrown by the checker.
+  std::string to_string() const;
+};
+
+// Record of the subgraphs and sparse tensors that passed validation, for
+// callers that re-check a model after small edits. Attach one cache to the
+// CheckerContext of every check: nodes with subgraphs and sparse initializers
+// whose serialized bytes and checker settings are unchanged since a previous
+// successful check skip re-validation. For a node, only the names its
+// subgraphs share with the enclosing scopes are looked up again. Other nodes
+// and dense initializers cost less to check than to serialize, so they are
+// always checked. Entries are keyed by the full serialized bytes, so the
+// cache holds about as many bytes as the protos it records.
+// Registering or deregistering schemas in OpSchemaRegistry invalidates the
+// entries; other schema registries are assumed not to change between checks.
+// Nodes reading tensors from external files are never cached, since the
+// files may change. Safe to use from the parallel checks.
+class ValidationCache final {
+ public:
+  // The names the subgraphs of a node read from the enclosing scopes, and
+  // those they define, which must not be visible there. The node is only
+  // valid again where all of read and none of defined are visible.
+  struct ScopeNames {
+    std::vector<std::string> read;
+    std::vector<std::string> defined;
+  };
+
+  bool contains(const std::string& key) const;
+  // The scope names recorded for key, or nullptr if key is not cached.
+  std::shared_ptr<const ScopeNames> find(const std::string& key) const;
+  void insert(
+      const std::string& key,
+      std::shared_ptr<const ScopeNames> names = nullptr);
+  void clear();
+  size_t size() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<const ScopeNames>>
+      validated_;
+};
+
 class CheckerContext final {
  public:
   int get_ir_version() const {
@@ -46,6 +130,7 @@ class CheckerContext final {
   }
   void set_opset_imports(std::unordered_map<std::string, int> imps) {
     opset_imports_ = std::move(imps);
+    schema_cache_.reset();
   }
   bool is_main_graph() const {
     return is_main_graph_;
@@ -56,6 +141,7 @@ class CheckerContext final {
 
   void set_schema_registry(const ISchemaRegistry* schema_registry) {
     schema_registry_ = schema_registry;
+    schema_cache_.reset();
   }
 
   const ISchemaRegistry* get_schema_registry() const {
@@ -70,6 +156,61 @@ class CheckerContext final {
     return model_dir_;
   }
 
+  // Number of threads check_graph may use to validate initializers and
+  // sparse initializers. Values <= 1 keep all checks on the calling thread.
+  // Node-order and SSA checks always run sequentially.
+  void set_num_threads(int num_threads) {
+    num_threads_ = num_threads;
+  }
+
+  int get_num_threads() const {
+    return num_threads_;
+  }
+
+  // Copies of a context share its cache, so nested graphs reuse the lookups
+  // made for the main graph. check_model starts every check with a new one.
+  void set_external_data_cache(std::shared_ptr<ExternalDataFileCache> cache) {
+    external_data_cache_ = std::move(cache);
+  }
+
+  ExternalDataFileCache& get_external_data_cache() const {
+    return *external_data_cache_;
+  }
+
+  // Resolves node schemas for the current opset imports and schema registry.
+  // check_model and check_function start every check with a new one, which
+  // copies of the context share; setting the opset imports or the registry
+  // drops it. Null (the default) looks up every node in the registry, so
+  // contexts shared between threads stay safe to use.
+  void set_schema_cache(std::shared_ptr<SchemaResolutionCache> cache) {
+    schema_cache_ = std::move(cache);
+  }
+
+  SchemaResolutionCache* get_schema_cache() const {
+    return schema_cache_.get();
+  }
+
+  // Cache of previously validated protos, shared by all checks given the
+  // same cache. Null (the default) disables caching.
+  void set_validation_cache(std::shared_ptr<ValidationCache> cache) {
+    validation_cache_ = std::move(cache);
+  }
+
+  ValidationCache* get_validation_cache() const {
+    return validation_cache_.get();
+  }
+
+  // When set, check_model and check_graph record recoverable errors here and
+  // keep checking, instead of throwing on the first one. Null (the default)
+  // keeps the throwing behavior.
+  void set_diagnostics(std::vector<Diagnostic>* diagnostics) {
+    diagnostics_ = diagnostics;
+  }
+
+  std::vector<Diagnostic>* get_diagnostics() const {
+    return diagnostics_;
+  }
+
   explicit CheckerContext() : ir_version_(-1) {}
 
  private:
@@ -78,6 +219,12 @@ class CheckerContext final {
   bool is_main_graph_ = true;
   const ISchemaRegistry* schema_registry_ = OpSchemaRegistry::Instance();
   std::string model_dir_;
+  int num_threads_ = 1;
+  std::shared_ptr<ExternalDataFileCache> external_data_cache_ =
+      std::make_shared<ExternalDataFileCache>();
+  std::shared_ptr<ValidationCache> validation_cache_;
+  std::shared_ptr<SchemaResolutionCache> schema_cache_;
+  std::vector<Diagnostic>* diagnostics_ = nullptr;
 };
 
 class LexicalScopeContext final {
@@ -93,25 +240,30 @@ class LexicalScopeContext final {
   LexicalScopeContext(const LexicalScopeContext& parent_context)
       : parent_context_{&parent_context} {}
 
-  void add(const std::string& name) {
-    output_names.insert(name);
-  }
+  LexicalScopeContext& operator=(const LexicalScopeContext&) = default;
 
-  bool this_graph_has(const std::string& name) const {
-    return output_names.find(name) != output_names.cend();
-  }
+  void add(const std::string& name);
 
-  bool this_or_ancestor_graph_has(const std::string& name) const {
-    return this_graph_has(name) ||
-        (parent_context_ && parent_context_->this_or_ancestor_graph_has(name));
-  }
+  bool this_graph_has(const std::string& name) const;
+
+  bool this_or_ancestor_graph_has(const std::string& name) const;
 
   // public for backwards compatibility. please prefer the public interface of
   // this class over directly changing output_names
   std::unordered_set<std::string> output_names;
 
  private:
+  bool has(const std::string& name, size_t hash) const;
+  void refresh_index();
+  void index(size_t hash);
+
   const LexicalScopeContext* parent_context_{nullptr};
+  // Hashes of output_names in an open-addressing table, so a lookup through
+  // nested scopes hashes the name once and probes one flat table per scope.
+  // Only add() refreshes it; lookups use output_names directly while its size
+  // differs from indexed_size_ because it was changed directly.
+  std::vector<size_t> hash_slots_;
+  size_t indexed_size_{0};
 };
 
 using IR_VERSION_TYPE = decltype(Version::IR_VERSION);
@@ -138,7 +290,22 @@ void check_function(
     const LexicalScopeContext&);
 
 void check_model(const ModelProto& model);
+void check_model(const ModelProto& model, CheckerContext& ctx);
 void check_model(const std::string& model_path);
 
+// Check model in a single pass, returning every recoverable validation error
+// instead of throwing the first one. The node pointers of the diagnostics
+// refer into model.
+std::vector<Diagnostic> collect_model_diagnostics(const ModelProto& model);
+
+// Check the model at model_path without materializing its weights. The file
+// is walked in its serialized form: initializers of the main graph are
+// reduced to their headers (name, dims, data_type and which data fields are
+// set) and their payloads are skipped, so memory use does not grow with the
+// size of the weights and models beyond protobuf's 2GB limit can be checked.
+// The graph structure, including nodes, sparse initializers and subgraphs,
+// is still parsed and must itself fit within that limit.
+void check_model_streaming(const std::string& model_path);
+
 } // namespace checker
 } // namespace ONNX_NAMESPACE
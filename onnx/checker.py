@@ -21,7 +21,7 @@ from onnx import (ValueInfoProto,
 import onnx.onnx_cpp2py_export.checker as C
 import onnx.defs
 from google.protobuf.message import Message
-from typing import TypeVar, Callable, Any, Type, cast, Union, Text
+from typing import TypeVar, Callable, Any, Type, cast, Union, Text, List
 from six import string_types
 import onnx.shape_inference
 import sys
@@ -105,4 +105,28 @@ def check_model(model, full_check=False):  # type: (Union[ModelProto, Text], boo
         onnx.shape_inference.infer_shapes(m, True)
 
 
+def check_model_streaming(model_path):  # type: (Text) -> None
+    """Check the model at model_path without loading its weights into memory.
+
+    Initializers of the main graph are validated from their headers only,
+    so models larger than the 2GB protobuf limit can be checked.
+    """
+    if not isinstance(model_path, string_types):
+        raise TypeError('check_model_streaming only accepts model path (String), '
+                        'incorrect type: {}'.format(type(model_path)))
+    C.check_model_path_streaming(model_path)
+
+
+def collect_model_diagnostics(model):  # type: (ModelProto) -> List[C.Diagnostic]
+    """Check model in a single pass and return all validation errors found.
+
+    Unlike check_model, checking continues after an invalid node, initializer
+    or value info. Each diagnostic has a code, the name of the graph it was
+    found in and the index and op_type of the offending node (-1 and '' if
+    not caused by a node). An empty list means the model is valid.
+    """
+    return C.collect_model_diagnostics(model.SerializeToString())
+
+
 ValidationError = C.ValidationError
+DiagnosticCode = C.DiagnosticCode
@@ -0,0 +1,68 @@
+// Copyright (c) ONNX Project Contributors.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "onnx/proto_utils.h"
+
+namespace ONNX_NAMESPACE {
+
+// Read-only memory mapping of a whole file. Serialized protos can be parsed
+// straight out of the mapping through a zero-copy input stream, so loading a
+// model neither buffers the file in a std::string nor copies it byte by byte.
+class MappedFile final {
+ public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // False if the file could not be opened or mapped.
+  bool is_open() const {
+    return is_open_;
+  }
+
+  const char* data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  bool is_open_ = false;
+#ifdef _WIN32
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+#endif
+};
+
+// Parse proto from the file at proto_path without an intermediate copy of its
+// bytes. Returns false if the file cannot be mapped or fails to parse.
+template <typename Proto>
+bool ParseProtoFromPath(Proto* proto, const std::string& proto_path) {
+  MappedFile file(proto_path);
+  if (!file.is_open()) {
+    return false;
+  }
+  return ParseProtoFromBytes(proto, file.data(), file.size());
+}
+
+// Return the directory part of path, including the trailing separator, or an
+// empty string if path has no directory component.
+inline std::string GetDirectoryOfPath(const std::string& path) {
+  size_t pos = path.find_last_of("\\/");
+  if (pos == std::string::npos) {
+    return std::string();
+  }
+  return path.substr(0, pos + 1);
+}
+
+} // namespace ONNX_NAMESPACE
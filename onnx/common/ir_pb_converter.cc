@@ -420,8 +420,10 @@ void encodeTensor(ONNX_NAMESPACE::TensorProto* p, const Tensor& tensor) {
   }
 }
 
-void addAttribute(ONNX_NAMESPACE::NodeProto* n_p, Node* n, Symbol name) {
-  auto attr = n_p->add_attribute();
+void encodeAttribute(
+    ONNX_NAMESPACE::AttributeProto* attr,
+    const Node* n,
+    Symbol name) {
   attr->set_name(name.toString());
   switch (n->kindOf(name)) {
     case AttributeKind::f:
@@ -478,6 +480,10 @@ void addAttribute(ONNX_NAMESPACE::NodeProto* n_p, Node* n, Symbol name) {
   }
 }
 
+void addAttribute(ONNX_NAMESPACE::NodeProto* n_p, Node* n, Symbol name) {
+  encodeAttribute(n_p->add_attribute(), n, name);
+}
+
 void encodeTypeProtoTensorType(
     ONNX_NAMESPACE::TypeProto_Tensor* tensor_type,
     Value* n) {
@@ -40,4 +40,9 @@ std::unique_ptr<Graph> ImportModelProto(const ModelProto& mp);
 ModelProto PrepareOutput(const ModelProto& mp_in);
 
 void assertNonNull(std::shared_ptr<Graph> g);
+
+// Conversions of single IR objects, for code that reads them as protos.
+void encodeTensor(TensorProto* p, const Tensor& tensor);
+
+void encodeAttribute(AttributeProto* attr, const Node* n, Symbol name);
 } // namespace ONNX_NAMESPACE
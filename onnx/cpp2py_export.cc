@@ -205,10 +205,31 @@ PYBIND11_MODULE(onnx_cpp2py_export, onnx_cpp2py_export) {
       .def_property(
           "opset_imports",
           &checker::CheckerContext::get_opset_imports,
-          &checker::CheckerContext::set_opset_imports);
+          &checker::CheckerContext::set_opset_imports)
+      .def_property(
+          "num_threads",
+          &checker::CheckerContext::get_num_threads,
+          &checker::CheckerContext::set_num_threads);
 
   py::register_exception<checker::ValidationError>(checker, "ValidationError");
 
+  py::enum_<checker::DiagnosticCode>(checker, "DiagnosticCode")
+      .value("InvalidModel", checker::DiagnosticCode::InvalidModel)
+      .value("InvalidGraph", checker::DiagnosticCode::InvalidGraph)
+      .value("InvalidValueInfo", checker::DiagnosticCode::InvalidValueInfo)
+      .value("InvalidInitializer", checker::DiagnosticCode::InvalidInitializer)
+      .value("UnsortedNode", checker::DiagnosticCode::UnsortedNode)
+      .value("NotSSA", checker::DiagnosticCode::NotSSA)
+      .value("InvalidNode", checker::DiagnosticCode::InvalidNode);
+
+  py::class_<checker::Diagnostic>(checker, "Diagnostic")
+      .def_readonly("code", &checker::Diagnostic::code)
+      .def_readonly("graph_name", &checker::Diagnostic::graph_name)
+      .def_readonly("node_index", &checker::Diagnostic::node_index)
+      .def_readonly("op_type", &checker::Diagnostic::op_type)
+      .def_readonly("message", &checker::Diagnostic::message)
+      .def("__str__", &checker::Diagnostic::to_string);
+
   checker.def(
       "check_value_info",
       [](const py::bytes& bytes, const checker::CheckerContext& ctx) -> void {
@@ -265,10 +286,26 @@ PYBIND11_MODULE(onnx_cpp2py_export, onnx_cpp2py_export) {
     checker::check_model(proto);
   });
 
+  checker.def(
+      "collect_model_diagnostics",
+      [](const py::bytes& bytes) -> std::vector<checker::Diagnostic> {
+        ModelProto proto{};
+        ParseProtoFromPyBytes(&proto, bytes);
+        auto diagnostics = checker::collect_model_diagnostics(proto);
+        // The nodes are freed with proto; Python callers index into their
+        // own copy of the model instead.
+        for (auto& diagnostic : diagnostics) {
+          diagnostic.node = nullptr;
+        }
+        return diagnostics;
+      });
+
   checker.def(
       "check_model_path",
       (void (*)(const std::string&)) & checker::check_model);
 
+  checker.def("check_model_path_streaming", &checker::check_model_streaming);
+
   // Submodule `optimizer`
   auto optimizer = onnx_cpp2py_export.def_submodule("optimizer");
   optimizer.doc() = "Optimizer submodule";
@@ -317,14 +354,107 @@ PYBIND11_MODULE(onnx_cpp2py_export, onnx_cpp2py_export) {
   auto shape_inference = onnx_cpp2py_export.def_submodule("shape_inference");
   shape_inference.doc() = "Shape Inference submodule";
 
-  shape_inference.def("infer_shapes", [](const py::bytes& bytes, bool check_type) {
+  shape_inference.def("infer_shapes", [](const py::bytes& bytes, bool check_type, int num_threads, bool data_prop) {
     ModelProto proto{};
     ParseProtoFromPyBytes(&proto, bytes);
-    shape_inference::InferShapes(proto, check_type);
+    shape_inference::ShapeInferenceOptions options;
+    options.check_type = check_type;
+    options.num_threads = num_threads;
+    options.enable_data_propagation = data_prop;
+    shape_inference::InferShapes(proto, options);
     std::string out;
     proto.SerializeToString(&out);
     return py::bytes(out);
-  }, "bytes"_a, "check_type"_a = false);
+  }, "bytes"_a, "check_type"_a = false, "num_threads"_a = 1, "data_prop"_a = false);
+
+  shape_inference.def(
+      "infer_shapes_for_bindings",
+      [](const py::bytes& bytes,
+         const std::vector<std::unordered_map<std::string, std::vector<int64_t>>>&
+             input_shapes,
+         bool check_type,
+         bool data_prop) {
+        ModelProto proto{};
+        ParseProtoFromPyBytes(&proto, bytes);
+        std::vector<shape_inference::InputShapeBinding> bindings(
+            input_shapes.size());
+        for (size_t b = 0; b < input_shapes.size(); ++b) {
+          for (const auto& input : input_shapes[b]) {
+            auto& shape = bindings[b][input.first];
+            for (int64_t dim : input.second) {
+              shape.add_dim()->set_dim_value(dim);
+            }
+          }
+        }
+        shape_inference::ShapeInferenceOptions options;
+        options.check_type = check_type;
+        options.enable_data_propagation = data_prop;
+        auto results =
+            shape_inference::InferShapesForBindings(proto, bindings, options);
+        std::vector<std::vector<py::bytes>> out(results.size());
+        for (size_t b = 0; b < results.size(); ++b) {
+          for (const auto& value_info : results[b]) {
+            std::string serialized;
+            value_info.SerializeToString(&serialized);
+            out[b].push_back(py::bytes(serialized));
+          }
+        }
+        return out;
+      },
+      "bytes"_a,
+      "input_shapes"_a,
+      "check_type"_a = false,
+      "data_prop"_a = false);
+
+  shape_inference.def("estimate_cost", [](const py::bytes& bytes) {
+    ModelProto proto{};
+    ParseProtoFromPyBytes(&proto, bytes);
+    shape_inference::InferShapes(proto);
+    auto cost = shape_inference::EstimateCost(proto);
+    py::dict result;
+    result["flops"] = cost.total.flops;
+    result["param_bytes"] = cost.total.param_bytes;
+    result["activation_bytes_read"] = cost.total.activation_bytes_read;
+    result["activation_bytes_written"] = cost.total.activation_bytes_written;
+    result["complete"] = cost.total.complete;
+    result["num_unestimated_nodes"] = cost.num_unestimated_nodes;
+    return result;
+  });
+
+  shape_inference.def("plan_memory", [](const py::bytes& bytes, int64_t alignment) {
+    ModelProto proto{};
+    ParseProtoFromPyBytes(&proto, bytes);
+    shape_inference::InferShapes(proto);
+    auto plan = shape_inference::PlanMemory(proto, alignment);
+    py::list tensors;
+    for (const auto& tensor : plan.tensors) {
+      py::dict lifetime;
+      lifetime["name"] = tensor.name;
+      lifetime["bytes"] = tensor.bytes;
+      lifetime["first_use"] = tensor.first_use;
+      lifetime["last_use"] = tensor.last_use;
+      lifetime["offset"] = tensor.offset;
+      tensors.append(lifetime);
+    }
+    py::dict result;
+    result["tensors"] = tensors;
+    result["peak_bytes"] = plan.peak_bytes;
+    result["peak_node"] = plan.peak_node;
+    result["arena_bytes"] = plan.arena_bytes;
+    result["complete"] = plan.complete;
+    return result;
+  }, "bytes"_a, "alignment"_a = 64);
+
+  shape_inference.def(
+      "infer_shapes_path",
+      [](const std::string& model_path,
+         const std::string& output_path,
+         bool check_type) -> void {
+        shape_inference::InferShapes(model_path, output_path, check_type);
+      },
+      "model_path"_a,
+      "output_path"_a = "",
+      "check_type"_a = false);
 }
 
 } // namespace ONNX_NAMESPACE
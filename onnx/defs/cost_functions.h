@@ -0,0 +1,268 @@
+// Copyright (c) ONNX Project Contributors.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <string>
+
+#include "onnx/defs/shape_inference.h"
+
+namespace ONNX_NAMESPACE {
+
+// Cost functions shared by the versions of the math, nn and rnn ops. FLOPs
+// count one per arithmetic operation, comparison or elementary function
+// (exp, tanh, ...), and a multiply-accumulate as two.
+
+// Size of an element of elem_type in bytes, or 0 if not fixed (strings).
+inline int64_t elemTypeSize(int32_t elem_type) {
+  switch (elem_type) {
+    case TensorProto::BOOL:
+    case TensorProto::INT8:
+    case TensorProto::UINT8:
+      return 1;
+    case TensorProto::INT16:
+    case TensorProto::UINT16:
+    case TensorProto::FLOAT16:
+    case TensorProto::BFLOAT16:
+      return 2;
+    case TensorProto::INT32:
+    case TensorProto::UINT32:
+    case TensorProto::FLOAT:
+      return 4;
+    case TensorProto::INT64:
+    case TensorProto::UINT64:
+    case TensorProto::DOUBLE:
+    case TensorProto::COMPLEX64:
+      return 8;
+    case TensorProto::COMPLEX128:
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+// Number of elements of a tensor type, or -1 if its shape is not known.
+inline int64_t tensorElementCount(const TypeProto* type) {
+  if (type == nullptr || !type->has_tensor_type() ||
+      !type->tensor_type().has_shape()) {
+    return -1;
+  }
+  int64_t count = 1;
+  for (const auto& dim : type->tensor_type().shape().dim()) {
+    if (!dim.has_dim_value()) {
+      return -1;
+    }
+    count *= dim.dim_value();
+  }
+  return count;
+}
+
+// Size of a tensor type in bytes, or -1 if unknown.
+inline int64_t tensorBytes(const TypeProto* type) {
+  int64_t count = tensorElementCount(type);
+  int64_t size =
+      count < 0 ? 0 : elemTypeSize(type->tensor_type().elem_type());
+  return size == 0 ? -1 : count * size;
+}
+
+// Dimension index of a tensor type, or -1 if unknown.
+inline int64_t tensorDim(const TypeProto* type, int index) {
+  if (type == nullptr || !type->has_tensor_type() ||
+      !type->tensor_type().has_shape()) {
+    return -1;
+  }
+  const auto& shape = type->tensor_type().shape();
+  if (index < 0) {
+    index += shape.dim_size();
+  }
+  if (index < 0 || index >= shape.dim_size() ||
+      !shape.dim(index).has_dim_value()) {
+    return -1;
+  }
+  return shape.dim(index).dim_value();
+}
+
+// Adds count * flops_per_count to cost, or marks it incomplete if the count
+// is unknown.
+inline void addFlops(OpCost& cost, int64_t count, int64_t flops_per_count) {
+  if (count < 0 || flops_per_count < 0) {
+    cost.complete = false;
+  } else {
+    cost.flops += count * flops_per_count;
+  }
+}
+
+// The bytes of each input read once and of each output written once.
+// Missing optional inputs and outputs are left out.
+inline OpCost dataMovementCost(InferenceContext& ctx) {
+  OpCost cost;
+  for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+    const TypeProto* type = ctx.getInputType(i);
+    if (type == nullptr || type->value_case() == TypeProto::VALUE_NOT_SET) {
+      continue;
+    }
+    int64_t bytes = tensorBytes(type);
+    if (bytes < 0) {
+      cost.complete = false;
+    } else if (ctx.getInputData(i) != nullptr) {
+      cost.param_bytes += bytes;
+    } else {
+      cost.activation_bytes_read += bytes;
+    }
+  }
+  for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+    const TypeProto* type = ctx.getOutputType(i);
+    if (type->value_case() == TypeProto::VALUE_NOT_SET) {
+      continue;
+    }
+    int64_t bytes = tensorBytes(type);
+    if (bytes < 0) {
+      cost.complete = false;
+    } else {
+      cost.activation_bytes_written += bytes;
+    }
+  }
+  return cost;
+}
+
+// An op computing each element of its first output with flops_per_element
+// operations.
+inline CostFunction elementwiseCost(int64_t flops_per_element) {
+  return [flops_per_element](InferenceContext& ctx) {
+    OpCost cost = dataMovementCost(ctx);
+    addFlops(
+        cost, tensorElementCount(ctx.getOutputType(0)), flops_per_element);
+    return cost;
+  };
+}
+
+// An op combining its inputs elementwise (Sum, Max, ...), one operation per
+// input after the first, plus extra_flops_per_element.
+inline CostFunction variadicElementwiseCost(int64_t extra_flops_per_element) {
+  return [extra_flops_per_element](InferenceContext& ctx) {
+    OpCost cost = dataMovementCost(ctx);
+    int64_t inputs = static_cast<int64_t>(ctx.getNumInputs());
+    addFlops(
+        cost,
+        tensorElementCount(ctx.getOutputType(0)),
+        inputs - 1 + extra_flops_per_element);
+    return cost;
+  };
+}
+
+// MatMul and MatMulInteger: a multiply-accumulate per output element and
+// element of the reduced dimension, the last one of A.
+inline OpCost matMulCost(InferenceContext& ctx) {
+  OpCost cost = dataMovementCost(ctx);
+  int64_t k = tensorDim(ctx.getInputType(0), -1);
+  addFlops(cost, tensorElementCount(ctx.getOutputType(0)), k < 0 ? k : 2 * k);
+  return cost;
+}
+
+// Gemm: the product of A and B, then the addition of C if present.
+inline OpCost gemmCost(InferenceContext& ctx) {
+  OpCost cost = dataMovementCost(ctx);
+  bool transA = getAttribute(ctx, "transA", 0) != 0;
+  int64_t k = tensorDim(ctx.getInputType(0), transA ? 0 : 1);
+  int64_t outputs = tensorElementCount(ctx.getOutputType(0));
+  addFlops(cost, outputs, k < 0 ? k : 2 * k);
+  if (ctx.getNumInputs() > 2 && ctx.getInputType(2) != nullptr) {
+    addFlops(cost, outputs, 1);
+  }
+  return cost;
+}
+
+// Product of the kernel dimensions of a weight of shape
+// (M, C / group, k1, ..., kn), or -1 if unknown.
+inline int64_t kernelSize(const TypeProto* weight) {
+  int64_t count = tensorElementCount(weight);
+  int64_t m = tensorDim(weight, 0);
+  int64_t c = tensorDim(weight, 1);
+  return count < 0 || m <= 0 || c <= 0 ? -1 : count / (m * c);
+}
+
+// Conv: a multiply-accumulate per output element and weight element of its
+// group, then the bias.
+inline OpCost convCost(InferenceContext& ctx) {
+  OpCost cost = dataMovementCost(ctx);
+  const TypeProto* weight = ctx.getInputType(1);
+  int64_t kernel = kernelSize(weight);
+  int64_t channels = tensorDim(weight, 1);
+  int64_t outputs = tensorElementCount(ctx.getOutputType(0));
+  addFlops(cost, outputs, kernel < 0 ? -1 : 2 * kernel * channels);
+  if (ctx.getNumInputs() > 2 && ctx.getInputType(2) != nullptr) {
+    addFlops(cost, outputs, 1);
+  }
+  return cost;
+}
+
+// ConvTranspose: a multiply-accumulate per input element and weight element
+// of its group, with weights of shape (C, M / group, k1, ..., kn), then the
+// bias.
+inline OpCost convTransposeCost(InferenceContext& ctx) {
+  OpCost cost = dataMovementCost(ctx);
+  const TypeProto* weight = ctx.getInputType(1);
+  int64_t kernel = kernelSize(weight);
+  int64_t channels = tensorDim(weight, 1);
+  addFlops(
+      cost,
+      tensorElementCount(ctx.getInputType(0)),
+      kernel < 0 ? -1 : 2 * kernel * channels);
+  if (ctx.getNumInputs() > 2 && ctx.getInputType(2) != nullptr) {
+    addFlops(cost, tensorElementCount(ctx.getOutputType(0)), 1);
+  }
+  return cost;
+}
+
+// AveragePool, MaxPool and LpPool: an operation per output element and
+// element of the window.
+inline OpCost poolCost(InferenceContext& ctx) {
+  OpCost cost = dataMovementCost(ctx);
+  std::vector<int64_t> kernel_shape;
+  int64_t window = -1;
+  if (getRepeatedAttribute(ctx, "kernel_shape", kernel_shape)) {
+    window = 1;
+    for (int64_t k : kernel_shape) {
+      window *= k;
+    }
+  }
+  addFlops(cost, tensorElementCount(ctx.getOutputType(0)), window);
+  return cost;
+}
+
+// GlobalAveragePool, GlobalMaxPool and GlobalLpPool: an operation per input
+// element.
+inline OpCost globalPoolCost(InferenceContext& ctx) {
+  OpCost cost = dataMovementCost(ctx);
+  addFlops(cost, tensorElementCount(ctx.getInputType(0)), 1);
+  return cost;
+}
+
+// RNN, GRU and LSTM with the given number of gates: for each direction, time
+// step and batch entry, the products of the weights with the input and the
+// hidden state, then the bias, activation and state update of each gate.
+inline CostFunction recurrentCost(int64_t gates) {
+  return [gates](InferenceContext& ctx) {
+    OpCost cost = dataMovementCost(ctx);
+    const TypeProto* x = ctx.getInputType(0);
+    const TypeProto* w = ctx.getInputType(1);
+    const TypeProto* r = ctx.getInputType(2);
+    int64_t seq_length = tensorDim(x, 0);
+    int64_t batch_size = tensorDim(x, 1);
+    int64_t num_directions = tensorDim(w, 0);
+    int64_t input_size = tensorDim(w, 2);
+    int64_t hidden_size = tensorDim(r, 2);
+    if (seq_length < 0 || batch_size < 0 || num_directions < 0 ||
+        input_size < 0 || hidden_size < 0) {
+      cost.complete = false;
+      return cost;
+    }
+    addFlops(
+        cost,
+        num_directions * seq_length * batch_size,
+        gates * hidden_size * (2 * (input_size + hidden_size) + 3));
+    return cost;
+  };
+}
+
+} // namespace ONNX_NAMESPACE
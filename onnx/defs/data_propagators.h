@@ -0,0 +1,224 @@
+// Copyright (c) ONNX Project Contributors.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include "onnx/defs/shape_inference.h"
+
+namespace ONNX_NAMESPACE {
+
+// Data propagation functions shared by the versions of the ops that shapes
+// are computed with. Values are only propagated for 1-D and scalar integer
+// tensors.
+
+// Rank of a tensor type, or -1 if unknown.
+inline int tensorRank(const TypeProto* type) {
+  if (type == nullptr || !type->has_tensor_type() ||
+      !type->tensor_type().has_shape()) {
+    return -1;
+  }
+  return type->tensor_type().shape().dim_size();
+}
+
+inline bool isPropagatedValueType(const TypeProto* type) {
+  int rank = tensorRank(type);
+  if (rank < 0 || rank > 1) {
+    return false;
+  }
+  auto elem_type = type->tensor_type().elem_type();
+  return elem_type == TensorProto::INT64 || elem_type == TensorProto::INT32;
+}
+
+// Reads the known integer elements of value into elements. Returns false if
+// an element is not a known integer.
+inline bool getKnownValues(
+    const TensorShapeProto& value,
+    std::vector<int64_t>& elements) {
+  elements.clear();
+  for (const auto& dim : value.dim()) {
+    if (!dim.has_dim_value()) {
+      return false;
+    }
+    elements.push_back(dim.dim_value());
+  }
+  return true;
+}
+
+// Identity, Cast, and Squeeze/Unsqueeze between a scalar and a single-element
+// 1-D tensor keep the value of input 0.
+inline void propagateDataFromInputToOutput(DataPropagationContext& ctx) {
+  if (!isPropagatedValueType(ctx.getOutputType(0))) {
+    return;
+  }
+  const TensorShapeProto* input_data = ctx.getInputData(0);
+  if (input_data != nullptr) {
+    TensorShapeProto value(*input_data);
+    ctx.addOutputData(0, std::move(value));
+  }
+}
+
+inline void shapeDataPropagator(DataPropagationContext& ctx) {
+  const TypeProto* input_type = ctx.getInputType(0);
+  if (tensorRank(input_type) < 0) {
+    return;
+  }
+  TensorShapeProto value(input_type->tensor_type().shape());
+  for (auto& dim : *value.mutable_dim()) {
+    dim.clear_denotation();
+  }
+  ctx.addOutputData(0, std::move(value));
+}
+
+inline void gatherDataPropagator(DataPropagationContext& ctx) {
+  const AttributeProto* axis = ctx.getAttribute("axis");
+  if ((axis != nullptr && axis->i() != 0 && axis->i() != -1) ||
+      tensorRank(ctx.getInputType(0)) != 1 ||
+      !isPropagatedValueType(ctx.getOutputType(0))) {
+    return;
+  }
+  const TensorShapeProto* data = ctx.getInputData(0);
+  const TensorShapeProto* indices = ctx.getInputData(1);
+  std::vector<int64_t> positions;
+  if (data == nullptr || indices == nullptr ||
+      !getKnownValues(*indices, positions)) {
+    return;
+  }
+  TensorShapeProto value;
+  const int64_t size = data->dim_size();
+  for (int64_t position : positions) {
+    if (position < 0) {
+      position += size;
+    }
+    if (position < 0 || position >= size) {
+      return;
+    }
+    *value.add_dim() = data->dim(static_cast<int>(position));
+  }
+  ctx.addOutputData(0, std::move(value));
+}
+
+// Slice with starts, ends, axes and steps given as inputs (since version 10).
+inline void sliceDataPropagator(DataPropagationContext& ctx) {
+  if (tensorRank(ctx.getInputType(0)) != 1 ||
+      !isPropagatedValueType(ctx.getOutputType(0))) {
+    return;
+  }
+  const TensorShapeProto* data = ctx.getInputData(0);
+  const TensorShapeProto* starts_data = ctx.getInputData(1);
+  const TensorShapeProto* ends_data = ctx.getInputData(2);
+  std::vector<int64_t> starts, ends, axes, steps;
+  if (data == nullptr || starts_data == nullptr || ends_data == nullptr ||
+      !getKnownValues(*starts_data, starts) ||
+      !getKnownValues(*ends_data, ends) || starts.size() != 1 ||
+      ends.size() != 1) {
+    return;
+  }
+  for (size_t i = 3; i < ctx.getNumInputs() && i <= 4; ++i) {
+    const TensorShapeProto* input_data = ctx.getInputData(i);
+    if (input_data == nullptr && ctx.getInputType(i) == nullptr) {
+      continue; // Omitted optional input.
+    }
+    std::vector<int64_t>& values = i == 3 ? axes : steps;
+    if (input_data == nullptr || !getKnownValues(*input_data, values) ||
+        values.size() != 1) {
+      return;
+    }
+  }
+  if ((!axes.empty() && axes[0] != 0 && axes[0] != -1) ||
+      (!steps.empty() && steps[0] == 0)) {
+    return;
+  }
+
+  const int64_t size = data->dim_size();
+  // Any step longer than the data takes a single element.
+  const int64_t step = steps.empty()
+      ? 1
+      : std::max(std::min(steps[0], size + 1), -(size + 1));
+  int64_t start = starts[0] < 0 ? starts[0] + size : starts[0];
+  int64_t end = ends[0] < 0 ? ends[0] + size : ends[0];
+  if (step > 0) {
+    start = std::min(std::max<int64_t>(start, 0), size);
+    end = std::min(std::max<int64_t>(end, 0), size);
+  } else {
+    start = std::min(std::max<int64_t>(start, 0), size - 1);
+    end = std::min(std::max<int64_t>(end, -1), size - 1);
+  }
+  TensorShapeProto value;
+  for (int64_t i = start; step > 0 ? i < end : i > end; i += step) {
+    *value.add_dim() = data->dim(static_cast<int>(i));
+  }
+  ctx.addOutputData(0, std::move(value));
+}
+
+inline void concatDataPropagator(DataPropagationContext& ctx) {
+  const AttributeProto* axis = ctx.getAttribute("axis");
+  if ((axis != nullptr && axis->i() != 0 && axis->i() != -1) ||
+      !isPropagatedValueType(ctx.getOutputType(0))) {
+    return;
+  }
+  TensorShapeProto value;
+  for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+    const TensorShapeProto* input_data = ctx.getInputData(i);
+    if (input_data == nullptr) {
+      return;
+    }
+    for (const auto& dim : input_data->dim()) {
+      *value.add_dim() = dim;
+    }
+  }
+  ctx.addOutputData(0, std::move(value));
+}
+
+// Elementwise Add, Sub, Mul and Div of integer values; a single element
+// broadcasts. Symbolic quotients are floor divisions, which agree with the
+// truncating integer Div on the non-negative values of dimensions.
+inline void mathOpDataPropagator(
+    DataPropagationContext& ctx,
+    const std::string& op_type) {
+  if (!isPropagatedValueType(ctx.getOutputType(0))) {
+    return;
+  }
+  const TensorShapeProto* lhs = ctx.getInputData(0);
+  const TensorShapeProto* rhs = ctx.getInputData(1);
+  if (lhs == nullptr || rhs == nullptr) {
+    return;
+  }
+  const int lhs_size = lhs->dim_size();
+  const int rhs_size = rhs->dim_size();
+  if (lhs_size != rhs_size && lhs_size != 1 && rhs_size != 1) {
+    return;
+  }
+  const int size = lhs_size == 1 ? rhs_size : lhs_size;
+  TensorShapeProto value;
+  for (int i = 0; i < size; ++i) {
+    SymbolicDim a =
+        SymbolicDim::FromDimension(lhs->dim(lhs_size == 1 ? 0 : i));
+    SymbolicDim b =
+        SymbolicDim::FromDimension(rhs->dim(rhs_size == 1 ? 0 : i));
+    SymbolicDim result = SymbolicDim::Unknown();
+    if (op_type == "Add") {
+      result = a + b;
+    } else if (op_type == "Sub") {
+      result = a - b;
+    } else if (op_type == "Mul") {
+      result = a * b;
+    } else if (op_type == "Div") {
+      if (a.is_constant() && b.is_constant()) {
+        if (b.constant_value() != 0 &&
+            !(b.constant_value() == -1 &&
+              a.constant_value() == std::numeric_limits<int64_t>::min())) {
+          result = SymbolicDim(a.constant_value() / b.constant_value());
+        }
+      } else {
+        result = SymbolicDim::FloorDiv(a, b);
+      }
+    }
+    result.ToDimension(value.add_dim());
+  }
+  ctx.addOutputData(0, std::move(value));
+}
+
+} // namespace ONNX_NAMESPACE
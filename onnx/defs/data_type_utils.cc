@@ -86,26 +86,44 @@ DataTypeUtils::GetTypeStrToProtoMap() {
   return map;
 }
 
+std::unordered_map<std::string, DataType>&
+DataTypeUtils::GetTypeSpellingMap() {
+  static std::unordered_map<std::string, DataType> map;
+  return map;
+}
+
 std::mutex& DataTypeUtils::GetTypeStrLock() {
   static std::mutex lock;
   return lock;
 }
 
+DataType DataTypeUtils::InternTypeStr(const std::string& type_str) {
+  auto it = GetTypeStrToProtoMap().find(type_str);
+  if (it == GetTypeStrToProtoMap().end()) {
+    TypeProto type;
+    FromString(type_str, type);
+    it = GetTypeStrToProtoMap().emplace(type_str, type).first;
+  }
+  return &it->first;
+}
+
 DataType DataTypeUtils::ToType(const TypeProto& type_proto) {
   auto typeStr = ToString(type_proto);
   std::lock_guard<std::mutex> lock(GetTypeStrLock());
-  if (GetTypeStrToProtoMap().find(typeStr) == GetTypeStrToProtoMap().end()) {
-    TypeProto type;
-    FromString(typeStr, type);
-    GetTypeStrToProtoMap()[typeStr] = type;
-  }
-  return &(GetTypeStrToProtoMap().find(typeStr)->first);
+  return InternTypeStr(typeStr);
 }
 
 DataType DataTypeUtils::ToType(const std::string& type_str) {
-  TypeProto type;
-  FromString(type_str, type);
-  return ToType(type);
+  std::lock_guard<std::mutex> lock(GetTypeStrLock());
+  auto it = GetTypeSpellingMap().find(type_str);
+  if (it == GetTypeSpellingMap().end()) {
+    TypeProto type;
+    FromString(type_str, type);
+    it = GetTypeSpellingMap()
+             .emplace(type_str, InternTypeStr(ToString(type)))
+             .first;
+  }
+  return it->second;
 }
 
 const TypeProto& DataTypeUtils::ToTypeProto(const DataType& data_type) {
@@ -59,7 +59,17 @@ class DataTypeUtils final {
 
   static std::unordered_map<std::string, TypeProto>& GetTypeStrToProtoMap();
 
-  // Returns lock used for concurrent updates to TypeStrToProtoMap.
+  // The DataType of the canonical type string type_str, which is added to
+  // TypeStrToProtoMap if new. Requires GetTypeStrLock().
+  static DataType InternTypeStr(const std::string& type_str);
+
+  // Type strings as spelled by callers of ToType, which need not be
+  // canonical, to their DataType. Lets schema registration skip parsing and
+  // printing the same type strings for every schema.
+  static std::unordered_map<std::string, DataType>& GetTypeSpellingMap();
+
+  // Returns lock used for concurrent updates to TypeStrToProtoMap and
+  // TypeSpellingMap.
   static std::mutex& GetTypeStrLock();
 };
 } // namespace Utils
@@ -225,6 +225,22 @@ ONNX_OPERATOR_SET_SCHEMA(
 
           // Shape inference based on input shape
           const TensorProto* targetShapeInitializer = ctx.getInputData(0);
+          const TensorShapeProto* symbolicTargetShape =
+              ctx.getSymbolicInput(0);
+          if (!targetShapeInitializer && symbolicTargetShape) {
+            // The shape is known from data propagation, but symbolically.
+            auto* final_output_shape =
+                ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+            for (const auto& dim : symbolicTargetShape->dim()) {
+              auto* new_dim = final_output_shape->add_dim();
+              if (dim.has_dim_param()) {
+                new_dim->set_dim_param(dim.dim_param());
+              } else if (dim.has_dim_value()) {
+                new_dim->set_dim_value(dim.dim_value());
+              }
+            }
+            return;
+          }
           if (!targetShapeInitializer) {
             // This is the case when exact shape input is not available.
             // In this case, if the number of dimensions can be infered
@@ -3,6 +3,8 @@
 
 #include <algorithm>
 #include <functional>
+#include "onnx/defs/cost_functions.h"
+#include "onnx/defs/data_propagators.h"
 #include "onnx/defs/function.h"
 #include "onnx/defs/schema.h"
 #include "onnx/defs/tensor_proto_util.h"
@@ -124,12 +126,22 @@ and contains the {name} values of the corresponding input.
 ONNX_OPERATOR_SET_SCHEMA(
     Add,
     13,
-    OpSchema().FillUsing(MathDocGenerator("addition")));
+    OpSchema()
+        .FillUsing(MathDocGenerator("addition"))
+        .PartialDataPropagationFunction([](DataPropagationContext& ctx) {
+          mathOpDataPropagator(ctx, "Add");
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Sub,
     13,
-    OpSchema().FillUsing(MathDocGenerator("subtraction")));
+    OpSchema()
+        .FillUsing(MathDocGenerator("subtraction"))
+        .PartialDataPropagationFunction([](DataPropagationContext& ctx) {
+          mathOpDataPropagator(ctx, "Sub");
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Mod_doc = R"DOC(
   Performs element-wise binary modulus (with Numpy-style broadcasting support). 
@@ -171,17 +183,28 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ctx.getInputType(0)->tensor_type().shape(),
                 ctx.getInputType(1)->tensor_type().shape(),
                 *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape());
-        }));
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Mul,
     13,
-    OpSchema().FillUsing(MathDocGenerator("multiplication")));
+    OpSchema()
+        .FillUsing(MathDocGenerator("multiplication"))
+        .PartialDataPropagationFunction([](DataPropagationContext& ctx) {
+          mathOpDataPropagator(ctx, "Mul");
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Div,
     13,
-    OpSchema().FillUsing(MathDocGenerator("division")));
+    OpSchema()
+        .FillUsing(MathDocGenerator("division"))
+        .PartialDataPropagationFunction([](DataPropagationContext& ctx) {
+          mathOpDataPropagator(ctx, "Div");
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Neg_ver13_doc = R"DOC(
 Neg takes one input data (Tensor<T>) and produces one output data
@@ -207,7 +230,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(double)",
              "tensor(bfloat16)"},
             "Constrain input and output types to signed numeric tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Abs_ver13_doc = R"DOC(
 Absolute takes one input data (Tensor<T>) and produces one output data
@@ -226,7 +250,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             OpSchema::all_numeric_types_with_bfloat(),
             "Constrain input and output types to all numeric tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Reciprocal_ver13_doc = R"DOC(
 Reciprocal takes one input data (Tensor<T>) and produces one output data
@@ -248,7 +273,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(double)",
              "tensor(bfloat16)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Floor_ver13_doc = R"DOC(
 Floor takes one input data (Tensor<T>) and produces one output data
@@ -270,7 +296,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(double)",
              "tensor(bfloat16)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Ceil_ver13_doc = R"DOC(
 Ceil takes one input data (Tensor<T>) and produces one output data
@@ -292,7 +319,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(double)",
              "tensor(bfloat16)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Sqrt_ver13_doc = R"DOC(
 Square root takes one input data (Tensor<T>) and produces one output data
@@ -314,7 +342,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(double)",
              "tensor(bfloat16)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Relu_ver13_doc = R"DOC(
 Relu takes one input data (Tensor<T>) and produces one output data
@@ -336,7 +365,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(double)",
              "tensor(bfloat16)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* LeakyRelu_ver6_doc = R"DOC(
 LeakyRelu takes input data (Tensor<T>) and an argument alpha, and produces one
@@ -356,7 +386,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(2)));
 
 static const char* ThresholdedRelu_ver10_doc = R"DOC(
 ThresholdedRelu takes one input data (Tensor<T>) and produces one output data
@@ -376,7 +407,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Selu_ver6_doc = R"DOC(
 Selu takes one input data (Tensor<T>) and produces one output data
@@ -408,7 +440,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(3)));
 
 static const char* Elu_ver6_doc = R"DOC(
 Elu takes one input data (Tensor<T>) and produces one output data
@@ -429,7 +462,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(3)));
 
 static const char* celu_ver12_doc = R"DOC(
 Continuously Differentiable Exponential Linear Units:
@@ -521,7 +555,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(double)",
              "tensor(bfloat16)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Log_ver13_doc = R"DOC(
 Calculates the natural log of the given input tensor, element-wise.
@@ -546,7 +581,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(double)",
              "tensor(bfloat16)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Tanh_ver13_doc = R"DOC(
 Calculates the hyperbolic tangent of the given input tensor element-wise.
@@ -571,7 +607,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(double)",
              "tensor(bfloat16)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Pow_ver13_doc = R"DOC(
 Pow takes input data (Tensor<T>) and exponent Tensor, and
@@ -618,7 +655,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ctx.getInputType(0)->tensor_type().shape(),
                 ctx.getInputType(1)->tensor_type().shape(),
                 *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape());
-        }));
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* PRelu_ver9_doc = R"DOC(
 PRelu takes input data (Tensor<T>) and slope tensor as input, and produces one
@@ -651,7 +689,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(int32)",
              "tensor(int64)"},
             "Constrain input and output types to float/int tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(2)));
 
 static const char* Sigmoid_ver13_doc = R"DOC(
 Sigmoid takes one input data (Tensor<T>) and produces one output data
@@ -673,7 +712,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(double)",
              "tensor(bfloat16)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(3)));
 
 static const char* HardSigmoid_ver6_doc = R"DOC(
 HardSigmoid takes one input data (Tensor<T>) and produces one output data
@@ -694,7 +734,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(3)));
 
 // Generate opschema for element-wise ops. Leaves type constraint "T"
 // unspecified.
@@ -747,7 +788,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             OpSchema::all_numeric_types_with_bfloat(),
-            "Constrain input and output types to numeric tensors."));
+            "Constrain input and output types to numeric tensors.")
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Min,
@@ -757,7 +799,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             OpSchema::all_numeric_types_with_bfloat(),
-            "Constrain input and output types to numeric tensors."));
+            "Constrain input and output types to numeric tensors.")
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Sum,
@@ -770,7 +813,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(float)",
              "tensor(double)",
              "tensor(bfloat16)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Mean,
@@ -783,7 +827,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(float)",
              "tensor(double)",
              "tensor(bfloat16)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(variadicElementwiseCost(1)));
 
 static const char* Clip_ver13_doc = R"DOC(
 Clip operator limits the given input within an interval. The interval is
@@ -816,26 +861,32 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             OpSchema::all_numeric_types_with_bfloat(),
             "Constrain input and output types to all numeric tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(2)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Softmax,
     13,
-    OpSchema().FillUsing(
-        SoftmaxFamilyDocGenerator("softmax", "normalized exponential")));
+    OpSchema()
+        .FillUsing(
+            SoftmaxFamilyDocGenerator("softmax", "normalized exponential"))
+        .CostModelFunction(elementwiseCost(5)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     LogSoftmax,
     13,
-    OpSchema().FillUsing(
-        SoftmaxFamilyDocGenerator("logsoftmax", "log of softmax")));
+    OpSchema()
+        .FillUsing(SoftmaxFamilyDocGenerator("logsoftmax", "log of softmax"))
+        .CostModelFunction(elementwiseCost(5)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Hardmax,
     13,
-    OpSchema().FillUsing(SoftmaxFamilyDocGenerator(
-        "hardmax",
-        "1 for the first maximum value, and 0 for all others")));
+    OpSchema()
+        .FillUsing(SoftmaxFamilyDocGenerator(
+            "hardmax",
+            "1 for the first maximum value, and 0 for all others"))
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Softsign_ver1_doc = R"DOC(
 Calculates the softsign (x/(1+|x|)) of the given input tensor element-wise.
@@ -856,7 +907,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(3)));
 
 static const char* Softplus_ver1_doc = R"DOC(
 Softplus takes one input data (Tensor<T>) and produces one output data
@@ -875,7 +927,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(3)));
 
 static const char* Gemm_ver13_doc = R"DOC(General Matrix multiplication:
 https://en.wikipedia.org/wiki/Basic_Linear_Algebra_Subprograms#Level_3
@@ -975,7 +1028,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 {first_input_shape.dim(transA ? 1 : 0),
                  second_input_shape.dim(transB ? 0 : 1)});
           }
-        }));
+        })
+        .CostModelFunction(gemmCost));
 
 void matmulShapeInference(
     ONNX_NAMESPACE::InferenceContext& ctx,
@@ -1076,7 +1130,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
           propagateElemTypeFromInputToOutput(ctx, 0, 0);
           matmulShapeInference(ctx, 0, 1);
-        }));
+        })
+        .CostModelFunction(matMulCost));
 
 static const char* TopK_ver11_doc = R"DOC(
 Retrieve the top-K largest or smallest elements along a specified axis. Given an input tensor of
@@ -1223,7 +1278,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Cos_ver7_doc = R"DOC(
 Calculates the cosine of the given input tensor, element-wise.
@@ -1245,7 +1301,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Tan_ver7_doc = R"DOC(
 Calculates the tangent of the given input tensor, element-wise.
@@ -1267,7 +1324,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Asin_ver7_doc = R"DOC(
 Calculates the arcsine (inverse of sine) of the given input tensor, element-wise.
@@ -1289,7 +1347,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Acos_ver7_doc = R"DOC(
 Calculates the arccosine (inverse of cosine) of the given input tensor, element-wise.
@@ -1311,7 +1370,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Atan_ver7_doc = R"DOC(
 Calculates the arctangent (inverse of tangent) of the given input tensor, element-wise.
@@ -1333,7 +1393,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Expand_ver13_doc = R"DOC(
 Broadcast the input tensor following the given shape and the broadcast rule.
@@ -1414,7 +1475,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Cosh_ver9_doc = R"DOC(
 Calculates the hyperbolic cosine of the given input tensor element-wise.
@@ -1436,7 +1498,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Asinh_ver9_doc = R"DOC(
 Calculates the hyperbolic arcsine of the given input tensor element-wise.
@@ -1458,7 +1521,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Acosh_ver9_doc = R"DOC(
 Calculates the hyperbolic arccosine of the given input tensor element-wise.
@@ -1480,7 +1544,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Atanh_ver9_doc = R"DOC(
 Calculates the hyperbolic arctangent of the given input tensor element-wise.
@@ -1502,7 +1567,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Sign_ver13_doc = R"DOC(
 Calculate the sign of the given input tensor element-wise.
@@ -1525,7 +1591,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             OpSchema::all_numeric_types_with_bfloat(),
             "Constrain input and output types to all numeric tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Erf_ver13_doc = R"DOC(
 Computes the error function of the given input tensor element-wise.
@@ -1547,7 +1614,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             OpSchema::all_numeric_types_with_bfloat(),
             "Constrain input and output types to all numeric tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* QLinearMatMul_ver10_doc = R"DOC(
 Matrix product that behaves like numpy.matmul: https://docs.scipy.org/doc/numpy-1.13.0/reference/generated/numpy.matmul.html.
@@ -1675,7 +1743,8 @@ ONNX_OPERATOR_SET_SCHEMA(
               ONNX_NAMESPACE::TensorProto::INT32);
 
           matmulShapeInference(ctx, 0, 1);
-        }));
+        })
+        .CostModelFunction(matMulCost));
 static const char* CumSum_ver11_doc = R"DOC(
 Performs cumulative sum of the input elements along the given axis.
 By default, it will do the sum inclusively meaning the first element is copied as is.
@@ -1741,7 +1810,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             {"tensor(int32)", "tensor(int64)"},
             "axis tensor can be int32 or int64 only")
         .TypeAndShapeInferenceFunction(
-            ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+            ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Round_ver11_doc = R"DOC(
 Round takes one input Tensor and rounds the values, element-wise, meaning
@@ -1770,7 +1840,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Det_ver11_doc = R"DOC(
 Det calculates determinant of a square matrix or batches of square matrices.
@@ -2,6 +2,8 @@
 // Licensed under the MIT license.
 
 #include <functional>
+#include "onnx/defs/cost_functions.h"
+#include "onnx/defs/data_propagators.h"
 #include "onnx/defs/schema.h"
 #include "onnx/defs/tensor_proto_util.h"
 #include "onnx/defs/function.h"
@@ -43,22 +45,42 @@ Performs element-wise binary {name} (with Numpy-style broadcasting support).
 ONNX_OPERATOR_SET_SCHEMA(
     Add,
     7,
-    OpSchema().FillUsing(MathDocGenerator_opset_7("addition")));
+    OpSchema()
+        .FillUsing(MathDocGenerator_opset_7("addition"))
+        .PartialDataPropagationFunction([](DataPropagationContext& ctx) {
+          mathOpDataPropagator(ctx, "Add");
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Sub,
     7,
-    OpSchema().FillUsing(MathDocGenerator_opset_7("subtraction")));
+    OpSchema()
+        .FillUsing(MathDocGenerator_opset_7("subtraction"))
+        .PartialDataPropagationFunction([](DataPropagationContext& ctx) {
+          mathOpDataPropagator(ctx, "Sub");
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Mul,
     7,
-    OpSchema().FillUsing(MathDocGenerator_opset_7("multiplication")));
+    OpSchema()
+        .FillUsing(MathDocGenerator_opset_7("multiplication"))
+        .PartialDataPropagationFunction([](DataPropagationContext& ctx) {
+          mathOpDataPropagator(ctx, "Mul");
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Div,
     7,
-    OpSchema().FillUsing(MathDocGenerator_opset_7("division")));
+    OpSchema()
+        .FillUsing(MathDocGenerator_opset_7("division"))
+        .PartialDataPropagationFunction([](DataPropagationContext& ctx) {
+          mathOpDataPropagator(ctx, "Div");
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 std::function<void(OpSchema&)> SoftmaxFamilyDocGenerator_opset_11(
     const char* name,
@@ -141,22 +163,28 @@ and contains the {name} values of the corresponding input.
 ONNX_OPERATOR_SET_SCHEMA(
     Softmax,
     11,
-    OpSchema().FillUsing(SoftmaxFamilyDocGenerator_opset_11(
-        "softmax",
-        "normalized exponential")));
+    OpSchema()
+        .FillUsing(SoftmaxFamilyDocGenerator_opset_11(
+            "softmax",
+            "normalized exponential"))
+        .CostModelFunction(elementwiseCost(5)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     LogSoftmax,
     11,
-    OpSchema().FillUsing(
-        SoftmaxFamilyDocGenerator_opset_11("logsoftmax", "log of softmax")));
+    OpSchema()
+        .FillUsing(
+            SoftmaxFamilyDocGenerator_opset_11("logsoftmax", "log of softmax"))
+        .CostModelFunction(elementwiseCost(5)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Hardmax,
     11,
-    OpSchema().FillUsing(SoftmaxFamilyDocGenerator_opset_11(
-        "hardmax",
-        "1 for the first maximum value, and 0 for all others")));
+    OpSchema()
+        .FillUsing(SoftmaxFamilyDocGenerator_opset_11(
+            "hardmax",
+            "1 for the first maximum value, and 0 for all others"))
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Mod_doc_10 = R"DOC(
   Performs element-wise binary modulus (with Numpy-style broadcasting support). 
@@ -198,7 +226,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ctx.getInputType(0)->tensor_type().shape(),
                 ctx.getInputType(1)->tensor_type().shape(),
                 *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape());
-        }));
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Neg_ver6_doc = R"DOC(
 Neg takes one input data (Tensor<T>) and produces one output data
@@ -223,7 +252,8 @@ ONNX_OPERATOR_SET_SCHEMA(
              "tensor(float16)",
              "tensor(double)"},
             "Constrain input and output types to signed numeric tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Abs_ver6_doc = R"DOC(
 Absolute takes one input data (Tensor<T>) and produces one output data
@@ -242,7 +272,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             OpSchema::all_numeric_types(),
             "Constrain input and output types to all numeric tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Reciprocal_ver6_doc = R"DOC(
 Reciprocal takes one input data (Tensor<T>) and produces one output data
@@ -261,7 +292,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Floor_ver6_doc = R"DOC(
 Floor takes one input data (Tensor<T>) and produces one output data
@@ -280,7 +312,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Ceil_ver6_doc = R"DOC(
 Ceil takes one input data (Tensor<T>) and produces one output data
@@ -299,7 +332,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Sqrt_ver6_doc = R"DOC(
 Square root takes one input data (Tensor<T>) and produces one output data
@@ -318,7 +352,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Relu_ver6_doc = R"DOC(
 Relu takes one input data (Tensor<T>) and produces one output data
@@ -337,7 +372,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Exp_ver6_doc = R"DOC(
 Calculates the exponential of the given input tensor, element-wise.
@@ -359,7 +395,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Log_ver6_doc = R"DOC(
 Calculates the natural log of the given input tensor, element-wise.
@@ -381,7 +418,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Tanh_ver6_doc = R"DOC(
 Calculates the hyperbolic tangent of the given input tensor element-wise.
@@ -403,7 +441,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Pow_ver12_doc = R"DOC(
 Pow takes input data (Tensor<T>) and exponent Tensor, and
@@ -449,7 +488,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ctx.getInputType(0)->tensor_type().shape(),
                 ctx.getInputType(1)->tensor_type().shape(),
                 *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape());
-        }));
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Sigmoid_ver6_doc = R"DOC(
 Sigmoid takes one input data (Tensor<T>) and produces one output data
@@ -468,7 +508,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(3)));
 
 // Generate opschema for element-wise ops. Leaves type constraint "T"
 // unspecified.
@@ -521,7 +562,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             OpSchema::all_numeric_types(),
-            "Constrain input and output types to numeric tensors."));
+            "Constrain input and output types to numeric tensors.")
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Min,
@@ -531,7 +573,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             OpSchema::all_numeric_types(),
-            "Constrain input and output types to numeric tensors."));
+            "Constrain input and output types to numeric tensors.")
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Sum,
@@ -541,7 +584,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Mean,
@@ -551,7 +595,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(variadicElementwiseCost(1)));
 
 static const char* Clip_ver12_doc = R"DOC(
 Clip operator limits the given input within an interval. The interval is
@@ -584,7 +629,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             OpSchema::all_numeric_types(),
             "Constrain input and output types to all numeric tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(2)));
 
 static const char* Gemm_ver11_doc = R"DOC(General Matrix multiplication:
 https://en.wikipedia.org/wiki/Basic_Linear_Algebra_Subprograms#Level_3
@@ -683,7 +729,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 {first_input_shape.dim(transA ? 1 : 0),
                  second_input_shape.dim(transB ? 0 : 1)});
           }
-        }));
+        })
+        .CostModelFunction(gemmCost));
 
 void matmulShapeInference_opset_9(
     ONNX_NAMESPACE::InferenceContext& ctx,
@@ -783,7 +830,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
           propagateElemTypeFromInputToOutput(ctx, 0, 0);
           matmulShapeInference_opset_9(ctx, 0, 1);
-        }));
+        })
+        .CostModelFunction(matMulCost));
 
 static const char* Expand_ver8_doc = R"DOC(
 Broadcast the input tensor following the given shape and the broadcast rule.
@@ -865,7 +913,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             OpSchema::all_numeric_types(),
             "Constrain input and output types to all numeric tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Erf_ver9_doc = R"DOC(
 Computes the error function of the given input tensor element-wise.
@@ -887,7 +936,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             OpSchema::all_numeric_types(),
             "Constrain input and output types to all numeric tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 const char* reduction_doc_sce_opset12 =
     "Type of reduction to apply to loss: none, sum, mean(default). "
@@ -1127,21 +1177,28 @@ will throw errors.
 ONNX_OPERATOR_SET_SCHEMA(
     Softmax,
     1,
-    OpSchema().FillUsing(
-        SoftmaxFamilyDocGenerator_opset1("softmax", "normalized exponential")));
+    OpSchema()
+        .FillUsing(SoftmaxFamilyDocGenerator_opset1(
+            "softmax",
+            "normalized exponential"))
+        .CostModelFunction(elementwiseCost(5)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     LogSoftmax,
     1,
-    OpSchema().FillUsing(
-        SoftmaxFamilyDocGenerator_opset1("logsoftmax", "log of softmax")));
+    OpSchema()
+        .FillUsing(
+            SoftmaxFamilyDocGenerator_opset1("logsoftmax", "log of softmax"))
+        .CostModelFunction(elementwiseCost(5)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Hardmax,
     1,
-    OpSchema().FillUsing(SoftmaxFamilyDocGenerator_opset1(
-        "hardmax",
-        "1 for the first maximum value, and 0 for all others")));
+    OpSchema()
+        .FillUsing(SoftmaxFamilyDocGenerator_opset1(
+            "hardmax",
+            "1 for the first maximum value, and 0 for all others"))
+        .CostModelFunction(elementwiseCost(1)));
 
 const char* kBroadcastDoc_old = R"DOC(
 If necessary the right-hand-side argument will be broadcasted to match the
@@ -1253,42 +1310,58 @@ Performs element-wise binary {name} (with limited broadcast support).
 ONNX_OPERATOR_SET_SCHEMA(
     Add,
     1,
-    OpSchema().FillUsing(MathDocGenerator_old("addition")));
+    OpSchema()
+        .FillUsing(MathDocGenerator_old("addition"))
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Sub,
     1,
-    OpSchema().FillUsing(MathDocGenerator_old("subtraction")));
+    OpSchema()
+        .FillUsing(MathDocGenerator_old("subtraction"))
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Mul,
     1,
-    OpSchema().FillUsing(MathDocGenerator_old("multiplication")));
+    OpSchema()
+        .FillUsing(MathDocGenerator_old("multiplication"))
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Div,
     1,
-    OpSchema().FillUsing(MathDocGenerator_old("division")));
+    OpSchema()
+        .FillUsing(MathDocGenerator_old("division"))
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Add,
     6,
-    OpSchema().FillUsing(MathDocGenerator_old_opset6("addition")));
+    OpSchema()
+        .FillUsing(MathDocGenerator_old_opset6("addition"))
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Sub,
     6,
-    OpSchema().FillUsing(MathDocGenerator_old_opset6("subtraction")));
+    OpSchema()
+        .FillUsing(MathDocGenerator_old_opset6("subtraction"))
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Mul,
     6,
-    OpSchema().FillUsing(MathDocGenerator_old_opset6("multiplication")));
+    OpSchema()
+        .FillUsing(MathDocGenerator_old_opset6("multiplication"))
+        .CostModelFunction(elementwiseCost(1)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Div,
     6,
-    OpSchema().FillUsing(MathDocGenerator_old_opset6("division")));
+    OpSchema()
+        .FillUsing(MathDocGenerator_old_opset6("division"))
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Pow_ver1_doc = R"DOC(
 Pow takes input data (Tensor<T>) and exponent Tensor, and
@@ -1323,7 +1396,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Pow_ver7_doc = R"DOC(
 Pow takes input data (Tensor<T>) and exponent Tensor, and
@@ -1350,7 +1424,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ctx.getInputType(0)->tensor_type().shape(),
                 ctx.getInputType(1)->tensor_type().shape(),
                 *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape());
-        }));
+        })
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Neg_ver1_doc = R"DOC(
 Neg takes one input data (Tensor<T>) and produces one output data
@@ -1376,7 +1451,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Abs_ver1_doc = R"DOC(
 Absolute takes one input data (Tensor<T>) and produces one output data
@@ -1402,7 +1478,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Reciprocal_ver1_doc = R"DOC(
 Reciprocal takes one input data (Tensor<T>) and produces one output data
@@ -1428,7 +1505,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Floor_ver1_doc = R"DOC(
 Floor takes one input data (Tensor<T>) and produces one output data
@@ -1454,7 +1532,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Ceil_ver1_doc = R"DOC(
 Ceil takes one input data (Tensor<T>) and produces one output data
@@ -1480,7 +1559,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Sqrt_ver1_doc = R"DOC(
 Square root takes one input data (Tensor<T>) and produces one output data
@@ -1506,7 +1586,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Relu_ver1_doc = R"DOC(
 Relu takes one input data (Tensor<T>) and produces one output data
@@ -1532,7 +1613,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* LeakyRelu_ver1_doc = R"DOC(
 LeakyRelu takes input data (Tensor<T>) and an argument alpha, and produces one
@@ -1563,7 +1645,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(2)));
 
 static const char* Selu_ver1_doc = R"DOC(
 Selu takes one input data (Tensor<T>) and produces one output data
@@ -1600,7 +1683,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(3)));
 
 static const char* Elu_ver1_doc = R"DOC(
 Elu takes one input data (Tensor<T>) and produces one output data
@@ -1632,7 +1716,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(3)));
 
 static const char* Exp_ver1_doc = R"DOC(
 Calculates the exponential of the given input tensor, element-wise.
@@ -1661,7 +1746,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Log_ver1_doc = R"DOC(
 Calculates the natural log of the given input tensor, element-wise.
@@ -1690,7 +1776,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* Tanh_ver1_doc = R"DOC(
 Calculates the hyperbolic tangent of the given input tensor element-wise.
@@ -1719,7 +1806,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(1)));
 
 static const char* PRelu_ver1_doc = R"DOC(
 
@@ -1753,7 +1841,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(2)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     PRelu,
@@ -1772,7 +1861,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(2)));
 
 static const char* PRelu_ver7_doc = R"DOC(
 PRelu takes input data (Tensor<T>) and slope tensor as input, and produces one
@@ -1799,7 +1889,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(2)));
 
 static const char* Sigmoid_ver1_doc = R"DOC(
 Sigmoid takes one input data (Tensor<T>) and produces one output data
@@ -1825,7 +1916,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(3)));
 
 static const char* HardSigmoid_ver1_doc = R"DOC(
 HardSigmoid takes one input data (Tensor<T>) and produces one output data
@@ -1861,7 +1953,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(3)));
 
 static const char* Max_ver1_doc = R"DOC(
 Element-wise max of each of the input tensors. All inputs and outputs must
@@ -1886,7 +1979,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 static const char* Min_ver1_doc = R"DOC(
 Element-wise min of each of the input tensors. All inputs and outputs must
@@ -1911,7 +2005,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 static const char* Sum_ver1_doc = R"DOC(
 Element-wise sum of each of the input tensors. All inputs and outputs must
@@ -1936,7 +2031,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 static const char* Mean_ver1_doc = R"DOC(
 Element-wise mean of each of the input tensors. All inputs and outputs must
@@ -1966,7 +2062,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(variadicElementwiseCost(1)));
 
 static const char* Clip_ver1_doc = R"DOC(
 Clip operator limits the given input within an interval. The interval is
@@ -2002,7 +2099,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(2)));
 
 static const char* Gemm_ver1_doc = R"DOC(General Matrix multiplication:
 https://en.wikipedia.org/wiki/Basic_Linear_Algebra_Subprograms#Level_3
@@ -2054,7 +2152,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "beta",
             "Scalar multiplier for input tensor C, the default value is 1.0.",
             AttributeProto::FLOAT,
-            1.0f));
+            1.0f)
+        .CostModelFunction(gemmCost));
 
 static const char* Gemm_ver6_doc = R"DOC(General Matrix multiplication:
 https://en.wikipedia.org/wiki/Basic_Linear_Algebra_Subprograms#Level_3
@@ -2131,7 +2230,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape() =
                 ctx.getInputType(2)->tensor_type().shape();
           }
-        }));
+        })
+        .CostModelFunction(gemmCost));
 
 static const char* Gemm_ver7_doc = R"DOC(General Matrix multiplication:
 https://en.wikipedia.org/wiki/Basic_Linear_Algebra_Subprograms#Level_3
@@ -2221,7 +2321,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 {first_input_shape.dim(transA ? 1 : 0),
                  second_input_shape.dim(transB ? 0 : 1)});
           }
-        }));
+        })
+        .CostModelFunction(gemmCost));
 
 static const char* Gemm_ver9_doc = R"DOC(General Matrix multiplication:
 https://en.wikipedia.org/wiki/Basic_Linear_Algebra_Subprograms#Level_3
@@ -2317,7 +2418,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 {first_input_shape.dim(transA ? 1 : 0),
                  second_input_shape.dim(transB ? 0 : 1)});
           }
-        }));
+        })
+        .CostModelFunction(gemmCost));
 
 static const char* Max_ver6_doc = R"DOC(
 Element-wise max of each of the input tensors. All inputs and outputs must
@@ -2335,7 +2437,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 static const char* Min_ver6_doc = R"DOC(
 Element-wise min of each of the input tensors. All inputs and outputs must
@@ -2353,7 +2456,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 static const char* Sum_ver6_doc = R"DOC(
 Element-wise sum of each of the input tensors. All inputs and outputs must
@@ -2371,7 +2475,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 static const char* Mean_ver6_doc = R"DOC(
 Element-wise mean of each of the input tensors. All inputs and outputs must
@@ -2394,7 +2499,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(variadicElementwiseCost(1)));
 
 static const char* MatMul_ver1_doc = R"DOC(
 Matrix product that behaves like numpy.matmul: https://docs.scipy.org/doc/numpy-1.13.0/reference/generated/numpy.matmul.html
@@ -2484,7 +2590,8 @@ ONNX_OPERATOR_SET_SCHEMA(
 
           *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape() =
               resultShape;
-        }));
+        })
+        .CostModelFunction(matMulCost));
 
 static const char* TopK_ver1_doc = R"DOC(
 Retrieve the top-K elements along a specified axis. Given an input tensor of
@@ -2698,7 +2805,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(2)));
 
 static const char* Clip_ver11_doc = R"DOC(
 Clip operator limits the given input within an interval. The interval is
@@ -2731,7 +2839,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .CostModelFunction(elementwiseCost(2)));
 
 std::function<void(OpSchema&)> ElementwiseMultiOpDocGenerator_old(
     const char* name) {
@@ -2781,11 +2890,15 @@ All inputs and outputs must have the same data type.
 ONNX_OPERATOR_SET_SCHEMA(
     Max,
     8,
-    OpSchema().FillUsing(ElementwiseMultiOpDocGenerator_old("max")));
+    OpSchema()
+        .FillUsing(ElementwiseMultiOpDocGenerator_old("max"))
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 ONNX_OPERATOR_SET_SCHEMA(
     Min,
     8,
-    OpSchema().FillUsing(ElementwiseMultiOpDocGenerator_old("min")));
+    OpSchema()
+        .FillUsing(ElementwiseMultiOpDocGenerator_old("min"))
+        .CostModelFunction(variadicElementwiseCost(0)));
 
 } // namespace ONNX_NAMESPACE
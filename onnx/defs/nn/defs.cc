@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include "onnx/defs/cost_functions.h"
 #include "onnx/defs/function.h"
 #include "onnx/defs/schema.h"
 
@@ -333,7 +334,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "count_include_pad",
             "Whether include pad pixels when calculating values for the edges. Default is 0, doesn't count include pad.",
             AttributeProto::INT,
-            static_cast<int64_t>(0)));
+            static_cast<int64_t>(0))
+        .CostModelFunction(poolCost));
 
 ONNX_OPERATOR_SET_SCHEMA(
     MaxPool,
@@ -372,7 +374,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "I",
             {"tensor(int64)"},
-            "Constrain index tensor to int64"));
+            "Constrain index tensor to int64")
+        .CostModelFunction(poolCost));
 
 void maxUnpoolShapeInference(InferenceContext& ctx) {
   // we need at least two inputs to have a shape for this inference.
@@ -614,7 +617,9 @@ std::function<void(OpSchema&)> LpPoolOpSchemaGenerator(const char* name) {
 ONNX_OPERATOR_SET_SCHEMA(
     LpPool,
     11,
-    OpSchema().FillUsing(LpPoolOpSchemaGenerator("LpPool")));
+    OpSchema()
+        .FillUsing(LpPoolOpSchemaGenerator("LpPool"))
+        .CostModelFunction(poolCost));
 
 // For ROI pool operations.
 void roiPoolTypeShapeInference(InferenceContext& ctx) {
@@ -829,7 +834,9 @@ computes the output.)DOC";
 ONNX_OPERATOR_SET_SCHEMA(
     Conv,
     11,
-    OpSchema().FillUsing(ConvOpSchemaGenerator("a filter")));
+    OpSchema()
+        .FillUsing(ConvOpSchemaGenerator("a filter"))
+        .CostModelFunction(convCost));
 
 static const char* QLinearConv_ver10_doc = R"DOC(
 The convolution operator consumes a quantized input tensor, its scale and zero point,
@@ -1400,7 +1407,9 @@ output_shape can also be explicitly specified in which case pads values are auto
 ONNX_OPERATOR_SET_SCHEMA(
     ConvTranspose,
     11,
-    OpSchema().FillUsing(ConvTransposeOpSchemaGenerator("a filter")));
+    OpSchema()
+        .FillUsing(ConvTransposeOpSchemaGenerator("a filter"))
+        .CostModelFunction(convTransposeCost));
 
 // For GlobalPool operations.
 void globalPoolTypeShapeInference(InferenceContext& ctx) {
@@ -1472,12 +1481,15 @@ std::function<void(OpSchema&)> GlobalPoolingOpSchemaGenerator(
 ONNX_OPERATOR_SET_SCHEMA(
     GlobalAveragePool,
     1,
-    OpSchema().FillUsing(
-        GlobalPoolingOpSchemaGenerator("AveragePool", "average")));
+    OpSchema()
+        .FillUsing(GlobalPoolingOpSchemaGenerator("AveragePool", "average"))
+        .CostModelFunction(globalPoolCost));
 ONNX_OPERATOR_SET_SCHEMA(
     GlobalMaxPool,
     1,
-    OpSchema().FillUsing(GlobalPoolingOpSchemaGenerator("MaxPool", "max")));
+    OpSchema()
+        .FillUsing(GlobalPoolingOpSchemaGenerator("MaxPool", "max"))
+        .CostModelFunction(globalPoolCost));
 
 std::function<void(OpSchema&)> GlobalLpPoolingOpSchemaGenerator(
     const char* op_type,
@@ -1527,8 +1539,9 @@ std::function<void(OpSchema&)> GlobalLpPoolingOpSchemaGenerator(
 ONNX_OPERATOR_SET_SCHEMA(
     GlobalLpPool,
     2,
-    OpSchema().FillUsing(
-        GlobalLpPoolingOpSchemaGenerator("LpPool", "lp pool")));
+    OpSchema()
+        .FillUsing(GlobalLpPoolingOpSchemaGenerator("LpPool", "lp pool"))
+        .CostModelFunction(globalPoolCost));
 
 static const char* BatchNormalization_ver9_doc = R"DOC(
 Carries out batch normalization as described in the paper
@@ -1616,7 +1629,8 @@ ONNX_OPERATOR_SET_SCHEMA(
           propagateShapeAndTypeFromFirstInput(ctx);
           // TODO in training mode, it may be possible to infer some of
           // the other outputs as well.
-        }));
+        })
+        .CostModelFunction(elementwiseCost(2)));
 
 static const char* InstanceNormalization_ver6_doc = R"DOC(
 Carries out instance normalization as described in the paper
@@ -1666,7 +1680,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "Constrain input and output types to float tensors.")
         .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
           propagateShapeAndTypeFromFirstInput(ctx);
-        }));
+        })
+        .CostModelFunction(elementwiseCost(7)));
 
 static const char* LpNormalization_ver1_doc = R"DOC(
 Given a matrix, apply Lp-normalization along the provided axis.
@@ -2,6 +2,7 @@
 // Licensed under the MIT license.
 
 #include <cmath>
+#include "onnx/defs/cost_functions.h"
 #include "onnx/defs/function.h"
 #include "onnx/defs/schema.h"
 
@@ -630,10 +631,12 @@ std::function<void(OpSchema&)> PoolOpSchemaGenerator_10(
 ONNX_OPERATOR_SET_SCHEMA(
     AveragePool,
     1,
-    OpSchema().FillUsing(PoolOpSchemaGenerator_9(
-        "AveragePool",
-        "average",
-        "The output of each pooling window is divided by the number of elements exclude pad.")));
+    OpSchema()
+        .FillUsing(PoolOpSchemaGenerator_9(
+            "AveragePool",
+            "average",
+            "The output of each pooling window is divided by the number of elements exclude pad."))
+        .CostModelFunction(poolCost));
 
 ONNX_OPERATOR_SET_SCHEMA(
     AveragePool,
@@ -647,7 +650,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "count_include_pad",
             "Whether include pad pixels when calculating values for the edges. Default is 0, doesn't count include pad.",
             AttributeProto::INT,
-            static_cast<int64_t>(0)));
+            static_cast<int64_t>(0))
+        .CostModelFunction(poolCost));
 
 ONNX_OPERATOR_SET_SCHEMA(
     AveragePool,
@@ -663,15 +667,18 @@ ONNX_OPERATOR_SET_SCHEMA(
             "count_include_pad",
             "Whether include pad pixels when calculating values for the edges. Default is 0, doesn't count include pad.",
             AttributeProto::INT,
-            static_cast<int64_t>(0)));
+            static_cast<int64_t>(0))
+        .CostModelFunction(poolCost));
 
 ONNX_OPERATOR_SET_SCHEMA(
     MaxPool,
     1,
-    OpSchema().FillUsing(PoolOpSchemaGenerator_9(
-        "MaxPool",
-        "max",
-        "The output of each pooling window is maximum number of elements exclude pad.")));
+    OpSchema()
+        .FillUsing(PoolOpSchemaGenerator_9(
+            "MaxPool",
+            "max",
+            "The output of each pooling window is maximum number of elements exclude pad."))
+        .CostModelFunction(poolCost));
 
 ONNX_OPERATOR_SET_SCHEMA(
     MaxPool,
@@ -700,7 +707,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "I",
             {"tensor(int64)"},
-            "Constrain index tensor to int64"));
+            "Constrain index tensor to int64")
+        .CostModelFunction(poolCost));
 
 ONNX_OPERATOR_SET_SCHEMA(
     MaxPool,
@@ -736,7 +744,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "I",
             {"tensor(int64)"},
-            "Constrain index tensor to int64"));
+            "Constrain index tensor to int64")
+        .CostModelFunction(poolCost));
 
 ONNX_OPERATOR_SET_SCHEMA(
     MaxPool,
@@ -772,7 +781,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "I",
             {"tensor(int64)"},
-            "Constrain index tensor to int64"));
+            "Constrain index tensor to int64")
+        .CostModelFunction(poolCost));
 
 void maxUnpoolShapeInference1(InferenceContext& ctx) {
   // we need at least two inputs to have a shape for this inference.
@@ -1022,7 +1032,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(poolCost));
 
 std::function<void(OpSchema&)> LpPoolOpSchemaGenerator_10(const char* name) {
   return [=](OpSchema& schema) {
@@ -1088,7 +1099,9 @@ std::function<void(OpSchema&)> LpPoolOpSchemaGenerator_10(const char* name) {
 ONNX_OPERATOR_SET_SCHEMA(
     LpPool,
     2,
-    OpSchema().FillUsing(LpPoolOpSchemaGenerator_10("LpPool")));
+    OpSchema()
+        .FillUsing(LpPoolOpSchemaGenerator_10("LpPool"))
+        .CostModelFunction(poolCost));
 
 static const char* GlobalLpPool_ver1_doc = R"DOC(
  GlobalLpPool consumes an input tensor X and applies lp pool pooling across the
@@ -1188,7 +1201,9 @@ computes the output.)DOC";
 ONNX_OPERATOR_SET_SCHEMA(
     Conv,
     1,
-    OpSchema().FillUsing(ConvOpSchemaGenerator_10("a filter")));
+    OpSchema()
+        .FillUsing(ConvOpSchemaGenerator_10("a filter"))
+        .CostModelFunction(convCost));
 
 void convTransposeShapeInference1(InferenceContext& ctx) {
   propagateElemTypeFromInputToOutput(ctx, 0, 0);
@@ -1454,7 +1469,9 @@ output_shape can also be explicitly specified in which case pads values are auto
 ONNX_OPERATOR_SET_SCHEMA(
     ConvTranspose,
     1,
-    OpSchema().FillUsing(ConvTransposeOpSchemaGenerator_10("a filter")));
+    OpSchema()
+        .FillUsing(ConvTransposeOpSchemaGenerator_10("a filter"))
+        .CostModelFunction(convTransposeCost));
 
 ONNX_OPERATOR_SET_SCHEMA(
     GlobalLpPool,
@@ -1486,7 +1503,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(globalPoolCost));
 
 static const char* BatchNormalization_ver1_doc = R"DOC(
 Carries out batch normalization as described in the paper
@@ -1594,7 +1612,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(2)));
 
 static const char* InstanceNormalization_ver1_doc = R"DOC(
 Carries out instance normalization as described in the paper
@@ -1638,7 +1657,8 @@ ONNX_OPERATOR_SET_SCHEMA(
         .TypeConstraint(
             "T",
             {"tensor(float16)", "tensor(float)", "tensor(double)"},
-            "Constrain input and output types to float tensors."));
+            "Constrain input and output types to float tensors.")
+        .CostModelFunction(elementwiseCost(7)));
 
 static const char* Dropout_old_doc = R"DOC(
 Dropout takes one input data (Tensor<float>) and produces two Tensor outputs,
@@ -1894,7 +1914,8 @@ ONNX_OPERATOR_SET_SCHEMA(
           propagateShapeAndTypeFromFirstInput(ctx);
           // TODO in training mode, it may be possible to infer some of
           // the other outputs as well.
-        }));
+        })
+        .CostModelFunction(elementwiseCost(2)));
 
 static const char* Flatten_ver1_doc = R"DOC(
 Flattens the input tensor into a 2D matrix. If input tensor has shape
@@ -2112,5 +2133,6 @@ ONNX_OPERATOR_SET_SCHEMA(
           propagateShapeAndTypeFromFirstInput(ctx);
           // TODO in training mode, it may be possible to infer some of
           // the other outputs as well.
-        }));
+        })
+        .CostModelFunction(elementwiseCost(2)));
 } // namespace ONNX_NAMESPACE
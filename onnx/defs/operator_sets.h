@@ -108,119 +108,110 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Xor);
 class OpSet_Onnx_ver1 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Abs)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Add)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, And)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, ArgMax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, ArgMin)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, AveragePool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, BatchNormalization)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Cast)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Ceil)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Clip)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Concat)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Constant)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Conv)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, ConvTranspose)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, DepthToSpace)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Div)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Dropout)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Elu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Equal)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Exp)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Flatten)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Floor)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, GRU)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Gather)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Gemm)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, GlobalAveragePool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, GlobalLpPool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, GlobalMaxPool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Greater)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, HardSigmoid)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Hardmax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Identity)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, If)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, InstanceNormalization)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, LRN)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, LSTM)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, LeakyRelu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Less)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Log)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, LogSoftmax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Loop)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, LpNormalization)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, LpPool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, MatMul)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Max)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, MaxPool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, MaxRoiPool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Mean)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Min)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Mul)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Neg)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Not)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Or)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, PRelu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Pad)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Pow)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, RNN)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, RandomNormal)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, RandomNormalLike)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, RandomUniform)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, RandomUniformLike)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Reciprocal)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, ReduceL1)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, ReduceL2)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, ReduceLogSum)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, ReduceLogSumExp)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, ReduceMax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, ReduceMean)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, ReduceMin)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, ReduceProd)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, ReduceSum)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, ReduceSumSquare)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Relu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Reshape)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Selu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Shape)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Sigmoid)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Size)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Slice)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Softmax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Softplus)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Softsign)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 1, SpaceToDepth)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Split)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Sqrt)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Squeeze)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Sub)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Sum)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Tanh)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Tile)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, TopK)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Transpose)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Unsqueeze)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Upsample)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 1, Xor)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Abs),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Add),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, And),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ArgMax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ArgMin),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, AveragePool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, BatchNormalization),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Cast),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Ceil),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Clip),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Concat),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Constant),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Conv),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ConvTranspose),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, DepthToSpace),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Div),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Dropout),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Elu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Equal),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Exp),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Flatten),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Floor),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, GRU),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Gather),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Gemm),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, GlobalAveragePool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, GlobalLpPool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, GlobalMaxPool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Greater),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, HardSigmoid),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Hardmax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Identity),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, If),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, InstanceNormalization),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, LRN),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, LSTM),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, LeakyRelu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Less),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Log),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, LogSoftmax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Loop),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, LpNormalization),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, LpPool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, MatMul),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Max),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, MaxPool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, MaxRoiPool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Mean),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Min),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Mul),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Neg),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Not),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Or),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, PRelu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Pad),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Pow),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, RNN),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, RandomNormal),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, RandomNormalLike),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, RandomUniform),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, RandomUniformLike),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Reciprocal),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ReduceL1),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ReduceL2),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ReduceLogSum),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ReduceLogSumExp),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ReduceMax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ReduceMean),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ReduceMin),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ReduceProd),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ReduceSum),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, ReduceSumSquare),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Relu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Reshape),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Selu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Shape),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Sigmoid),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Size),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Slice),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Softmax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Softplus),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Softsign),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, SpaceToDepth),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Split),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Sqrt),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Squeeze),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Sub),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Sum),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Tanh),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Tile),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, TopK),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Transpose),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Unsqueeze),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Upsample),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 1, Xor),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
@@ -234,11 +225,19 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 2, Split);
 class OpSet_Onnx_ver2 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 2, GlobalLpPool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 2, LpPool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 2, Pad)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 2, Split)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 2, GlobalLpPool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 2, LpPool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 2, Pad),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 2, Split),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
@@ -249,7 +248,16 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 3, GRU);
 class OpSet_Onnx_ver3 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 3, GRU)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 3, GRU),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
@@ -260,7 +268,16 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 4, Concat);
 class OpSet_Onnx_ver4 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 4, Concat)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 4, Concat),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
@@ -271,7 +288,16 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 5, Reshape);
 class OpSet_Onnx_ver5 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 5, Reshape)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 5, Reshape),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
@@ -312,40 +338,46 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Tile);
 class OpSet_Onnx_ver6 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Abs)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Add)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 6, BatchNormalization)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Cast)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Ceil)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Clip)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Div)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Dropout)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Elu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Exp)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Floor)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Gemm)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 6, HardSigmoid)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 6, InstanceNormalization)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, LeakyRelu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Log)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Max)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Mean)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Min)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Mul)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Neg)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, PRelu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Reciprocal)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Relu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Selu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Sigmoid)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Sqrt)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Sub)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Sum)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Tanh)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 6, Tile)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Abs),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Add),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, BatchNormalization),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Cast),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Ceil),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Clip),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Div),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Dropout),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Elu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Exp),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Floor),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Gemm),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, HardSigmoid),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, InstanceNormalization),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, LeakyRelu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Log),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Max),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Mean),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Min),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Mul),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Neg),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, PRelu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Reciprocal),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Relu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Selu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Sigmoid),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Sqrt),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Sub),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Sum),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Tanh),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 6, Tile),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
@@ -382,36 +414,42 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, PRelu);
 class OpSet_Onnx_ver7 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Acos)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Add)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, And)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Asin)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Atan)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 7, AveragePool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 7, BatchNormalization)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Cos)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Div)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Dropout)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Equal)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Gemm)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Greater)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, GRU)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Less)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, LSTM)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Mul)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Or)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Pow)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, RNN)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Sin)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Sub)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Tan)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Upsample)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 7, Multinomial)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, Xor)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 7, PRelu)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Acos),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Add),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, And),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Asin),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Atan),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, AveragePool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, BatchNormalization),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Cos),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Div),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Dropout),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Equal),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Gemm),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Greater),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, GRU),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Less),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, LSTM),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Mul),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Or),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Pow),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, RNN),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Sin),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Sub),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Tan),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Upsample),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Multinomial),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, Xor),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 7, PRelu),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
@@ -428,13 +466,22 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 8, Scan);
 class OpSet_Onnx_ver8 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 8, Expand)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 8, Min)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 8, Max)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 8, Sum)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 8, Mean)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 8, MaxPool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 8, Scan)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 8, Expand),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 8, Min),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 8, Max),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 8, Sum),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 8, Mean),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 8, MaxPool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 8, Scan),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
@@ -474,41 +521,46 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, MeanVarianceNormalization);
 class OpSet_Onnx_ver9 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 9, BatchNormalization)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Compress)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 9, ConstantOfShape)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, EyeLike)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Greater)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Less)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Upsample)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, MaxUnpool)>());
-    // Add more types' support to Constant/MatMul/PRelu/Gemm/Flatten op.
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Constant)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, MatMul)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, OneHot)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, PRelu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Gemm)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Flatten)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Scatter)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Sinh)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Cosh)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Asinh)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Acosh)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Atanh)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Shrink)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, IsNaN)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Sign)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Scan)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Erf)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Cast)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, Where)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 9, NonZero)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 9, TfIdfVectorizer)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 9, MeanVarianceNormalization)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, BatchNormalization),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Compress),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, ConstantOfShape),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, EyeLike),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Greater),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Less),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Upsample),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, MaxUnpool),
+        // Add more types' support to Constant/MatMul/PRelu/Gemm/Flatten op.
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Constant),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, MatMul),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, OneHot),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, PRelu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Gemm),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Flatten),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Scatter),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Sinh),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Cosh),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Asinh),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Acosh),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Atanh),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Shrink),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, IsNaN),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Sign),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Scan),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Erf),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Cast),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, Where),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, NonZero),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, TfIdfVectorizer),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 9, MeanVarianceNormalization),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
@@ -538,38 +590,35 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 10, RoiAlign);
 class OpSet_Onnx_ver10 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 10, Upsample)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 10, Resize)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 10, StringNormalizer)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 10, TopK)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 10, MaxPool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 10, Mod)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 10, AveragePool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 10, Slice)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 10, ThresholdedRelu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 10, Dropout)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 10, MatMulInteger)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 10, QLinearMatMul)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 10, ConvInteger)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 10, QLinearConv)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 10, QuantizeLinear)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 10, DequantizeLinear)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 10, IsInf)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 10, NonMaxSuppression)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 10, ReverseSequence)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 10, RoiAlign)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, Upsample),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, Resize),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, StringNormalizer),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, TopK),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, MaxPool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, Mod),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, AveragePool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, Slice),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, ThresholdedRelu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, Dropout),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, MatMulInteger),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, QLinearMatMul),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, ConvInteger),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, QLinearConv),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, QuantizeLinear),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, DequantizeLinear),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, IsInf),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, NonMaxSuppression),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, ReverseSequence),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 10, RoiAlign),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
@@ -641,72 +690,77 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, NonMaxSuppression);
 class OpSet_Onnx_ver11 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Loop)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, BitShift)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Unique)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, CumSum)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Round)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, TopK)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 11, DepthToSpace)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Equal)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Constant)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 11, DynamicQuantizeLinear)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 11, GatherElements)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 11, ScatterElements)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Scatter)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Clip)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Resize)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Range)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Det)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ScatterND)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, GatherND)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Gather)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, OneHot)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Slice)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Squeeze)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Unsqueeze)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Flatten)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ArgMin)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ArgMax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ReduceL1)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ReduceL2)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ReduceLogSum)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ReduceLogSumExp)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ReduceMax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ReduceMean)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ReduceMin)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ReduceProd)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ReduceSum)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ReduceSumSquare)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Compress)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Concat)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Hardmax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, LogSoftmax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Softmax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Scan)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Split)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, AveragePool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, MaxPool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, MaxUnpool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, LpPool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Conv)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ConvTranspose)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, SequenceEmpty)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, SequenceConstruct)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, SequenceInsert)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, SequenceAt)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, SequenceErase)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, SequenceLength)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, SplitToSequence)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, ConcatFromSequence)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Pad)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, Gemm)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, If)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 11, NonMaxSuppression)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Loop),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, BitShift),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Unique),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, CumSum),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Round),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, TopK),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, DepthToSpace),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Equal),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Constant),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, DynamicQuantizeLinear),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, GatherElements),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ScatterElements),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Scatter),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Clip),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Resize),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Range),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Det),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ScatterND),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, GatherND),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Gather),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, OneHot),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Slice),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Squeeze),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Unsqueeze),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Flatten),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ArgMin),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ArgMax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ReduceL1),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ReduceL2),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ReduceLogSum),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ReduceLogSumExp),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ReduceMax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ReduceMean),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ReduceMin),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ReduceProd),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ReduceSum),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ReduceSumSquare),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Compress),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Concat),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Hardmax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, LogSoftmax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Softmax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Scan),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Split),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, AveragePool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, MaxPool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, MaxUnpool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, LpPool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Conv),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ConvTranspose),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, SequenceEmpty),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, SequenceConstruct),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, SequenceInsert),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, SequenceAt),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, SequenceErase),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, SequenceLength),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, SplitToSequence),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, ConcatFromSequence),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Pad),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, Gemm),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, If),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 11, NonMaxSuppression),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
@@ -734,28 +788,33 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, Pow);
 class OpSet_Onnx_ver12 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, ArgMax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, ArgMin)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, Clip)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, Einsum)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, MaxPool)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, ReduceMax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, ReduceMin)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, GatherND)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 12, NegativeLogLikelihoodLoss)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, Dropout)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, Constant)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, Celu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, Max)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, Min)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 12, LessOrEqual)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 12, GreaterOrEqual)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           Onnx, 12, SoftmaxCrossEntropyLoss)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 12, Pow)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, ArgMax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, ArgMin),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, Clip),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, Einsum),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, MaxPool),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, ReduceMax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, ReduceMin),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, GatherND),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, NegativeLogLikelihoodLoss),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, Dropout),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, Constant),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, Celu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, Max),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, Min),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, LessOrEqual),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, GreaterOrEqual),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, SoftmaxCrossEntropyLoss),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 12, Pow),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 // Forward declarations for ai.onnx version 13
@@ -842,88 +901,114 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, DequantizeLinear);
 class OpSet_Onnx_ver13 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Constant)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Greater)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Less)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Equal)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Add)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Sub)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Mul)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Div)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Softmax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, LogSoftmax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Hardmax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Mod)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Neg)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Abs)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Reciprocal)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Floor)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Ceil)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Sqrt)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Relu)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Exp)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Log)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Tanh)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Pow)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Sigmoid)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Max)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Min)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Sum)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Mean)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Clip)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Gemm)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, MatMul)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Expand)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Sign)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Erf)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, SoftmaxCrossEntropyLoss)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Dropout)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Flatten)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, LRN)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, MeanVarianceNormalization)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ReduceMax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ReduceMin)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ReduceSum)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ReduceSumSquare)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ReduceMean)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ReduceProd)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ReduceLogSum)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ReduceLogSumExp)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ReduceL1)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ReduceL2)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ArgMax)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ArgMin)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Cast)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Reshape)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Shape)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Size)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Concat)>());
-
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Split)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Slice)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Transpose)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Scatter)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ScatterND)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, ScatterElements)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Gather)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, GatherElements)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Squeeze)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Unsqueeze)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, SpaceToDepth)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, DepthToSpace)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Tile)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Upsample)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Resize)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Identity)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, IsNaN)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, NonZero)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, GatherND)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, Pad)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, QuantizeLinear)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(Onnx, 13, DequantizeLinear)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Constant),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Greater),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Less),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Equal),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Add),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Sub),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Mul),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Div),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Softmax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, LogSoftmax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Hardmax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Mod),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Neg),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Abs),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Reciprocal),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Floor),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Ceil),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Sqrt),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Relu),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Exp),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Log),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Tanh),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Pow),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Sigmoid),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Max),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Min),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Sum),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Mean),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Clip),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Gemm),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, MatMul),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Expand),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Sign),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Erf),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, SoftmaxCrossEntropyLoss),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Dropout),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Flatten),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, LRN),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, MeanVarianceNormalization),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ReduceMax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ReduceMin),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ReduceSum),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ReduceSumSquare),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ReduceMean),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ReduceProd),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ReduceLogSum),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ReduceLogSumExp),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ReduceL1),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ReduceL2),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ArgMax),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ArgMin),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Cast),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Reshape),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Shape),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Size),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Concat),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Split),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Slice),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Transpose),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Scatter),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ScatterND),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, ScatterElements),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Gather),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, GatherElements),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Squeeze),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Unsqueeze),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, SpaceToDepth),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, DepthToSpace),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Tile),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Upsample),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Resize),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Identity),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, IsNaN),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, NonZero),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, GatherND),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, Pad),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, QuantizeLinear),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(Onnx, 13, DequantizeLinear),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
+// The schema tables of the ai.onnx operator sets.
+inline std::vector<OpSchemaTable> OnnxOperatorSetSchemaTables() {
+  return {
+      OpSet_Onnx_ver1::Schemas(),
+      OpSet_Onnx_ver2::Schemas(),
+      OpSet_Onnx_ver3::Schemas(),
+      OpSet_Onnx_ver4::Schemas(),
+      OpSet_Onnx_ver5::Schemas(),
+      OpSet_Onnx_ver6::Schemas(),
+      OpSet_Onnx_ver7::Schemas(),
+      OpSet_Onnx_ver8::Schemas(),
+      OpSet_Onnx_ver9::Schemas(),
+      OpSet_Onnx_ver10::Schemas(),
+      OpSet_Onnx_ver11::Schemas(),
+      OpSet_Onnx_ver12::Schemas(),
+      OpSet_Onnx_ver13::Schemas()};
+}
+
 inline void RegisterOnnxOperatorSetSchema() {
   RegisterOpSetSchema<OpSet_Onnx_ver1>();
   RegisterOpSetSchema<OpSet_Onnx_ver2>();
@@ -33,38 +33,33 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(OnnxML, 1, ZipMap);
 class OpSet_OnnxML_ver1 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, ArrayFeatureExtractor)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, Binarizer)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(OnnxML, 1, CastMap)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, CategoryMapper)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, DictVectorizer)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, FeatureVectorizer)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(OnnxML, 1, Imputer)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, LabelEncoder)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, LinearClassifier)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, LinearRegressor)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, Normalizer)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, OneHotEncoder)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, SVMClassifier)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, SVMRegressor)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(OnnxML, 1, Scaler)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, TreeEnsembleClassifier)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(
-           OnnxML, 1, TreeEnsembleRegressor)>());
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(OnnxML, 1, ZipMap)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, ArrayFeatureExtractor),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, Binarizer),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, CastMap),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, CategoryMapper),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, DictVectorizer),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, FeatureVectorizer),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, Imputer),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, LabelEncoder),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, LinearClassifier),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, LinearRegressor),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, Normalizer),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, OneHotEncoder),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, SVMClassifier),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, SVMRegressor),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, Scaler),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, TreeEnsembleClassifier),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, TreeEnsembleRegressor),
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 1, ZipMap),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
@@ -73,10 +68,24 @@ class ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(OnnxML, 2, LabelEncoder);
 class OpSet_OnnxML_ver2 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(OnnxML, 2, LabelEncoder)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxML, 2, LabelEncoder),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
+// The schema tables of the ai.onnx.ml operator sets.
+inline std::vector<OpSchemaTable> OnnxMLOperatorSetSchemaTables() {
+  return {OpSet_OnnxML_ver1::Schemas(), OpSet_OnnxML_ver2::Schemas()};
+}
+
 inline void RegisterOnnxMLOperatorSetSchema() {
   RegisterOpSetSchema<OpSet_OnnxML_ver1>();
   RegisterOpSetSchema<OpSet_OnnxML_ver2>();
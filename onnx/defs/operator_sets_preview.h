@@ -19,14 +19,28 @@ class ONNX_PREVIEW_OPERATOR_SET_SCHEMA_CLASS_NAME(1, Adam);
 class OpSet_OnnxPreview_ver1 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> fn) {
-    fn(GetOpSchema<ONNX_PREVIEW_OPERATOR_SET_SCHEMA_CLASS_NAME(1, Gradient)>());
-    fn(GetOpSchema<ONNX_PREVIEW_OPERATOR_SET_SCHEMA_CLASS_NAME(1, GraphCall)>());
-    fn(GetOpSchema<ONNX_PREVIEW_OPERATOR_SET_SCHEMA_CLASS_NAME(1, Momentum)>());
-    fn(GetOpSchema<ONNX_PREVIEW_OPERATOR_SET_SCHEMA_CLASS_NAME(1, Adagrad)>());
-    fn(GetOpSchema<ONNX_PREVIEW_OPERATOR_SET_SCHEMA_CLASS_NAME(1, Adam)>());
+    for (const auto& entry : Schemas()) {
+      fn(entry.create());
+    }
+  }
+
+  static OpSchemaTable Schemas() {
+    static const OpSchemaEntry schemas[] = {
+        ONNX_PREVIEW_OPERATOR_SET_SCHEMA_ENTRY(1, Gradient),
+        ONNX_PREVIEW_OPERATOR_SET_SCHEMA_ENTRY(1, GraphCall),
+        ONNX_PREVIEW_OPERATOR_SET_SCHEMA_ENTRY(1, Momentum),
+        ONNX_PREVIEW_OPERATOR_SET_SCHEMA_ENTRY(1, Adagrad),
+        ONNX_PREVIEW_OPERATOR_SET_SCHEMA_ENTRY(1, Adam),
+    };
+    return OpSchemaTable(schemas);
   }
 };
 
+// The schema tables of the preview operator sets.
+inline std::vector<OpSchemaTable> OnnxPreviewOperatorSetSchemaTables() {
+  return {OpSet_OnnxPreview_ver1::Schemas()};
+}
+
 // Register preview operators.
 inline void RegisterOnnxPreviewOperatorSetSchema() {
   // Preview operators should have only one version.
@@ -14,8 +14,17 @@ class OpSet_OnnxTraining_ver1 {
  public:
   static void ForEachSchema(std::function<void(OpSchema&&)> /* fn */) {
   }
+
+  static OpSchemaTable Schemas() {
+    return OpSchemaTable();
+  }
 };
 
+// The schema tables of the training operator sets.
+inline std::vector<OpSchemaTable> OnnxTrainingOperatorSetSchemaTables() {
+  return {OpSet_OnnxTraining_ver1::Schemas()};
+}
+
 // Register training operators.
 inline void RegisterOnnxTrainingOperatorSetSchema() {
   RegisterOpSetSchema<OpSet_OnnxTraining_ver1>();
@@ -1,6 +1,7 @@
 // Copyright (c) ONNX Project Contributors.
 // Licensed under the MIT license.
 
+#include "onnx/defs/cost_functions.h"
 #include "onnx/defs/schema.h"
 
 namespace ONNX_NAMESPACE {
@@ -229,7 +230,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "to be 0.",
             "T",
             OpSchema::Optional)
-        .FillUsing(RNNDocGenerator("RNN")));
+        .FillUsing(RNNDocGenerator("RNN"))
+        .CostModelFunction(recurrentCost(1)));
 
 static const char* GRU_ver7_doc = R"DOC(
 Computes an one-layer GRU. This operator is usually supported via some custom
@@ -350,7 +352,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "- assumed to be 0",
             "T",
             OpSchema::Optional)
-        .FillUsing(RNNDocGenerator("GRU")));
+        .FillUsing(RNNDocGenerator("GRU"))
+        .CostModelFunction(recurrentCost(3)));
 
 static const char* LSTM_ver7_doc = R"DOC(
 Computes an one-layer LSTM. This operator is usually supported via some
@@ -500,5 +503,6 @@ ONNX_OPERATOR_SET_SCHEMA(
             "The last output value of the cell. It has shape "
             "`[num_directions, batch_size, hidden_size]`.",
             "T",
-            OpSchema::Optional));
+            OpSchema::Optional)
+        .CostModelFunction(recurrentCost(4)));
 } // namespace ONNX_NAMESPACE
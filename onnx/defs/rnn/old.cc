@@ -1,3 +1,4 @@
+#include "onnx/defs/cost_functions.h"
 #include "onnx/defs/schema.h"
 
 namespace ONNX_NAMESPACE {
@@ -195,7 +196,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "- assumed to be 0",
             "T",
             OpSchema::Optional)
-        .FillUsing(RNNDocGeneratorOld("GRU")));
+        .FillUsing(RNNDocGeneratorOld("GRU"))
+        .CostModelFunction(recurrentCost(3)));
 
 // Versions 1 to 6 of RNN/LSTM and versions 3 to 6 of GRU:
 
@@ -438,7 +440,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "to be 0.",
             "T",
             OpSchema::Optional)
-        .FillUsing(RNNDocGenerator1("RNN")));
+        .FillUsing(RNNDocGenerator1("RNN"))
+        .CostModelFunction(recurrentCost(1)));
 
 static const char* GRU_ver3_doc = R"DOC(
 Computes an one-layer GRU. This operator is usually supported via some custom
@@ -558,7 +561,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "- assumed to be 0",
             "T",
             OpSchema::Optional)
-        .FillUsing(RNNDocGenerator1("GRU")));
+        .FillUsing(RNNDocGenerator1("GRU"))
+        .CostModelFunction(recurrentCost(3)));
 
 static const char* LSTM_ver1_doc = R"DOC(
 Computes an one-layer LSTM. This operator is usually supported via some
@@ -707,6 +711,7 @@ ONNX_OPERATOR_SET_SCHEMA(
             "The last output value of the cell. It has shape "
             "`[num_directions, batch_size, hidden_size]`.",
             "T",
-            OpSchema::Optional));
+            OpSchema::Optional)
+        .CostModelFunction(recurrentCost(4)));
 
 } // namespace ONNX_NAMESPACE
@@ -2,6 +2,10 @@
 // Licensed under the MIT license.
 
 #include "onnx/defs/schema.h"
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <sstream>
 #include <stdexcept>
 #include <unordered_set>
 #include "onnx/checker.h"
@@ -22,6 +26,13 @@ void RegisterSchema(OpSchema&& schema) {
   OpSchemaRegistry::OpSchemaRegisterOnce ONNX_UNUSED registration = schema;
 }
 
+void DeregisterSchema(
+    const std::string& op_type,
+    int version,
+    const std::string& domain) {
+  OpSchemaRegistry::OpSchemaDeregister(op_type, version, domain);
+}
+
 #ifndef NDEBUG
 DbgOperatorSetTracker& DbgOperatorSetTracker::Instance() {
   static DbgOperatorSetTracker instance;
@@ -411,6 +422,17 @@ OpSchema& OpSchema::TypeAndShapeInferenceFunction(
   return *this;
 }
 
+OpSchema& OpSchema::PartialDataPropagationFunction(
+    DataPropagationFunction dataPropagationFunction) {
+  data_propagation_function_ = dataPropagationFunction;
+  return *this;
+}
+
+OpSchema& OpSchema::CostModelFunction(CostFunction costFunction) {
+  cost_function_ = costFunction;
+  return *this;
+}
+
 OpSchema& OpSchema::SetSupportLevel(SupportType support) {
   support_ = support;
   return *this;
@@ -918,69 +940,801 @@ OpSchemaRegistry::DomainToVersionRange::Instance() {
   return domain_to_version_range;
 };
 
-// Private method used by OpSchemaRegisterOnce and OpSchemaRegistry::map()
-OpName_Domain_Version_Schema_Map&
-OpSchemaRegistry::GetMapWithoutEnsuringRegistration() {
-  static OpName_Domain_Version_Schema_Map map;
-  return map;
+// Private method used by OpSchemaRegisterOnce and the schema index
+std::deque<OpSchema>& OpSchemaRegistry::GetSchemaStorage() {
+  static std::deque<OpSchema> schemas;
+  return schemas;
 }
 
-OpName_Domain_Version_Schema_Map& OpSchemaRegistry::map() {
-  auto& map = GetMapWithoutEnsuringRegistration();
+namespace {
 
-  // The following class is used to register operators the
-  // first time this method is called, in a thread-safe fashion.
-  class SchemasRegisterer {
-   public:
-    SchemasRegisterer() {
-      // In debug builds, the number of schema registered in this constructor
-      // is compared against the number of calls to schema registration macros.
-#ifndef NDEBUG
-      size_t dbg_initial_schema_count = GetRegisteredSchemaCount();
-#endif
+// The domains defined by ONNX, as numbered by BuiltinDomainIndex. Other
+// domains are numbered kNumBuiltinDomains.
+enum BuiltinDomain {
+  kOnnxDomain,
+  kOnnxMLDomain,
+  kOnnxTrainingDomain,
+  kOnnxPreviewTrainingDomain,
+  kNumBuiltinDomains
+};
 
-      RegisterOnnxOperatorSetSchema();
+int BuiltinDomainIndex(const std::string& domain) {
+  if (domain.empty()) {
+    return kOnnxDomain;
+  } else if (domain == AI_ONNX_ML_DOMAIN) {
+    return kOnnxMLDomain;
+  } else if (domain == AI_ONNX_TRAINING_DOMAIN) {
+    return kOnnxTrainingDomain;
+  } else if (domain == AI_ONNX_PREVIEW_TRAINING_DOMAIN) {
+    return kOnnxPreviewTrainingDomain;
+  }
+  return kNumBuiltinDomains;
+}
 
+#ifndef __ONNX_DISABLE_STATIC_REGISTRATION
+std::vector<OpSchemaTable> BuiltinDomainSchemaTables(int domain) {
+  switch (domain) {
+    case kOnnxDomain:
+      return OnnxOperatorSetSchemaTables();
 #ifdef ONNX_ML
-      RegisterOnnxMLOperatorSetSchema();
+    case kOnnxMLDomain:
+      return OnnxMLOperatorSetSchemaTables();
+#endif
+    case kOnnxTrainingDomain:
+      return OnnxTrainingOperatorSetSchemaTables();
+    case kOnnxPreviewTrainingDomain:
+      return OnnxPreviewOperatorSetSchemaTables();
+  }
+  return {};
+}
 #endif
 
-      // Invoke register of training operators.
-      RegisterOnnxTrainingOperatorSetSchema();
+} // namespace
 
-      // Invoke register of experimental operators.
-      RegisterOnnxPreviewOperatorSetSchema();
+void OpSchemaRegistry::IndexAllDomains() {
+  // The following class is used to index the schema tables of the domains not
+  // looked up yet the first time this method is called, in a thread-safe
+  // fashion.
+  class DomainsIndexer {
+   public:
+    DomainsIndexer() {
+      for (const char* domain :
+           {ONNX_DOMAIN,
+            AI_ONNX_ML_DOMAIN,
+            AI_ONNX_TRAINING_DOMAIN,
+            AI_ONNX_PREVIEW_TRAINING_DOMAIN}) {
+        index(domain);
+      }
 
+      // In debug builds, the number of entries of the schema tables is
+      // compared against the number of calls to schema registration macros.
 #ifndef NDEBUG
-      size_t dbg_registered_schema_count =
-          GetRegisteredSchemaCount() - dbg_initial_schema_count;
-
       ONNX_ASSERTM(
-          dbg_registered_schema_count == ONNX_DBG_GET_COUNT_IN_OPSETS(),
+          DbgBuiltinSchemaCount() == ONNX_DBG_GET_COUNT_IN_OPSETS(),
           "%u schema were exposed from operator sets and automatically placed into the static registry.  "
           "%u were expected based on calls to registration macros. Operator set functions may need to be updated.",
-          dbg_registered_schema_count,
+          DbgBuiltinSchemaCount(),
           ONNX_DBG_GET_COUNT_IN_OPSETS());
 #endif
     }
+  };
+
+#ifndef __ONNX_DISABLE_STATIC_REGISTRATION
+  static DomainsIndexer domainsIndexer;
+#endif
+}
 
-   private:
-    static size_t GetRegisteredSchemaCount() {
-      size_t count = 0;
-      for (auto& x : GetMapWithoutEnsuringRegistration()) {
-        for (auto& y : x.second) {
-          count += y.second.size();
+const std::vector<OpSchema> OpSchemaRegistry::get_all_schemas_with_history() {
+  IndexAllDomains();
+  std::vector<OpSchema> r;
+  for (int i = 0; i <= kNumBuiltinDomains; ++i) {
+    GetIndexes()[i].ForEachSchema(
+        false, [&r](const OpSchema& schema) { r.emplace_back(schema); });
+  }
+  return r;
+}
+
+const std::vector<OpSchema> OpSchemaRegistry::get_all_schemas() {
+  IndexAllDomains();
+  std::vector<OpSchema> r;
+  for (int i = 0; i <= kNumBuiltinDomains; ++i) {
+    GetIndexes()[i].ForEachSchema(
+        true, [&r](const OpSchema& schema) { r.emplace_back(schema); });
+  }
+  return r;
+}
+
+void OpSchemaRegistry::OpSchemaDeregister(
+    const std::string& op_type,
+    int version,
+    const std::string& domain) {
+  // Indexes the schema tables of the domain first, so that they do not add
+  // the schema back later.
+  index(domain);
+  std::lock_guard<std::mutex> lock(GetRegistrationMutex());
+  if (!GetIndexWithoutEnsuringRegistration(domain).Remove(
+          op_type, version, domain)) {
+    std::stringstream err;
+    err << "Trying to deregister schema with name " << op_type
+        << " (domain: " << domain << " version: " << version
+        << "), but it is not registered." << std::endl;
+    fail_schema(err.str());
+  }
+  Generation().fetch_add(1, std::memory_order_release);
+}
+
+std::mutex& OpSchemaRegistry::GetRegistrationMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::atomic<size_t>& OpSchemaRegistry::Generation() {
+  static std::atomic<size_t> generation(0);
+  return generation;
+}
+
+const OpSchema* OpSchemaRegistry::Insert(OpSchema& op_schema) {
+  op_schema.Finalize();
+
+  auto& op_name = op_schema.Name();
+  auto& op_domain = op_schema.domain();
+  auto ver = op_schema.SinceVersion();
+
+  const auto& ver_range_map = DomainToVersionRange::Instance().Map();
+  auto ver_range_it = ver_range_map.find(op_domain);
+  if (ver_range_it == ver_range_map.end()) {
+    std::stringstream err;
+    err << "Trying to register schema with name " << op_name
+        << " (domain: " << op_domain << " version: " << ver << ") from file "
+        << op_schema.file() << " line " << op_schema.line()
+        << ", but it its domain is not"
+        << " known by the checker." << std::endl;
+
+    fail_schema(err.str());
+  }
+  auto lower_bound_incl = ver_range_it->second.first;
+  auto upper_bound_incl = ver_range_it->second.second;
+  if (!(lower_bound_incl <= ver && upper_bound_incl >= ver)) {
+    std::stringstream err;
+    err << "Trying to register schema with name " << op_name
+        << " (domain: " << op_domain << " version: " << ver << ") from file "
+        << op_schema.file() << " line " << op_schema.line()
+        << ", but it its version is not "
+        << "in the inclusive range [" << lower_bound_incl << ", "
+        << upper_bound_incl << "] (usually, this means you "
+        << "bumped the operator version but "
+        << "forgot to update the version range in DomainToVersionRange "
+        << "in onnx/defs/schema.h)." << std::endl;
+    fail_schema(err.str());
+  }
+
+  auto& schemas = GetSchemaStorage();
+  schemas.push_back(std::move(op_schema));
+  return &schemas.back();
+}
+
+OpSchemaRegistry::SchemaIndex* OpSchemaRegistry::GetIndexes() {
+  static SchemaIndex indexes[kNumBuiltinDomains + 1];
+  return indexes;
+}
+
+OpSchemaRegistry::SchemaIndex&
+OpSchemaRegistry::GetIndexWithoutEnsuringRegistration(
+    const std::string& domain) {
+  return GetIndexes()[BuiltinDomainIndex(domain)];
+}
+
+const OpSchemaRegistry::SchemaIndex& OpSchemaRegistry::index(
+    const std::string& domain) {
+#ifndef __ONNX_DISABLE_STATIC_REGISTRATION
+  // The schema tables of each domain are indexed on its first lookup, in a
+  // thread-safe fashion. With ONNX_LAZY_SCHEMAS, no schema is constructed
+  // yet; otherwise all the schemas of the domain are constructed then.
+  class DomainIndexer {
+   public:
+    DomainIndexer(int domain, const std::string& name) {
+      SchemaIndex& index = GetIndexWithoutEnsuringRegistration(name);
+      {
+        std::lock_guard<std::mutex> lock(GetRegistrationMutex());
+        auto tables = BuiltinDomainSchemaTables(domain);
+        index.Add(tables, name);
+#ifndef NDEBUG
+        for (const auto& table : tables) {
+          DbgBuiltinSchemaCount() += table.size();
         }
+#endif
       }
-      return count;
+#ifndef ONNX_LAZY_SCHEMAS
+      index.ForEachSchema(false, [](const OpSchema&) {});
+#endif
     }
   };
 
-#ifndef __ONNX_DISABLE_STATIC_REGISTRATION
-  static SchemasRegisterer schemasRegisterer;
+  switch (BuiltinDomainIndex(domain)) {
+    case kOnnxDomain: {
+      static DomainIndexer indexer(kOnnxDomain, ONNX_DOMAIN);
+      break;
+    }
+    case kOnnxMLDomain: {
+      static DomainIndexer indexer(kOnnxMLDomain, AI_ONNX_ML_DOMAIN);
+      break;
+    }
+    case kOnnxTrainingDomain: {
+      static DomainIndexer indexer(
+          kOnnxTrainingDomain, AI_ONNX_TRAINING_DOMAIN);
+      break;
+    }
+    case kOnnxPreviewTrainingDomain: {
+      static DomainIndexer indexer(
+          kOnnxPreviewTrainingDomain, AI_ONNX_PREVIEW_TRAINING_DOMAIN);
+      break;
+    }
+  }
+#endif
+  return GetIndexWithoutEnsuringRegistration(domain);
+}
+
+#ifndef NDEBUG
+size_t& OpSchemaRegistry::DbgBuiltinSchemaCount() {
+  static size_t count = 0;
+  return count;
+}
 #endif
 
-  return map;
+namespace {
+
+// Epochs of the SchemaIndex lookups, for freeing what writers replace. Each
+// thread reading an index announces the epoch it started in, and writers tag
+// what they replace with the epoch they replaced it in.
+std::atomic<uint64_t>& GlobalEpoch() {
+  static std::atomic<uint64_t> epoch(1);
+  return epoch;
+}
+
+struct ReaderRecord {
+  // The epoch the thread started reading in, or 0 if it is not reading.
+  std::atomic<uint64_t> epoch{0};
+  std::atomic<bool> in_use{true};
+  ReaderRecord* next = nullptr;
+};
+
+// Records are never freed: a thread exiting leaves its record to the next
+// thread starting.
+std::atomic<ReaderRecord*>& ReaderRecords() {
+  static std::atomic<ReaderRecord*> head(nullptr);
+  return head;
+}
+
+struct ThreadReader {
+  ThreadReader() {
+    auto& head = ReaderRecords();
+    for (record = head.load(std::memory_order_acquire); record != nullptr;
+         record = record->next) {
+      bool in_use = false;
+      if (record->in_use.compare_exchange_strong(in_use, true)) {
+        return;
+      }
+    }
+    record = new ReaderRecord();
+    record->next = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(
+        record->next,
+        record,
+        std::memory_order_release,
+        std::memory_order_relaxed)) {
+    }
+  }
+
+  ~ThreadReader() {
+    record->in_use.store(false, std::memory_order_release);
+  }
+
+  ReaderRecord* record;
+  // Nesting of the ReadGuards of this thread.
+  int depth = 0;
+};
+
+ThreadReader& CurrentReader() {
+  static thread_local ThreadReader reader;
+  return reader;
+}
+
+// The oldest epoch a thread is reading in, or the maximum if none is. Things
+// replaced before the call and tagged with an older epoch are unreachable.
+uint64_t OldestReaderEpoch() {
+  // Pairs with the fence of ReadGuard: a reader not seen here yet reads
+  // what was published before.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  uint64_t oldest = std::numeric_limits<uint64_t>::max();
+  for (const ReaderRecord* record =
+           ReaderRecords().load(std::memory_order_acquire);
+       record != nullptr;
+       record = record->next) {
+    const uint64_t epoch = record->epoch.load(std::memory_order_acquire);
+    if (epoch != 0) {
+      oldest = std::min(oldest, epoch);
+    }
+  }
+  return oldest;
+}
+
+template <typename T>
+void FreeRetired(
+    std::vector<std::pair<uint64_t, std::unique_ptr<T>>>& retired,
+    uint64_t oldest_reader_epoch) {
+  retired.erase(
+      std::remove_if(
+          retired.begin(),
+          retired.end(),
+          [oldest_reader_epoch](
+              const std::pair<uint64_t, std::unique_ptr<T>>& entry) {
+            return entry.first < oldest_reader_epoch;
+          }),
+      retired.end());
+}
+
+} // namespace
+
+OpSchemaRegistry::SchemaIndex::ReadGuard::ReadGuard() {
+  ThreadReader& reader = CurrentReader();
+  if (reader.depth++ == 0) {
+    reader.record->epoch.store(
+        GlobalEpoch().load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+OpSchemaRegistry::SchemaIndex::ReadGuard::~ReadGuard() {
+  ThreadReader& reader = CurrentReader();
+  if (--reader.depth == 0) {
+    reader.record->epoch.store(0, std::memory_order_release);
+  }
+}
+
+OpSchemaRegistry::SchemaIndex::SchemaIndex() {
+  table_.store(new Table(16), std::memory_order_release);
+}
+
+OpSchemaRegistry::SchemaIndex::~SchemaIndex() {
+  for (const auto& node : nodes_) {
+    delete node.versions.load(std::memory_order_relaxed);
+  }
+  delete table_.load(std::memory_order_relaxed);
+}
+
+void OpSchemaRegistry::SchemaIndex::Reclaim() {
+  const uint64_t oldest = OldestReaderEpoch();
+  FreeRetired(retired_versions_, oldest);
+  FreeRetired(retired_tables_, oldest);
+}
+
+size_t OpSchemaRegistry::SchemaIndex::KeyHash::operator()(
+    const Key& key) const {
+  size_t seed = std::hash<std::string>()(*key.op_type);
+  return seed ^
+      (std::hash<std::string>()(*key.domain) + 0x9e3779b9 + (seed << 6) +
+       (seed >> 2));
+}
+
+OpSchemaRegistry::SchemaIndex::Node* OpSchemaRegistry::SchemaIndex::FindNode(
+    const Key& key) const {
+  const Table* table = table_.load(std::memory_order_acquire);
+  const size_t mask = table->nodes.size() - 1;
+  // Ends on an empty entry, as at most half of them are used.
+  for (size_t i = KeyHash()(key) & mask;; i = (i + 1) & mask) {
+    Node* node = table->nodes[i].load(std::memory_order_acquire);
+    if (node == nullptr || KeyEqual()(node->key, key)) {
+      return node;
+    }
+  }
+}
+
+void OpSchemaRegistry::SchemaIndex::InsertNode(Table& table, Node* node) {
+  const size_t mask = table.nodes.size() - 1;
+  size_t i = KeyHash()(node->key) & mask;
+  while (table.nodes[i].load(std::memory_order_relaxed) != nullptr) {
+    i = (i + 1) & mask;
+  }
+  table.nodes[i].store(node, std::memory_order_release);
+}
+
+OpSchemaRegistry::SchemaIndex::Node*
+OpSchemaRegistry::SchemaIndex::GetOrAddNode(const Key& key) {
+  Node* node = FindNode(key);
+  if (node != nullptr) {
+    return node;
+  }
+  names_.push_back(*key.op_type);
+  const std::string* op_type = &names_.back();
+  names_.push_back(*key.domain);
+  nodes_.emplace_back(Key{op_type, &names_.back()});
+  node = &nodes_.back();
+
+  Table* table = table_.load(std::memory_order_relaxed);
+  if (nodes_.size() * 2 > table->nodes.size()) {
+    // Lookups keep reading the old table until the new one is published.
+    std::unique_ptr<Table> grown(new Table(table->nodes.size() * 2));
+    for (auto& added : nodes_) {
+      InsertNode(*grown, &added);
+    }
+    table_.store(grown.release(), std::memory_order_release);
+    retired_tables_.emplace_back(
+        GlobalEpoch().fetch_add(1), std::unique_ptr<const Table>(table));
+    Reclaim();
+  } else {
+    InsertNode(*table, node);
+  }
+  return node;
+}
+
+void OpSchemaRegistry::SchemaIndex::Publish(
+    Node* node,
+    std::unique_ptr<Versions> versions) {
+  const Versions* replaced = node->versions.load(std::memory_order_relaxed);
+  node->versions.store(
+      versions->versions.empty() ? nullptr : versions.release(),
+      std::memory_order_release);
+  if (replaced != nullptr) {
+    retired_versions_.emplace_back(
+        GlobalEpoch().fetch_add(1), std::unique_ptr<const Versions>(replaced));
+    Reclaim();
+  }
+}
+
+void OpSchemaRegistry::SchemaIndex::InsertVersion(
+    Versions& entry,
+    int version,
+    Slot* slot) {
+  auto pos =
+      std::upper_bound(entry.versions.begin(), entry.versions.end(), version);
+  auto offset = pos - entry.versions.begin();
+  entry.versions.insert(pos, version);
+  entry.slots.insert(entry.slots.begin() + offset, slot);
+}
+
+void OpSchemaRegistry::SchemaIndex::Add(const OpSchema* schema) {
+  slots_.emplace_back(schema, nullptr);
+  Add(Key{&schema->Name(), &schema->domain()},
+      schema->SinceVersion(),
+      &slots_.back());
+}
+
+void OpSchemaRegistry::SchemaIndex::Add(
+    const std::vector<OpSchemaTable>& tables,
+    const std::string& domain) {
+  // The entries of each op are gathered first, so that its versions are
+  // published once.
+  std::unordered_map<std::string, Versions> added;
+  for (const auto& table : tables) {
+    for (const auto& entry : table) {
+      const std::string op_type(entry.name);
+      if (Contains(op_type, entry.since_version, domain)) {
+        // Registered before its domain was indexed.
+        continue;
+      }
+      slots_.emplace_back(nullptr, entry.create);
+      InsertVersion(added[op_type], entry.since_version, &slots_.back());
+    }
+  }
+  for (const auto& op : added) {
+    Node* node = GetOrAddNode(Key{&op.first, &domain});
+    const Versions* current = node->versions.load(std::memory_order_relaxed);
+    std::unique_ptr<Versions> versions(
+        current == nullptr ? new Versions(op.second) : new Versions(*current));
+    if (current != nullptr) {
+      for (size_t i = 0; i < op.second.versions.size(); ++i) {
+        InsertVersion(*versions, op.second.versions[i], op.second.slots[i]);
+      }
+    }
+    Publish(node, std::move(versions));
+  }
+}
+
+void OpSchemaRegistry::SchemaIndex::Add(
+    const Key& key,
+    int version,
+    Slot* slot) {
+  Node* node = GetOrAddNode(key);
+  const Versions* current = node->versions.load(std::memory_order_relaxed);
+  std::unique_ptr<Versions> versions(
+      current == nullptr ? new Versions() : new Versions(*current));
+  InsertVersion(*versions, version, slot);
+  Publish(node, std::move(versions));
+}
+
+bool OpSchemaRegistry::SchemaIndex::Remove(
+    const std::string& key,
+    int version,
+    const std::string& domain) {
+  Node* node = FindNode(Key{&key, &domain});
+  const Versions* current = node == nullptr
+      ? nullptr
+      : node->versions.load(std::memory_order_relaxed);
+  if (current == nullptr) {
+    return false;
+  }
+  auto pos = std::lower_bound(
+      current->versions.begin(), current->versions.end(), version);
+  if (pos == current->versions.end() || *pos != version) {
+    return false;
+  }
+  auto offset = pos - current->versions.begin();
+  std::unique_ptr<Versions> versions(new Versions(*current));
+  versions->versions.erase(versions->versions.begin() + offset);
+  versions->slots.erase(versions->slots.begin() + offset);
+  Publish(node, std::move(versions));
+  return true;
+}
+
+const OpSchemaRegistry::SchemaIndex::Versions*
+OpSchemaRegistry::SchemaIndex::Get(
+    const std::string& key,
+    const std::string& domain) const {
+  const Node* node = FindNode(Key{&key, &domain});
+  return node == nullptr ? nullptr
+                         : node->versions.load(std::memory_order_acquire);
+}
+
+const OpSchema* OpSchemaRegistry::SchemaIndex::GetSchema(Slot& slot) {
+  const OpSchema* schema = slot.schema.load(std::memory_order_acquire);
+  if (schema != nullptr) {
+    return schema;
+  }
+  std::lock_guard<std::mutex> lock(GetRegistrationMutex());
+  schema = slot.schema.load(std::memory_order_relaxed);
+  if (schema == nullptr) {
+    try {
+      OpSchema op_schema = slot.create();
+      schema = OpSchemaRegistry::Insert(op_schema);
+      slot.schema.store(schema, std::memory_order_release);
+    } catch (const std::exception& e) {
+      std::cerr << "Schema error: " << e.what() << std::endl;
+    }
+  }
+  return schema;
+}
+
+bool OpSchemaRegistry::SchemaIndex::Contains(
+    const std::string& key,
+    int version,
+    const std::string& domain,
+    const OpSchema** schema) const {
+  ReadGuard guard;
+  const Versions* entry = Get(key, domain);
+  if (entry == nullptr) {
+    return false;
+  }
+  auto pos =
+      std::lower_bound(entry->versions.begin(), entry->versions.end(), version);
+  if (pos == entry->versions.end() || *pos != version) {
+    return false;
+  }
+  if (schema != nullptr) {
+    *schema = entry->slots[pos - entry->versions.begin()]->schema.load(
+        std::memory_order_acquire);
+  }
+  return true;
+}
+
+OpSchemaRegistry::SchemaIndex::Slot* OpSchemaRegistry::SchemaIndex::FindSlot(
+    const Versions& entry,
+    int maxInclusiveVersion) {
+  // Narrows [base, base + n) to the last version not greater than
+  // maxInclusiveVersion, if any, without a data-dependent branch.
+  const std::vector<int>& versions = entry.versions;
+  const int* base = versions.data();
+  size_t n = versions.size();
+  while (n > 1) {
+    size_t half = n / 2;
+    base = base[half] <= maxInclusiveVersion ? base + half : base;
+    n -= half;
+  }
+  if (*base > maxInclusiveVersion) {
+    // All versions are greater than specified version.
+    return nullptr;
+  }
+  return entry.slots[base - versions.data()];
+}
+
+const OpSchema* OpSchemaRegistry::SchemaIndex::Find(
+    const std::string& key,
+    int maxInclusiveVersion,
+    const std::string& domain) const {
+  ReadGuard guard;
+  const Versions* entry = Get(key, domain);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  Slot* slot = FindSlot(*entry, maxInclusiveVersion);
+  return slot == nullptr ? nullptr : GetSchema(*slot);
+}
+
+const OpSchema* OpSchemaRegistry::SchemaIndex::FindLatest(
+    const std::string& key,
+    const std::string& domain) const {
+  ReadGuard guard;
+  const Versions* entry = Get(key, domain);
+  return entry == nullptr ? nullptr : GetSchema(*entry->slots.back());
+}
+
+void OpSchemaRegistry::SchemaIndex::ForEachSchema(
+    bool latest_only,
+    const std::function<void(const OpSchema&)>& fn) const {
+  ForEachNode([&](const Key&, const Versions& entry) {
+    for (size_t i = latest_only ? entry.slots.size() - 1 : 0;
+         i < entry.slots.size();
+         ++i) {
+      const OpSchema* schema = GetSchema(*entry.slots[i]);
+      if (schema != nullptr) {
+        fn(*schema);
+      }
+    }
+  });
+}
+
+namespace {
+
+// Views kept by each thread for lookups without locking.
+const size_t kMaxThreadViews = 8;
+
+} // namespace
+
+std::shared_ptr<const OpsetView> OpsetView::Get(
+    const std::unordered_map<std::string, int>& opset_imports) {
+  const size_t generation =
+      OpSchemaRegistry::Generation().load(std::memory_order_acquire);
+  // The views this thread used last, most recent first. A graph and its
+  // subgraphs, or the next model checked, usually find theirs here.
+  static thread_local std::vector<std::shared_ptr<const OpsetView>> recent;
+  for (auto it = recent.begin(); it != recent.end(); ++it) {
+    if (!(*it)->HasImports(opset_imports)) {
+      continue;
+    }
+    if ((*it)->generation_ == generation) {
+      std::rotate(recent.begin(), it, it + 1);
+      return recent.front();
+    }
+    recent.erase(it);
+    break;
+  }
+  std::shared_ptr<const OpsetView> view = GetShared(opset_imports, generation);
+  recent.insert(recent.begin(), view);
+  if (recent.size() > kMaxThreadViews) {
+    recent.pop_back();
+  }
+  return view;
+}
+
+std::shared_ptr<const OpsetView> OpsetView::GetShared(
+    const std::unordered_map<std::string, int>& opset_imports,
+    size_t generation) {
+  // The imports in a canonical order, as the key of their view.
+  std::vector<std::pair<std::string, int>> sorted_imports(
+      opset_imports.begin(), opset_imports.end());
+  std::sort(sorted_imports.begin(), sorted_imports.end());
+  std::string key;
+  for (const auto& opset_import : sorted_imports) {
+    key += opset_import.first;
+    key += '\0';
+    key += std::to_string(opset_import.second);
+    key += '\0';
+  }
+
+  // Views are only shared while some thread still uses them.
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::weak_ptr<const OpsetView>>
+      views;
+  std::lock_guard<std::mutex> lock(mutex);
+  std::weak_ptr<const OpsetView>& entry = views[key];
+  std::shared_ptr<const OpsetView> view = entry.lock();
+  if (view == nullptr || view->generation_ != generation) {
+    view.reset(new OpsetView(opset_imports));
+    entry = view;
+    for (auto it = views.begin(); it != views.end();) {
+      it = it->second.expired() ? views.erase(it) : std::next(it);
+    }
+  }
+  return view;
+}
+
+bool OpsetView::HasImports(
+    const std::unordered_map<std::string, int>& opset_imports) const {
+  if (opset_imports.size() != domains_.size()) {
+    return false;
+  }
+  for (const auto& opset_import : opset_imports) {
+    auto it = domains_.find(opset_import.first);
+    if (it == domains_.end() || it->second.version != opset_import.second) {
+      return false;
+    }
+  }
+  return true;
+}
+
+OpsetView::OpsetView(
+    const std::unordered_map<std::string, int>& opset_imports)
+    // Read before the indexes: a registration while they are read makes the
+    // view stale.
+    : generation_(
+          OpSchemaRegistry::Generation().load(std::memory_order_acquire)) {
+  for (const auto& opset_import : opset_imports) {
+    const std::string& domain = opset_import.first;
+    DomainSchemas& domain_schemas = domains_[domain];
+    domain_schemas.version = opset_import.second;
+    OpSchemaRegistry::index(domain).ForEachNode(
+        [&](const OpSchemaRegistry::SchemaIndex::Key& key,
+            const OpSchemaRegistry::SchemaIndex::Versions& versions) {
+          if (*key.domain != domain) {
+            return;
+          }
+          Slot* slot = OpSchemaRegistry::SchemaIndex::FindSlot(
+              versions, domain_schemas.version);
+          if (slot != nullptr) {
+            domain_schemas.schemas.emplace(*key.op_type, slot);
+          }
+        });
+  }
+}
+
+const int* OpsetView::GetDomainVersion(const std::string& domain) const {
+  auto it = domains_.find(domain);
+  return it == domains_.end() ? nullptr : &it->second.version;
+}
+
+const OpSchema* OpsetView::GetSchema(
+    const std::string& op_type,
+    const std::string& domain) const {
+  auto dit = domains_.find(domain);
+  if (dit == domains_.end()) {
+    return nullptr;
+  }
+  const auto& schemas = dit->second.schemas;
+  auto it = schemas.find(op_type);
+  return it == schemas.end()
+      ? nullptr
+      : OpSchemaRegistry::SchemaIndex::GetSchema(*it->second);
+}
+
+SchemaResolutionCache::SchemaResolutionCache(
+    const std::unordered_map<std::string, int>& opset_imports,
+    const ISchemaRegistry* schema_registry)
+    : schema_registry_(schema_registry) {
+  for (const auto& opset_import : opset_imports) {
+    domains_[opset_import.first].version = opset_import.second;
+  }
+  if (schema_registry == OpSchemaRegistry::Instance()) {
+    view_ = OpsetView::Get(opset_imports);
+  }
+}
+
+const int* SchemaResolutionCache::GetDomainVersion(
+    const std::string& domain) const {
+  auto it = domains_.find(domain);
+  return it == domains_.end() ? nullptr : &it->second.version;
+}
+
+const OpSchema* SchemaResolutionCache::GetSchema(
+    const std::string& op_type,
+    const std::string& domain) {
+  if (view_ != nullptr) {
+    return view_->GetSchema(op_type, domain);
+  }
+  auto dit = domains_.find(domain);
+  if (dit == domains_.end()) {
+    return nullptr;
+  }
+  DomainSchemas& domain_schemas = dit->second;
+  auto it = domain_schemas.schemas.find(op_type);
+  if (it == domain_schemas.schemas.end()) {
+    it = domain_schemas.schemas
+             .emplace(
+                 op_type,
+                 schema_registry_->GetSchema(
+                     op_type, domain_schemas.version, domain))
+             .first;
+  }
+  return it->second;
 }
 
 size_t ReplaceAll(std::string& s, const char* from, const char* to) {
@@ -3,13 +3,17 @@
 
 #pragma once
 
+#include <atomic>
 #include <climits>
+#include <cstdint>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
@@ -362,6 +366,22 @@ class OpSchema final {
                                       : dummyInferenceFunction;
   }
 
+  // Data propagation computes output values from input values for ops that
+  // take part in shape computations. It is only run when enabled in the
+  // shape inference options.
+  OpSchema& PartialDataPropagationFunction(
+      DataPropagationFunction dataPropagationFunction);
+  DataPropagationFunction GetDataPropagationFunction() const {
+    return data_propagation_function_;
+  }
+
+  // Estimates the FLOPs and bytes moved by a node from its inferred types.
+  // See EstimateCost in onnx/shape_inference/cost_model.h.
+  OpSchema& CostModelFunction(CostFunction costFunction);
+  CostFunction GetCostFunction() const {
+    return cost_function_;
+  }
+
   // Set the support level for the op schema.
   OpSchema& SetSupportLevel(SupportType supportType);
 
@@ -768,6 +788,14 @@ class OpSchema final {
     return tensor_inference_function_ ? true : false;
   }
 
+  bool has_data_propagation_function() const {
+    return data_propagation_function_ ? true : false;
+  }
+
+  bool has_cost_function() const {
+    return cost_function_ ? true : false;
+  }
+
   bool HasFunction() const {
     return function_body_.node_size() > 0;
   }
@@ -826,6 +854,8 @@ class OpSchema final {
   std::function<bool(int)> num_inputs_allowed_ = [](int) { return true; };
   std::function<bool(int)> num_outputs_allowed_ = [](int) { return true; };
   InferenceFunction tensor_inference_function_;
+  DataPropagationFunction data_propagation_function_;
+  CostFunction cost_function_;
   FunctionProto function_body_;
   ContextDependentFunctionBodyBuilder functionBuilder_;
 };
@@ -836,6 +866,41 @@ using OpName_Domain_Version_Schema_Map = std::unordered_map<
     std::string,
     std::unordered_map<std::string, std::map<OperatorSetVersion, OpSchema>>>;
 
+// A schema of an operator set, by name and since version, with the
+// function constructing it.
+struct OpSchemaEntry {
+  const char* name;
+  int since_version;
+  OpSchema (*create)();
+};
+
+// The read-only table of the schemas of an operator set, a static array of
+// entries. Schemas are constructed from their entries when first used.
+class OpSchemaTable final {
+ public:
+  OpSchemaTable() : begin_(nullptr), end_(nullptr) {}
+
+  template <size_t N>
+  explicit OpSchemaTable(const OpSchemaEntry (&entries)[N])
+      : begin_(entries), end_(entries + N) {}
+
+  const OpSchemaEntry* begin() const {
+    return begin_;
+  }
+
+  const OpSchemaEntry* end() const {
+    return end_;
+  }
+
+  size_t size() const {
+    return end_ - begin_;
+  }
+
+ private:
+  const OpSchemaEntry* begin_;
+  const OpSchemaEntry* end_;
+};
+
 class ISchemaRegistry {
  public:
   virtual ~ISchemaRegistry() = default;
@@ -846,29 +911,44 @@ class ISchemaRegistry {
       const std::string& domain = ONNX_DOMAIN) const = 0;
 };
 
+class OpsetView;
+
 /**
  * @brief A registry to hold all the operator schemas.
+ *
+ * Schemas may be registered and deregistered while other threads look schemas
+ * up. Lookups never lock: the registry is read through immutable snapshots,
+ * which changes replace rather than modify.
  */
 class OpSchemaRegistry final : public ISchemaRegistry {
  public:
   // A singleton class to store domain to min/max op_set version map.
   class DomainToVersionRange final {
    public:
+    // Key: domain. Value: <lowest version, highest version> pair.
+    using VersionRangeMap =
+        std::unordered_map<std::string, std::pair<int, int>>;
+
     DomainToVersionRange() {
+      std::unique_ptr<VersionRangeMap> map(new VersionRangeMap());
       // Increase the highest version when you make BC-breaking changes to the
       // operator schema on specific domain. Update the lowest version when it's
       // determined to remove too old version history.
-      map_[ONNX_DOMAIN] = std::make_pair(1, 13);
-      map_[AI_ONNX_ML_DOMAIN] = std::make_pair(1, 2);
-      map_[AI_ONNX_TRAINING_DOMAIN] = std::make_pair(1, 1);
+      (*map)[ONNX_DOMAIN] = std::make_pair(1, 13);
+      (*map)[AI_ONNX_ML_DOMAIN] = std::make_pair(1, 2);
+      (*map)[AI_ONNX_TRAINING_DOMAIN] = std::make_pair(1, 1);
       // ONNX's preview domain contains operators subject to change, so
       // versining is not meaningful and that domain should have only one
       // version.
-      map_[AI_ONNX_PREVIEW_TRAINING_DOMAIN] = std::make_pair(1, 1);
+      (*map)[AI_ONNX_PREVIEW_TRAINING_DOMAIN] = std::make_pair(1, 1);
+      map_.store(map.get(), std::memory_order_release);
+      snapshots_.push_back(std::move(map));
     }
 
-    const std::unordered_map<std::string, std::pair<int, int>>& Map() const {
-      return map_;
+    // The current snapshot of the map. It is never modified, so it may be
+    // read while another thread adds a domain.
+    const VersionRangeMap& Map() const {
+      return *map_.load(std::memory_order_acquire);
     }
 
     // Add customized domain to min/max version.
@@ -879,15 +959,20 @@ class OpSchemaRegistry final : public ISchemaRegistry {
         int min_version,
         int max_version) {
       std::lock_guard<std::mutex> lock(mutex_);
-      assert(map_.end() == map_.find(domain));
-      map_[domain] = std::make_pair(min_version, max_version);
+      std::unique_ptr<VersionRangeMap> map(
+          new VersionRangeMap(*map_.load(std::memory_order_relaxed)));
+      assert(map->end() == map->find(domain));
+      (*map)[domain] = std::make_pair(min_version, max_version);
+      map_.store(map.get(), std::memory_order_release);
+      snapshots_.push_back(std::move(map));
     }
 
     static DomainToVersionRange& Instance();
 
    private:
-    // Key: domain. Value: <lowest version, highest version> pair.
-    std::unordered_map<std::string, std::pair<int, int>> map_;
+    std::atomic<const VersionRangeMap*> map_;
+    // Every snapshot published, kept for the readers still holding one.
+    std::vector<std::unique_ptr<const VersionRangeMap>> snapshots_;
 
     std::mutex mutex_;
   };
@@ -896,73 +981,50 @@ class OpSchemaRegistry final : public ISchemaRegistry {
    public:
     OpSchemaRegisterOnce(OpSchema& op_schema) {
       try {
-        op_schema.Finalize();
-
-        auto& m = GetMapWithoutEnsuringRegistration();
-
-        auto& op_name = op_schema.Name();
-        auto& op_domain = op_schema.domain();
-        auto ver = op_schema.SinceVersion();
-
-        if (m[op_name][op_domain].count(ver)) {
-          const auto& schema = m[op_name][op_domain][ver];
-          std::stringstream err;
-          err << "Trying to register schema with name " << op_name
-              << " (domain: " << op_domain << " version: " << ver
-              << ") from file " << op_schema.file() << " line "
-              << op_schema.line() << ", but it is already registered from file "
-              << schema.file() << " line " << schema.line() << std::endl;
-          fail_schema(err.str());
-        }
-
-        auto ver_range_map = DomainToVersionRange::Instance().Map();
-        auto ver_range_it = ver_range_map.find(op_domain);
-        if (ver_range_it == ver_range_map.end()) {
-          std::stringstream err;
-          err << "Trying to register schema with name " << op_name
-              << " (domain: " << op_domain << " version: " << ver
-              << ") from file " << op_schema.file() << " line "
-              << op_schema.line() << ", but it its domain is not"
-              << " known by the checker." << std::endl;
-
-          fail_schema(err.str());
-        }
-        auto lower_bound_incl = ver_range_it->second.first;
-        auto upper_bound_incl = ver_range_it->second.second;
-        if (!(lower_bound_incl <= ver && upper_bound_incl >= ver)) {
+        std::lock_guard<std::mutex> lock(GetRegistrationMutex());
+        auto& index = GetIndexWithoutEnsuringRegistration(op_schema.domain());
+        const OpSchema* registered = nullptr;
+        if (index.Contains(
+                op_schema.Name(),
+                op_schema.SinceVersion(),
+                op_schema.domain(),
+                &registered)) {
           std::stringstream err;
-          err << "Trying to register schema with name " << op_name
-              << " (domain: " << op_domain << " version: " << ver
-              << ") from file " << op_schema.file() << " line "
-              << op_schema.line() << ", but it its version is not "
-              << "in the inclusive range [" << lower_bound_incl << ", "
-              << upper_bound_incl << "] (usually, this means you "
-              << "bumped the operator version but "
-              << "forgot to update the version range in DomainToVersionRange "
-              << "in onnx/defs/schema.h)." << std::endl;
+          err << "Trying to register schema with name " << op_schema.Name()
+              << " (domain: " << op_schema.domain()
+              << " version: " << op_schema.SinceVersion() << ") from file "
+              << op_schema.file() << " line " << op_schema.line();
+          if (registered != nullptr) {
+            err << ", but it is already registered from file "
+                << registered->file() << " line " << registered->line();
+          } else {
+            err << ", but it is already registered by an operator set.";
+          }
+          err << std::endl;
           fail_schema(err.str());
         }
-
-        m[op_name][op_domain].insert(
-            std::pair<int, OpSchema&&>(ver, std::move(op_schema)));
-
+        index.Add(Insert(op_schema));
+        Generation().fetch_add(1, std::memory_order_release);
       } catch (const std::exception& e) {
         std::cerr << "Schema error: " << e.what() << std::endl;
       }
     }
   };
 
+  // Removes the schema of op_type with since version <version> in specified
+  // domain, failing if there is none. Lookups no longer find it, but the
+  // schema itself is kept, as other threads may still be using it.
+  static void OpSchemaDeregister(
+      const std::string& op_type,
+      int version,
+      const std::string& domain = ONNX_DOMAIN);
+
   // Return the latest schema for an operator in specified domain.
   // Domain with default value ONNX_DOMAIN means ONNX.
   static const OpSchema* Schema(
       const std::string& key,
       const std::string& domain = ONNX_DOMAIN) {
-    auto& m = map();
-    if (m.count(key) && m[key].count(domain)) {
-      return &m[key][domain].rbegin()->second;
-    } else {
-      return nullptr;
-    }
+    return index(domain).FindLatest(key, domain);
   }
 
   // Return the schema with biggest version, which is not greater than specified
@@ -972,28 +1034,17 @@ class OpSchemaRegistry final : public ISchemaRegistry {
       const std::string& key,
       const int maxInclusiveVersion,
       const std::string& domain = ONNX_DOMAIN) {
-    auto& m = map();
-    if (m.count(key) && m[key].count(domain)) {
-      auto pos = m[key][domain].lower_bound(maxInclusiveVersion);
-      if (m[key][domain].begin() == pos && pos->first > maxInclusiveVersion) {
-        // All versions are greater than specified version.
-        return nullptr;
-      }
-      if (m[key][domain].end() == pos || pos->first > maxInclusiveVersion) {
-        // All versions are less than specified version, or,
-        // The <pos> version is greater than specified version.
-        pos--;
-      }
-
-      // Schema with exact version as specified one exists.
-      return &(pos->second);
-    } else {
-      return nullptr;
-    }
+    return index(domain).Find(key, maxInclusiveVersion, domain);
   }
 
   static OpSchemaRegistry* Instance();
 
+  // Changes whenever a schema is registered or deregistered at runtime, so
+  // that caches of lookups can tell they are stale.
+  static size_t GetGeneration() {
+    return Generation().load(std::memory_order_acquire);
+  }
+
   const OpSchema* GetSchema(
       const std::string& key,
       const int maxInclusiveVersion,
@@ -1007,45 +1058,312 @@ class OpSchemaRegistry final : public ISchemaRegistry {
   OpSchemaRegistry() = default;
 
   /**
-   * @brief Returns the underlying string to OpSchema map.
+   * @brief Returns the storage of the registered schemas.
    *
-   * You should not manually manipulate the map object returned. Instead, use
-   * the macros defined such as ONNX_OPERATOR_SET_SCHEMA to register your
-   * operator schema.
+   * Schemas are only ever appended to it, so that the pointers handed out by
+   * lookups stay valid, even after their schema is deregistered. Use the
+   * macros defined such as ONNX_OPERATOR_SET_SCHEMA to register your operator
+   * schema.
    *
    * We wrap it inside a function to avoid the static initialization order
    * fiasco.
    */
-  static OpName_Domain_Version_Schema_Map& GetMapWithoutEnsuringRegistration();
-  static OpName_Domain_Version_Schema_Map& map();
+  static std::deque<OpSchema>& GetSchemaStorage();
 
- public:
-  static const std::vector<OpSchema> get_all_schemas_with_history() {
-    std::vector<OpSchema> r;
-    for (auto& x : map()) {
-      for (auto& y : x.second) {
-        for (auto& z : y.second) {
-          r.emplace_back(z.second);
+  // Finalizes op_schema and moves it into GetSchemaStorage(), failing if it is
+  // invalid. Requires GetRegistrationMutex().
+  static const OpSchema* Insert(OpSchema& op_schema);
+
+  // Serializes the changes to the registry. Lookups never take it, except to
+  // construct the schemas of schema tables.
+  static std::mutex& GetRegistrationMutex();
+
+  // Changes whenever a schema is registered through OpSchemaRegisterOnce or
+  // deregistered, so that views resolved before can tell they are stale.
+  static std::atomic<size_t>& Generation();
+
+  friend class OpsetView;
+
+  // Read-optimized index of the registered schemas. The versions of an
+  // (op_type, domain) pair are found with one hash of both names, and are
+  // kept sorted in a contiguous array.
+  //
+  // The schemas of the operator sets defined by ONNX are indexed from their
+  // schema tables on the first lookup in their domain, and constructed then,
+  // or only on their own first lookup if built with ONNX_LAZY_SCHEMAS. A
+  // schema is published through an atomic pointer once constructed.
+  //
+  // Lookups neither lock nor wait, read-copy-update style. The index is an
+  // open addressing table of nodes, each with an immutable array of versions.
+  // Changes publish a new array, or a new and bigger table, with an atomic
+  // store. Lookups announce the epoch they start in, and the arrays and
+  // tables replaced are freed once no lookup started before they were.
+  // Changes require GetRegistrationMutex().
+  class SchemaIndex final {
+   public:
+    SchemaIndex();
+    ~SchemaIndex();
+
+    // Indexes a registered schema.
+    void Add(const OpSchema* schema);
+
+    // Indexes the schema of each entry of tables in domain, unless its
+    // version is indexed already.
+    void Add(
+        const std::vector<OpSchemaTable>& tables,
+        const std::string& domain);
+
+    // Removes a version of key from the index. Returns false if it is not
+    // indexed.
+    bool Remove(
+        const std::string& key,
+        int version,
+        const std::string& domain);
+
+    // Whether a version of key is indexed. If schema is not null, it is set to
+    // the schema of that version, or to nullptr if it is not constructed yet.
+    bool Contains(
+        const std::string& key,
+        int version,
+        const std::string& domain,
+        const OpSchema** schema = nullptr) const;
+
+    // The schema with the biggest version not greater than
+    // maxInclusiveVersion, or nullptr.
+    const OpSchema* Find(
+        const std::string& key,
+        int maxInclusiveVersion,
+        const std::string& domain) const;
+
+    // The schema with the biggest version, or nullptr.
+    const OpSchema* FindLatest(
+        const std::string& key,
+        const std::string& domain) const;
+
+    // Calls fn with the schema of every indexed version, or only of the
+    // latest version of each op if latest_only, constructing them first if
+    // needed.
+    void ForEachSchema(
+        bool latest_only,
+        const std::function<void(const OpSchema&)>& fn) const;
+
+   private:
+    friend class OpsetView;
+
+    // Marks the calling thread as reading an index while it lives, so that
+    // the versions and tables it reads are not freed meanwhile. Guards nest.
+    class ReadGuard final {
+     public:
+      ReadGuard();
+      ~ReadGuard();
+      ReadGuard(const ReadGuard&) = delete;
+      ReadGuard& operator=(const ReadGuard&) = delete;
+    };
+
+    struct Key {
+      const std::string* op_type;
+      const std::string* domain;
+    };
+    struct KeyHash {
+      size_t operator()(const Key& key) const;
+    };
+    struct KeyEqual {
+      bool operator()(const Key& lhs, const Key& rhs) const {
+        return *lhs.op_type == *rhs.op_type && *lhs.domain == *rhs.domain;
+      }
+    };
+    // A schema, or the function constructing it if it is not yet.
+    struct Slot {
+      Slot(const OpSchema* schema_, OpSchema (*create_)())
+          : schema(schema_), create(create_) {}
+
+      std::atomic<const OpSchema*> schema;
+      OpSchema (*const create)();
+    };
+    // versions[i] is the since version of slots[i], in increasing order.
+    struct Versions {
+      std::vector<int> versions;
+      std::vector<Slot*> slots;
+    };
+    // An (op_type, domain) pair, with no versions once they are all removed.
+    struct Node {
+      explicit Node(const Key& key_) : key(key_), versions(nullptr) {}
+
+      const Key key;
+      std::atomic<const Versions*> versions;
+    };
+    // The nodes, probed linearly from the hash of their key. The size is a
+    // power of two, at least twice the number of nodes.
+    struct Table {
+      explicit Table(size_t size) : nodes(size) {}
+
+      std::vector<std::atomic<Node*>> nodes;
+    };
+
+    // Calls fn with the key and versions of each node with versions.
+    template <typename F>
+    void ForEachNode(F fn) const {
+      ReadGuard guard;
+      const Table* table = table_.load(std::memory_order_acquire);
+      for (const auto& entry : table->nodes) {
+        const Node* node = entry.load(std::memory_order_acquire);
+        const Versions* versions = node == nullptr
+            ? nullptr
+            : node->versions.load(std::memory_order_acquire);
+        if (versions != nullptr) {
+          fn(node->key, *versions);
         }
       }
     }
-    return r;
-  }
 
-  static const std::vector<OpSchema> get_all_schemas() {
-    std::vector<OpSchema> r;
-    for (auto& x : map()) {
-      for (auto& y : x.second) {
-        auto& version2schema = y.second;
-        r.emplace_back(version2schema.rbegin()->second);
-      }
-    }
-    return r;
-  }
+    Node* FindNode(const Key& key) const;
+    // The node of key, added with copies of its names if there is none.
+    Node* GetOrAddNode(const Key& key);
+    static void InsertNode(Table& table, Node* node);
+    // Replaces the versions of node.
+    void Publish(Node* node, std::unique_ptr<Versions> versions);
+    // Frees the replaced versions and tables that no reader may still hold.
+    void Reclaim();
+    static void InsertVersion(Versions& entry, int version, Slot* slot);
+    void Add(const Key& key, int version, Slot* slot);
+    const Versions* Get(const std::string& key, const std::string& domain)
+        const;
+    // The slot with the biggest version not greater than maxInclusiveVersion,
+    // or nullptr.
+    static Slot* FindSlot(const Versions& entry, int maxInclusiveVersion);
+    // The schema of slot, constructing it first if needed.
+    static const OpSchema* GetSchema(Slot& slot);
+
+    std::atomic<Table*> table_;
+    // Only ever appended to. Keys refer to these copies of the names.
+    std::deque<std::string> names_;
+    std::deque<Slot> slots_;
+    std::deque<Node> nodes_;
+    // Versions and tables replaced by writers, with the epoch they were
+    // replaced in. Each is freed by a later write once no thread has been
+    // reading since that epoch, so only those replaced during lookups still
+    // running are kept.
+    std::vector<std::pair<uint64_t, std::unique_ptr<const Versions>>>
+        retired_versions_;
+    std::vector<std::pair<uint64_t, std::unique_ptr<const Table>>>
+        retired_tables_;
+  };
+
+  // The indexes of the domains defined by ONNX, then the one shared by the
+  // other domains.
+  static SchemaIndex* GetIndexes();
+  // The index of the schemas of domain. Each domain defined by ONNX has an
+  // index of its own, so that indexing the schemas of one domain never
+  // modifies the index another thread is reading. Other domains share one.
+  static SchemaIndex& GetIndexWithoutEnsuringRegistration(
+      const std::string& domain);
+  // Same, after indexing the schema tables of domain the first time it is
+  // asked for, if it is defined by ONNX.
+  static const SchemaIndex& index(const std::string& domain);
+  // Indexes the schema tables of every domain defined by ONNX, for the
+  // callers enumerating the schemas.
+  static void IndexAllDomains();
+
+#ifndef NDEBUG
+  // The number of schema table entries of the domains defined by ONNX.
+  static size_t& DbgBuiltinSchemaCount();
+#endif
+
+ public:
+  static const std::vector<OpSchema> get_all_schemas_with_history();
+
+  static const std::vector<OpSchema> get_all_schemas();
 };
 
 void RegisterSchema(OpSchema&& schema);
 
+void DeregisterSchema(
+    const std::string& op_type,
+    int version,
+    const std::string& domain);
+
+// The schemas of OpSchemaRegistry resolved against one set of opset imports:
+// every op of each imported domain is mapped to the version of its schema
+// that the imported version selects. The view is immutable once built, so
+// any number of threads may share it. Schemas not constructed yet (see
+// ONNX_LAZY_SCHEMAS) are still constructed on their first lookup.
+class OpsetView final {
+ public:
+  // The view of opset_imports, shared by every caller asking for the same
+  // imports. It is resolved the first time they are asked for, and again if
+  // schemas were registered or deregistered since. Each thread finds the few
+  // views it used last without locking.
+  static std::shared_ptr<const OpsetView> Get(
+      const std::unordered_map<std::string, int>& opset_imports);
+
+  // The imported version of domain, or nullptr if the domain is not imported.
+  const int* GetDomainVersion(const std::string& domain) const;
+
+  // The schema of op_type for the imported version of domain, or nullptr if
+  // the domain is not imported or has no such op.
+  const OpSchema* GetSchema(
+      const std::string& op_type,
+      const std::string& domain) const;
+
+ private:
+  using Slot = OpSchemaRegistry::SchemaIndex::Slot;
+  struct DomainSchemas {
+    int version;
+    std::unordered_map<std::string, Slot*> schemas;
+  };
+
+  explicit OpsetView(
+      const std::unordered_map<std::string, int>& opset_imports);
+
+  // The view of opset_imports shared across threads, resolved again if it is
+  // older than generation.
+  static std::shared_ptr<const OpsetView> GetShared(
+      const std::unordered_map<std::string, int>& opset_imports,
+      size_t generation);
+
+  // Whether the view was resolved for opset_imports.
+  bool HasImports(
+      const std::unordered_map<std::string, int>& opset_imports) const;
+
+  // OpSchemaRegistry::Generation() when the view was resolved.
+  size_t generation_;
+  std::unordered_map<std::string, DomainSchemas> domains_;
+};
+
+// Resolves the schemas of the nodes of one model (or graph, or function)
+// against its fixed opset imports. Each distinct (domain, op_type) is looked
+// up in the registry once; later lookups, including those that found no
+// schema, are answered from the cache. Lookups in OpSchemaRegistry are
+// answered from the shared OpsetView of the imports instead.
+// Meant to live for a single check or inference run, so it never sees schemas
+// registered after it was created. Not thread-safe.
+class SchemaResolutionCache final {
+ public:
+  // The registry must outlive the cache.
+  SchemaResolutionCache(
+      const std::unordered_map<std::string, int>& opset_imports,
+      const ISchemaRegistry* schema_registry);
+
+  // The imported version of domain, or nullptr if the domain is not imported.
+  const int* GetDomainVersion(const std::string& domain) const;
+
+  // The schema of op_type for the imported version of domain, or nullptr if
+  // the domain is not imported or has no such op.
+  const OpSchema* GetSchema(
+      const std::string& op_type,
+      const std::string& domain);
+
+ private:
+  struct DomainSchemas {
+    int version;
+    std::unordered_map<std::string, const OpSchema*> schemas;
+  };
+
+  const ISchemaRegistry* schema_registry_;
+  std::unordered_map<std::string, DomainSchemas> domains_;
+  std::shared_ptr<const OpsetView> view_;
+};
+
 // Registers all schema of a given operator set
 template <class T>
 void RegisterOpSetSchema() {
@@ -1074,7 +1392,7 @@ OpSchema GetOpSchema();
 
 // Defines specialization of GetOpSchema for a class whose name is determined
 // based on a convention using name, domain, and version.  Operator schema are
-// normally included in operator sets and registered in OpSchemaRegistry::map().
+// normally included in operator sets and registered in OpSchemaRegistry.
 // In this case, callers should set dbg_included_in_static_opset to true.  This
 // assists with runtime validation in in DEBUG builds ensuring the intended set
 // of operator schema is registered.
@@ -1126,6 +1444,17 @@ class DbgOperatorSetTracker {
 #define ONNX_PREVIEW_OPERATOR_SET_SCHEMA_CLASS_NAME(ver, name) \
   ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(OnnxPreview, ver, name)
 
+// Schema table entries of operator sets
+#define ONNX_OPERATOR_SET_SCHEMA_ENTRY(domain, ver, name) \
+  OpSchemaEntry {                                         \
+    #name, ver,                                           \
+        &GetOpSchema<ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME( \
+            domain, ver, name)>                           \
+  }
+
+#define ONNX_PREVIEW_OPERATOR_SET_SCHEMA_ENTRY(ver, name) \
+  ONNX_OPERATOR_SET_SCHEMA_ENTRY(OnnxPreview, ver, name)
+
 // Helper function
 size_t ReplaceAll(std::string& s, const char* from, const char* to);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "onnx/defs/data_type_utils.h"
+#include "onnx/defs/symbolic_dim.h"
 #include "onnx/proto_utils.h"
 #include "onnx/string_utils.h"
 
@@ -59,11 +60,67 @@ struct InferenceContext {
   virtual TypeProto* getOutputType(size_t index) = 0;
   virtual GraphInferencer* getGraphAttributeInferencer(
       const std::string& attribute_name) = 0;
+  // The value of a small integer input computed by data propagation, with
+  // one dimension per element: a dim_value, a dim_param, or neither if that
+  // element is unknown. Inputs whose value is fully known are also returned
+  // by getInputData. Returns nullptr if data propagation is not enabled or
+  // nothing is known about the input.
+  virtual const TensorShapeProto* getSymbolicInput(size_t index) const {
+    (void)index;
+    return nullptr;
+  }
   virtual ~InferenceContext() {}
 };
 
 using InferenceFunction = std::function<void(InferenceContext&)>;
 
+// Context of a data propagation function. Data propagation runs after type
+// and shape inference of a node, and computes the values of its outputs
+// from the values of its inputs, for the small integer tensors that shapes
+// are computed with (e.g. Shape -> Gather -> Concat -> Reshape). Values are
+// stored one element per dimension, as in getSymbolicInput.
+struct DataPropagationContext {
+  virtual const AttributeProto* getAttribute(const std::string& name) const = 0;
+  virtual size_t getNumInputs() const = 0;
+  virtual const TypeProto* getInputType(size_t index) const = 0;
+  virtual size_t getNumOutputs() const = 0;
+  virtual const TypeProto* getOutputType(size_t index) const = 0;
+  // The value of input index, from data propagation or from a constant, or
+  // nullptr if unknown.
+  virtual const TensorShapeProto* getInputData(size_t index) = 0;
+  virtual void addOutputData(size_t index, TensorShapeProto&& value) = 0;
+  virtual ~DataPropagationContext() {}
+};
+
+using DataPropagationFunction = std::function<void(DataPropagationContext&)>;
+
+// Estimated cost of running a node, computed from the types of its inputs
+// and outputs after shape inference. Inputs whose data is known
+// (getInputData, i.e. initializers) are counted as parameters, the other
+// inputs as activations read.
+struct OpCost {
+  int64_t flops = 0;
+  int64_t param_bytes = 0;
+  int64_t activation_bytes_read = 0;
+  int64_t activation_bytes_written = 0;
+  // False if a shape or element type needed for the estimate is unknown. The
+  // counts then leave out what could not be computed.
+  bool complete = true;
+
+  OpCost& operator+=(const OpCost& other) {
+    flops += other.flops;
+    param_bytes += other.param_bytes;
+    activation_bytes_read += other.activation_bytes_read;
+    activation_bytes_written += other.activation_bytes_written;
+    complete = complete && other.complete;
+    return *this;
+  }
+};
+
+// The context of a cost function is that of shape inference, with the
+// output types already inferred.
+using CostFunction = std::function<OpCost(InferenceContext&)>;
+
 // This no-op inference function is used for operators without an
 // inference implementation.
 inline void dummyInferenceFunction(InferenceContext&){};
@@ -112,6 +169,9 @@ inline TensorShapeProto::Dimension operator*(
     return dim2;
   } else if (dim2.has_dim_value() && (dim2.dim_value() == 1)) {
     return dim1;
+  } else {
+    (SymbolicDim::FromDimension(dim1) * SymbolicDim::FromDimension(dim2))
+        .ToDimension(&result);
   }
   return result;
 }
@@ -124,6 +184,9 @@ inline TensorShapeProto::Dimension operator*(
     result.set_dim_value(dim1.dim_value() * dim2);
   } else if (dim2 == 1) {
     return dim1;
+  } else {
+    (SymbolicDim::FromDimension(dim1) * SymbolicDim(dim2))
+        .ToDimension(&result);
   }
   return result;
 }
@@ -136,6 +199,26 @@ inline TensorShapeProto::Dimension operator/(
     result.set_dim_value(dim1.dim_value() / dim2);
   } else if (dim2 == 1) {
     return dim1;
+  } else {
+    SymbolicDim::FloorDiv(SymbolicDim::FromDimension(dim1), SymbolicDim(dim2))
+        .ToDimension(&result);
+  }
+  return result;
+}
+
+inline TensorShapeProto::Dimension operator+(
+    TensorShapeProto::Dimension dim1,
+    TensorShapeProto::Dimension dim2) {
+  TensorShapeProto::Dimension result;
+  if (dim1.has_dim_value() && dim2.has_dim_value()) {
+    result.set_dim_value(dim1.dim_value() + dim2.dim_value());
+  } else if (dim1.has_dim_value() && (dim1.dim_value() == 0)) {
+    return dim2;
+  } else if (dim2.has_dim_value() && (dim2.dim_value() == 0)) {
+    return dim1;
+  } else {
+    (SymbolicDim::FromDimension(dim1) + SymbolicDim::FromDimension(dim2))
+        .ToDimension(&result);
   }
   return result;
 }
@@ -153,6 +236,51 @@ multiplyDims(const TensorShapeProto& shape, int from, int upto_exclusive) {
   return dim;
 }
 
+// Infer the dimension `inferred` (the -1 entry) of output_shape, a reshape of
+// input_shape: the element count of input_shape over the product of the other
+// output dims. Dims that appear in both shapes cancel first, so reshaping
+// (batch, seq, 64) to (batch, -1) infers 64*seq. Returns an empty dimension if
+// a dim is unknown or the quotient is not exact.
+inline TensorShapeProto::Dimension inferReshapedDim(
+    const TensorShapeProto& input_shape,
+    const TensorShapeProto& output_shape,
+    const TensorShapeProto::Dimension* inferred) {
+  TensorShapeProto::Dimension result;
+  std::vector<SymbolicDim> remaining;
+  remaining.reserve(input_shape.dim_size());
+  for (const auto& dim : input_shape.dim()) {
+    remaining.push_back(SymbolicDim::FromDimension(dim));
+    if (!remaining.back().is_known()) {
+      return result;
+    }
+  }
+  SymbolicDim divisor(1);
+  for (const auto& dim : output_shape.dim()) {
+    if (&dim == inferred) {
+      continue;
+    }
+    SymbolicDim factor = SymbolicDim::FromDimension(dim);
+    if (!factor.is_known()) {
+      return result;
+    }
+    size_t i = 0;
+    while (i < remaining.size() && remaining[i] != factor) {
+      ++i;
+    }
+    if (i < remaining.size()) {
+      remaining.erase(remaining.begin() + i);
+    } else {
+      divisor = divisor * factor;
+    }
+  }
+  SymbolicDim dividend(1);
+  for (const auto& dim : remaining) {
+    dividend = dividend * dim;
+  }
+  SymbolicDim::ExactDiv(dividend, divisor).ToDimension(&result);
+  return result;
+}
+
 // propagate the element type from an input type to an output type.
 // if an existing output element type exists, validate it matches.
 inline void propagateElemTypeWithValidation(
@@ -0,0 +1,481 @@
+// Copyright (c) ONNX Project Contributors.
+// Licensed under the MIT license.
+
+#include "onnx/defs/symbolic_dim.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <limits>
+
+namespace ONNX_NAMESPACE {
+
+namespace {
+
+// Expressions past these sizes are not worth naming: they are given up as
+// unknown instead of growing without bound through long chains of ops.
+const size_t kMaxTerms = 16;
+const size_t kMaxDegree = 8;
+const size_t kMaxTextLength = 256;
+const int kMaxParseDepth = 32;
+
+bool CheckedAdd(int64_t a, int64_t b, int64_t* result) {
+  if ((b > 0 && a > std::numeric_limits<int64_t>::max() - b) ||
+      (b < 0 && a < std::numeric_limits<int64_t>::min() - b)) {
+    return false;
+  }
+  *result = a + b;
+  return true;
+}
+
+bool CheckedMul(int64_t a, int64_t b, int64_t* result) {
+  const int64_t max = std::numeric_limits<int64_t>::max();
+  const int64_t min = std::numeric_limits<int64_t>::min();
+  if (a != 0 && b != 0) {
+    bool overflow = a > 0 ? (b > 0 ? a > max / b : b < min / a)
+                          : (b > 0 ? a < min / b : a < max / b);
+    if (overflow) {
+      return false;
+    }
+  }
+  *result = a * b;
+  return true;
+}
+
+// '-' and '+' are name characters unless spaced out as operators, so a
+// dim_param such as "batch-size" reads as one symbol.
+bool IsSymbolChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_' ||
+      c == '.' || c == ':' || c == '-' || c == '+';
+}
+
+// Recursive descent parser for
+//   expr  := term ((' + ' | ' - ') term)*
+//   term  := unary (('*' | '//') unary)*
+//   unary := '-' unary | primary
+//   primary := integer | symbol | '(' expr ')'
+class Parser {
+ public:
+  explicit Parser(const std::string& text) : text_(text) {}
+
+  bool ParseAll(SymbolicDim* result) {
+    if (!ParseExpr(result)) {
+      return false;
+    }
+    SkipSpaces();
+    return pos_ == text_.size() && result->is_known();
+  }
+
+ private:
+  bool ParseExpr(SymbolicDim* result) {
+    if (!ParseTerm(result)) {
+      return false;
+    }
+    for (;;) {
+      size_t start = pos_;
+      SkipSpaces();
+      bool spaced = pos_ > start && pos_ + 1 < text_.size() &&
+          text_[pos_ + 1] == ' ';
+      bool add = spaced && Consume('+');
+      if (!add && !(spaced && Consume('-'))) {
+        return true;
+      }
+      SymbolicDim term;
+      if (!ParseTerm(&term)) {
+        return false;
+      }
+      *result = add ? *result + term : *result - term;
+    }
+  }
+
+  bool ParseTerm(SymbolicDim* result) {
+    if (!ParseUnary(result)) {
+      return false;
+    }
+    for (;;) {
+      size_t start = pos_;
+      SkipSpaces();
+      bool divide = text_.compare(pos_, 2, "//") == 0;
+      if (divide) {
+        pos_ += 2;
+      } else if (!Consume('*')) {
+        pos_ = start;
+        return true;
+      }
+      SymbolicDim factor;
+      if (!ParseUnary(&factor)) {
+        return false;
+      }
+      *result = divide ? SymbolicDim::FloorDiv(*result, factor)
+                       : *result * factor;
+    }
+  }
+
+  bool ParseUnary(SymbolicDim* result) {
+    SkipSpaces();
+    if (Consume('-')) {
+      SymbolicDim operand;
+      if (!ParseUnary(&operand)) {
+        return false;
+      }
+      *result = SymbolicDim() - operand;
+      return true;
+    }
+    return ParsePrimary(result);
+  }
+
+  bool ParsePrimary(SymbolicDim* result) {
+    SkipSpaces();
+    if (pos_ == text_.size()) {
+      return false;
+    }
+    char c = text_[pos_];
+    if (c == '(') {
+      if (++depth_ > kMaxParseDepth) {
+        return false;
+      }
+      ++pos_;
+      if (!ParseExpr(result)) {
+        return false;
+      }
+      SkipSpaces();
+      --depth_;
+      return Consume(')');
+    }
+    if (std::isdigit(static_cast<unsigned char>(c))) {
+      int64_t value = 0;
+      while (pos_ < text_.size() &&
+             std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
+        if (!CheckedMul(value, 10, &value) ||
+            !CheckedAdd(value, text_[pos_] - '0', &value)) {
+          return false;
+        }
+        ++pos_;
+      }
+      *result = SymbolicDim(value);
+      return true;
+    }
+    if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+      size_t start = pos_;
+      while (pos_ < text_.size() && IsSymbolChar(text_[pos_])) {
+        ++pos_;
+      }
+      *result = SymbolicDim::Symbol(text_.substr(start, pos_ - start));
+      return true;
+    }
+    return false;
+  }
+
+  void SkipSpaces() {
+    while (pos_ < text_.size() && text_[pos_] == ' ') {
+      ++pos_;
+    }
+  }
+
+  bool Consume(char c) {
+    if (pos_ < text_.size() && text_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  const std::string& text_;
+  size_t pos_ = 0;
+  int depth_ = 0;
+};
+
+// Appends coefficient*monomial as the next term of a sum. Floor-division
+// atoms are parenthesized unless they stand alone, since "2*a//3" would read
+// back as (2*a)//3.
+void AppendTerm(
+    std::string& text,
+    const std::vector<std::string>& monomial,
+    int64_t coefficient) {
+  bool first = text.empty();
+  if (!first) {
+    text += coefficient < 0 ? " - " : " + ";
+  } else if (coefficient < 0) {
+    text += '-';
+  }
+  uint64_t magnitude = coefficient < 0
+      ? 0 - static_cast<uint64_t>(coefficient)
+      : static_cast<uint64_t>(coefficient);
+  bool alone = magnitude == 1 && monomial.size() == 1 &&
+      !(first && coefficient < 0);
+  bool separate = false;
+  if (magnitude != 1 || monomial.empty()) {
+    text += std::to_string(magnitude);
+    separate = true;
+  }
+  for (const auto& atom : monomial) {
+    if (separate) {
+      text += '*';
+    }
+    if (!alone && atom.find("//") != std::string::npos) {
+      text += '(' + atom + ')';
+    } else {
+      text += atom;
+    }
+    separate = true;
+  }
+}
+
+} // namespace
+
+SymbolicDim::SymbolicDim(int64_t value) {
+  AddTerm(Monomial(), value);
+}
+
+SymbolicDim SymbolicDim::Unknown() {
+  SymbolicDim result;
+  result.known_ = false;
+  return result;
+}
+
+SymbolicDim SymbolicDim::Atom(const std::string& name) {
+  SymbolicDim result;
+  result.terms_[Monomial(1, name)] = 1;
+  return result;
+}
+
+SymbolicDim SymbolicDim::Symbol(const std::string& name) {
+  return Atom(name);
+}
+
+SymbolicDim SymbolicDim::Parse(const std::string& text) {
+  SymbolicDim result;
+  if (text.size() <= kMaxTextLength && Parser(text).ParseAll(&result)) {
+    return result;
+  }
+  return Atom(text);
+}
+
+SymbolicDim SymbolicDim::FromDimension(
+    const TensorShapeProto::Dimension& dim) {
+  if (dim.has_dim_value()) {
+    return SymbolicDim(dim.dim_value());
+  }
+  if (dim.has_dim_param() && !dim.dim_param().empty()) {
+    // Only the canonical text ToDimension writes is read as an expression;
+    // any other dim_param, such as "N-1" or "2*(n)", is a name of its own.
+    const std::string& text = dim.dim_param();
+    SymbolicDim result = Parse(text);
+    return result.ToString() == text ? result : Atom(text);
+  }
+  return Unknown();
+}
+
+bool SymbolicDim::is_constant() const {
+  return known_ &&
+      (terms_.empty() ||
+       (terms_.size() == 1 && terms_.begin()->first.empty()));
+}
+
+int64_t SymbolicDim::constant_value() const {
+  return terms_.empty() ? 0 : terms_.begin()->second;
+}
+
+bool SymbolicDim::is_positive() const {
+  if (!known_ || terms_.empty() || !terms_.begin()->first.empty()) {
+    return false;
+  }
+  for (const auto& term : terms_) {
+    if (term.second <= 0) {
+      return false;
+    }
+    for (const auto& atom : term.first) {
+      if (atom.find("//") != std::string::npos) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+std::string SymbolicDim::ToString() const {
+  if (!known_) {
+    return std::string();
+  }
+  if (terms_.empty()) {
+    return "0";
+  }
+  // The map orders the constant term first; it is written last instead.
+  std::string text;
+  for (const auto& term : terms_) {
+    if (!term.first.empty()) {
+      AppendTerm(text, term.first, term.second);
+    }
+  }
+  if (terms_.begin()->first.empty()) {
+    AppendTerm(text, Monomial(), terms_.begin()->second);
+  }
+  return text;
+}
+
+void SymbolicDim::ToDimension(TensorShapeProto::Dimension* dim) const {
+  if (!known_) {
+    dim->clear_value();
+  } else if (is_constant()) {
+    dim->set_dim_value(constant_value());
+  } else {
+    dim->set_dim_param(ToString());
+  }
+}
+
+void SymbolicDim::AddTerm(const Monomial& monomial, int64_t coefficient) {
+  if (coefficient == 0 || !known_) {
+    return;
+  }
+  auto it = terms_.find(monomial);
+  if (it == terms_.end()) {
+    terms_.emplace(monomial, coefficient);
+    return;
+  }
+  if (!CheckedAdd(it->second, coefficient, &it->second)) {
+    *this = Unknown();
+  } else if (it->second == 0) {
+    terms_.erase(it);
+  }
+}
+
+SymbolicDim& SymbolicDim::Limit() {
+  bool too_large = terms_.size() > kMaxTerms;
+  for (const auto& term : terms_) {
+    too_large = too_large || term.first.size() > kMaxDegree;
+  }
+  if (too_large) {
+    *this = Unknown();
+  }
+  return *this;
+}
+
+SymbolicDim operator+(const SymbolicDim& lhs, const SymbolicDim& rhs) {
+  if (!lhs.known_ || !rhs.known_) {
+    return SymbolicDim::Unknown();
+  }
+  SymbolicDim result = lhs;
+  for (const auto& term : rhs.terms_) {
+    result.AddTerm(term.first, term.second);
+  }
+  return result.Limit();
+}
+
+SymbolicDim operator-(const SymbolicDim& lhs, const SymbolicDim& rhs) {
+  return lhs + rhs * SymbolicDim(-1);
+}
+
+SymbolicDim operator*(const SymbolicDim& lhs, const SymbolicDim& rhs) {
+  if (!lhs.known_ || !rhs.known_) {
+    return SymbolicDim::Unknown();
+  }
+  SymbolicDim result;
+  for (const auto& a : lhs.terms_) {
+    for (const auto& b : rhs.terms_) {
+      int64_t coefficient;
+      if (!CheckedMul(a.second, b.second, &coefficient)) {
+        return SymbolicDim::Unknown();
+      }
+      SymbolicDim::Monomial monomial;
+      monomial.reserve(a.first.size() + b.first.size());
+      std::merge(
+          a.first.begin(),
+          a.first.end(),
+          b.first.begin(),
+          b.first.end(),
+          std::back_inserter(monomial));
+      result.AddTerm(monomial, coefficient);
+    }
+  }
+  return result.Limit();
+}
+
+SymbolicDim SymbolicDim::ExactDiv(
+    const SymbolicDim& lhs,
+    const SymbolicDim& rhs) {
+  if (!lhs.known_ || !rhs.known_ || rhs.terms_.empty()) {
+    return Unknown();
+  }
+  if (rhs.terms_.size() != 1) {
+    return lhs == rhs ? SymbolicDim(1) : Unknown();
+  }
+  const Monomial& divisor = rhs.terms_.begin()->first;
+  int64_t coefficient = rhs.terms_.begin()->second;
+  SymbolicDim result;
+  for (const auto& term : lhs.terms_) {
+    if (term.second % coefficient != 0 ||
+        (coefficient == -1 &&
+         term.second == std::numeric_limits<int64_t>::min()) ||
+        !std::includes(
+            term.first.begin(),
+            term.first.end(),
+            divisor.begin(),
+            divisor.end())) {
+      return Unknown();
+    }
+    Monomial quotient;
+    std::set_difference(
+        term.first.begin(),
+        term.first.end(),
+        divisor.begin(),
+        divisor.end(),
+        std::back_inserter(quotient));
+    result.AddTerm(quotient, term.second / coefficient);
+  }
+  return result;
+}
+
+SymbolicDim SymbolicDim::FloorDiv(
+    const SymbolicDim& lhs,
+    const SymbolicDim& rhs) {
+  if (!lhs.known_ || !rhs.known_ || rhs.terms_.empty()) {
+    return Unknown();
+  }
+  SymbolicDim exact = ExactDiv(lhs, rhs);
+  if (exact.known_) {
+    return exact;
+  }
+
+  // lhs == d*quotient + remainder, with remainder's coefficients in [0, d).
+  // Symbols are integers, so lhs//d == quotient + remainder//d, and a
+  // constant remainder contributes nothing.
+  SymbolicDim quotient;
+  SymbolicDim remainder = lhs;
+  int64_t divisor = rhs.is_constant() ? rhs.constant_value() : 0;
+  if (divisor > 0) {
+    remainder = SymbolicDim();
+    for (const auto& term : lhs.terms_) {
+      int64_t q = term.second / divisor;
+      int64_t r = term.second % divisor;
+      if (r < 0) {
+        r += divisor;
+        --q;
+      }
+      quotient.AddTerm(term.first, q);
+      remainder.AddTerm(term.first, r);
+    }
+    if (remainder.is_constant()) {
+      return quotient;
+    }
+  }
+
+  std::string lhs_text = remainder.ToString();
+  if (remainder.terms_.size() > 1) {
+    lhs_text = '(' + lhs_text + ')';
+  }
+  std::string rhs_text = rhs.ToString();
+  bool plain_rhs = divisor > 0 ||
+      (rhs.terms_.size() == 1 && rhs.terms_.begin()->second == 1 &&
+       rhs.terms_.begin()->first.size() == 1 &&
+       rhs_text.find("//") == std::string::npos);
+  if (!plain_rhs) {
+    rhs_text = '(' + rhs_text + ')';
+  }
+  std::string name = lhs_text + "//" + rhs_text;
+  if (name.size() > kMaxTextLength) {
+    return Unknown();
+  }
+  return quotient + Atom(name);
+}
+
+} // namespace ONNX_NAMESPACE
@@ -0,0 +1,99 @@
+// Copyright (c) ONNX Project Contributors.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "onnx/onnx_pb.h"
+
+namespace ONNX_NAMESPACE {
+
+// A dimension expression over named symbols: a polynomial with integer
+// coefficients whose atoms are dim_param symbols and floor-divisions that
+// could not be simplified further. Expressions are kept in a canonical form,
+// so equal dimensions print to the same dim_param (e.g. "batch*seq",
+// "seq + 1", "(seq + 1)//2") no matter in which order they were built.
+//
+// A dimension that cannot be expressed (too large, overflowing, or derived
+// from an unknown dimension) is "unknown", and stays unknown through every
+// operation it takes part in.
+class SymbolicDim final {
+ public:
+  // The constant 0.
+  SymbolicDim() = default;
+  explicit SymbolicDim(int64_t value);
+
+  static SymbolicDim Unknown();
+  static SymbolicDim Symbol(const std::string& name);
+
+  // Reads an expression of integers, symbols, parentheses and the operators
+  // +, -, * and // (floor division). Binary + and - need a space on either
+  // side; "batch-size" is a symbol. Any other string, such as "batch size",
+  // is taken as a single opaque symbol.
+  static SymbolicDim Parse(const std::string& text);
+
+  // Reads a dim_value or dim_param. A dim_param is read as an expression
+  // only if it is in canonical form, and is an opaque symbol otherwise.
+  // Unknown if dim has neither.
+  static SymbolicDim FromDimension(const TensorShapeProto::Dimension& dim);
+
+  bool is_known() const {
+    return known_;
+  }
+
+  bool is_constant() const;
+
+  // Precondition: is_constant().
+  int64_t constant_value() const;
+
+  // Whether the expression is positive for all dimension sizes its symbols
+  // may take (any values >= 0). Floor-division atoms may be negative, so an
+  // expression containing one is not known to be positive.
+  bool is_positive() const;
+
+  // Canonical text of the expression, or an empty string if unknown.
+  std::string ToString() const;
+
+  // Writes a dim_value for constants, the canonical dim_param for other
+  // known expressions, and clears dim if unknown.
+  void ToDimension(TensorShapeProto::Dimension* dim) const;
+
+  // Floor division. Exact quotients simplify (6*a*b // 2*a == 3*b), integer
+  // multiples of a positive constant divisor are pulled out
+  // ((2*a + 3) // 2 == a + 1 + 1//2 == a + 1) and the rest becomes a floor-division
+  // atom.
+  static SymbolicDim FloorDiv(const SymbolicDim& lhs, const SymbolicDim& rhs);
+
+  // The quotient if rhs divides lhs exactly as polynomials, else unknown.
+  static SymbolicDim ExactDiv(const SymbolicDim& lhs, const SymbolicDim& rhs);
+
+  friend SymbolicDim operator+(const SymbolicDim& lhs, const SymbolicDim& rhs);
+  friend SymbolicDim operator-(const SymbolicDim& lhs, const SymbolicDim& rhs);
+  friend SymbolicDim operator*(const SymbolicDim& lhs, const SymbolicDim& rhs);
+
+  bool operator==(const SymbolicDim& other) const {
+    return known_ == other.known_ && terms_ == other.terms_;
+  }
+  bool operator!=(const SymbolicDim& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  // Sorted atom names; an atom appears once per power.
+  using Monomial = std::vector<std::string>;
+
+  void AddTerm(const Monomial& monomial, int64_t coefficient);
+  // Marks the expression unknown if it grew past the size limits.
+  SymbolicDim& Limit();
+  static SymbolicDim Atom(const std::string& name);
+
+  bool known_ = true;
+  // Nonzero coefficients by monomial; the constant term has no atoms.
+  std::map<Monomial, int64_t> terms_;
+};
+
+} // namespace ONNX_NAMESPACE
@@ -1,6 +1,7 @@
 // Copyright (c) ONNX Project Contributors.
 // Licensed under the MIT license.
 
+#include "onnx/defs/data_propagators.h"
 #include "onnx/defs/tensor/utils.h"
 
 #include <algorithm>
@@ -99,7 +100,8 @@ ONNX_OPERATOR_SET_SCHEMA(
           if (hasNInputShapes(ctx, 1)) {
             propagateShapeFromInputToOutput(ctx, 0, 0);
           }
-        }));
+        })
+        .PartialDataPropagationFunction(propagateDataFromInputToOutput));
 
 static const char* Reshape_ver13_doc = R"DOC(
 Reshape the input tensor similar to numpy.reshape.
@@ -148,6 +150,11 @@ ONNX_OPERATOR_SET_SCHEMA(
           // Shape Inference if 2nd input data (the target shape) is available
           const TensorProto* targetShapeInitializer = ctx.getInputData(1);
           if (!targetShapeInitializer) {
+            const TensorShapeProto* symbolicTargetShape =
+                ctx.getSymbolicInput(1);
+            if (symbolicTargetShape) {
+              symbolicReshapeShapeInference(ctx, *symbolicTargetShape);
+            }
             return;
           }
           // Make targetShape (0 -> same as originalShape, -1 -> inferred).
@@ -257,6 +264,9 @@ ONNX_OPERATOR_SET_SCHEMA(
                     "Dimension could not be inferred: incompatible shapes");
               }
               negativeOneDim->set_dim_value(inputProduct / outputProduct);
+            } else if (dataInputTensorType.has_shape()) {
+              *negativeOneDim = inferReshapedDim(
+                  dataInputTensorType.shape(), *outputShape, negativeOneDim);
             }
           }
         }));
@@ -310,7 +320,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ->set_dim_value(
                     ctx.getInputType(0)->tensor_type().shape().dim_size());
           }
-        }));
+        })
+        .PartialDataPropagationFunction(shapeDataPropagator));
 
 static const char* Size_ver13_doc = R"DOC(
 Takes a tensor as input and outputs a int64 scalar that equals to the total number of elements of the input tensor.
@@ -412,8 +423,10 @@ ONNX_OPERATOR_SET_SCHEMA(
             return;
           }
 
-          bool all_lengths_known = true;
-          int total_length = 0;
+          // The concatenated length is kept as a symbolic sum when some
+          // lengths are dim_params, and is unknown if any length is.
+          TensorShapeProto::Dimension total_length;
+          total_length.set_dim_value(0);
 
           auto* output_shape =
               ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
@@ -428,11 +441,7 @@ ONNX_OPERATOR_SET_SCHEMA(
               fail_shape_inference("All inputs to Concat must have same rank");
             for (int j = 0; j < rank; j++) {
               if (j == axis) {
-                if (shape.dim(j).has_dim_value()) {
-                  total_length += static_cast<int>(shape.dim(j).dim_value());
-                } else {
-                  all_lengths_known = false;
-                }
+                total_length = total_length + shape.dim(j);
               } else {
                 auto& output_dim = *output_shape->mutable_dim(j);
                 const auto& input_dim = shape.dim(j);
@@ -441,10 +450,9 @@ ONNX_OPERATOR_SET_SCHEMA(
             }
           }
 
-          if (all_lengths_known) {
-            output_shape->mutable_dim(axis)->set_dim_value(total_length);
-          }
-        }));
+          *output_shape->mutable_dim(axis) = total_length;
+        })
+        .PartialDataPropagationFunction(concatDataPropagator));
 
 static const char* Split_ver13_doc =
     R"DOC(Split a tensor into a list of tensors, along the specified
@@ -843,7 +851,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ->mutable_dim((int)axis)
                 ->set_dim_value(temp);
           }
-        }));
+        })
+        .PartialDataPropagationFunction(sliceDataPropagator));
 
 static const char* Transpose_ver13_doc = R"DOC(
 Transpose the input tensor similar to numpy.transpose. For example, when
@@ -1413,7 +1422,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                                             : // i - axis < q
                     data_shape.dim(i - q + 1); // i < out_rank < q + r - 1
           }
-        }));
+        })
+        .PartialDataPropagationFunction(gatherDataPropagator));
 
 static const char* GatherElements_ver13_doc = R"DOC(
 
@@ -1607,7 +1617,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                    ->add_dim() = input_shape.dim(i);
             }
           }
-        }));
+        })
+        .PartialDataPropagationFunction(propagateDataFromInputToOutput));
 
 static const char* Unsqueeze_ver13_doc = R"DOC(
 Insert single-dimensional entries to the shape of an input tensor (`data`).
@@ -1727,7 +1738,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ->set_dim_value(1);
             ++j;
           }
-        }));
+        })
+        .PartialDataPropagationFunction(propagateDataFromInputToOutput));
 
 static const char* SpaceToDepth_ver13_doc =
     R"DOC(SpaceToDepth rearranges blocks of spatial data into depth. More specifically,
@@ -2165,7 +2177,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             OpSchema::all_tensor_types_with_bfloat(),
             "Constrain input and output types to all tensor types.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .PartialDataPropagationFunction(propagateDataFromInputToOutput));
 
 static const char* Compress_ver11_doc = R"DOC(
     Selects slices from an input tensor along a given axis where condition evaluates to True for each axis index.
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include "onnx/defs/data_propagators.h"
 #include "onnx/defs/tensor/utils.h"
 
 namespace ONNX_NAMESPACE {
@@ -84,7 +85,8 @@ ONNX_OPERATOR_SET_SCHEMA(
           if (hasNInputShapes(ctx, 1)) {
             propagateShapeFromInputToOutput(ctx, 0, 0);
           }
-        }));
+        })
+        .PartialDataPropagationFunction(propagateDataFromInputToOutput));
 
 static const char* Reshape_ver5_doc = R"DOC(
 Reshape the input tensor similar to numpy.reshape.
@@ -112,6 +114,11 @@ ONNX_OPERATOR_SET_SCHEMA(
           // Shape Inference if 2nd input data (the target shape) is available
           const TensorProto* targetShapeInitializer = ctx.getInputData(1);
           if (!targetShapeInitializer) {
+            const TensorShapeProto* symbolicTargetShape =
+                ctx.getSymbolicInput(1);
+            if (symbolicTargetShape) {
+              symbolicReshapeShapeInference(ctx, *symbolicTargetShape);
+            }
             return;
           }
           // Make targetShape (0 -> same as originalShape, -1 -> inferred).
@@ -221,6 +228,9 @@ ONNX_OPERATOR_SET_SCHEMA(
                     "Dimension could not be inferred: incompatible shapes");
               }
               negativeOneDim->set_dim_value(inputProduct / outputProduct);
+            } else if (dataInputTensorType.has_shape()) {
+              *negativeOneDim = inferReshapedDim(
+                  dataInputTensorType.shape(), *outputShape, negativeOneDim);
             }
           }
         }));
@@ -260,7 +270,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ->set_dim_value(
                     ctx.getInputType(0)->tensor_type().shape().dim_size());
           }
-        }));
+        })
+        .PartialDataPropagationFunction(shapeDataPropagator));
 
 static const char* Size_ver1_doc = R"DOC(
 Takes a tensor as input and outputs a int64 scalar that equals to the total number of elements of the input tensor.
@@ -337,8 +348,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             return;
           }
 
-          bool all_lengths_known = true;
-          int total_length = 0;
+          TensorShapeProto::Dimension total_length;
+          total_length.set_dim_value(0);
 
           auto* output_shape =
               ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
@@ -353,11 +364,7 @@ ONNX_OPERATOR_SET_SCHEMA(
               fail_shape_inference("All inputs to Concat must have same rank");
             for (int j = 0; j < rank; j++) {
               if (j == axis) {
-                if (shape.dim(j).has_dim_value()) {
-                  total_length += static_cast<int>(shape.dim(j).dim_value());
-                } else {
-                  all_lengths_known = false;
-                }
+                total_length = total_length + shape.dim(j);
               } else {
                 auto& output_dim = *output_shape->mutable_dim(j);
                 const auto& input_dim = shape.dim(j);
@@ -366,10 +373,9 @@ ONNX_OPERATOR_SET_SCHEMA(
             }
           }
 
-          if (all_lengths_known) {
-            output_shape->mutable_dim(axis)->set_dim_value(total_length);
-          }
-        }));
+          *output_shape->mutable_dim(axis) = total_length;
+        })
+        .PartialDataPropagationFunction(concatDataPropagator));
 
 static const char* Split_ver11_doc =
     R"DOC(Split a tensor into a list of tensors, along the specified
@@ -731,7 +737,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ->mutable_dim((int)axis)
                 ->set_dim_value(temp);
           }
-        }));
+        })
+        .PartialDataPropagationFunction(sliceDataPropagator));
 
 static const char* Transpose_ver1_doc = R"DOC(
 Transpose the input tensor similar to numpy.transpose. For example, when
@@ -1189,7 +1196,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                                             : // i - axis < q
                     data_shape.dim(i - q + 1); // i < out_rank < q + r - 1
           }
-        }));
+        })
+        .PartialDataPropagationFunction(gatherDataPropagator));
 
 static const char* GatherElements_ver11_doc = R"DOC(
 
@@ -1353,7 +1361,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                    ->add_dim() = input_shape.dim(i);
             }
           }
-        }));
+        })
+        .PartialDataPropagationFunction(propagateDataFromInputToOutput));
 
 static const char* Unsqueeze_ver11_doc = R"DOC(
 Insert single-dimensional entries to the shape of an input tensor (`data`).
@@ -1457,7 +1466,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ->set_dim_value(1);
             ++j;
           }
-        }));
+        })
+        .PartialDataPropagationFunction(propagateDataFromInputToOutput));
 
 static const char* SpaceToDepth_ver1_doc =
     R"DOC(SpaceToDepth rearranges blocks of spatial data into depth. More specifically,
@@ -1825,7 +1835,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             "T",
             OpSchema::all_tensor_types(),
             "Constrain input and output types to all tensor types.")
-        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
+        .PartialDataPropagationFunction(propagateDataFromInputToOutput));
 
 ONNX_OPERATOR_SET_SCHEMA(
     IsNaN,
@@ -2318,7 +2329,8 @@ ONNX_OPERATOR_SET_SCHEMA(
           if (hasNInputShapes(ctx, 1)) {
             propagateShapeFromInputToOutput(ctx, 0, 0);
           }
-        }));
+        })
+        .PartialDataPropagationFunction(propagateDataFromInputToOutput));
 
 static const char* Concat_ver1_doc =
     R"DOC(Concatenate a list of tensors into a single tensor)DOC";
@@ -2384,8 +2396,8 @@ ONNX_OPERATOR_SET_SCHEMA(
             return; // TODO: check if negative axis must be supported
           }
 
-          bool all_lengths_known = true;
-          int total_length = 0;
+          TensorShapeProto::Dimension total_length;
+          total_length.set_dim_value(0);
 
           auto* output_shape =
               ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
@@ -2400,11 +2412,7 @@ ONNX_OPERATOR_SET_SCHEMA(
               fail_shape_inference("All inputs to Concat must have same rank");
             for (int j = 0; j < rank; j++) {
               if (j == axis) {
-                if (shape.dim(j).has_dim_value()) {
-                  total_length += static_cast<int>(shape.dim(j).dim_value());
-                } else {
-                  all_lengths_known = false;
-                }
+                total_length = total_length + shape.dim(j);
               } else {
                 auto& output_dim = *output_shape->mutable_dim(j);
                 const auto& input_dim = shape.dim(j);
@@ -2413,10 +2421,9 @@ ONNX_OPERATOR_SET_SCHEMA(
             }
           }
 
-          if (all_lengths_known) {
-            output_shape->mutable_dim(axis)->set_dim_value(total_length);
-          }
-        }));
+          *output_shape->mutable_dim(axis) = total_length;
+        })
+        .PartialDataPropagationFunction(concatDataPropagator));
 
 static const char* Split_ver1_doc =
     R"DOC(Split a tensor into a list of tensors, along the specified
@@ -3117,7 +3124,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ->mutable_dim((int)axis)
                 ->set_dim_value(temp);
           }
-        }));
+        })
+        .PartialDataPropagationFunction(sliceDataPropagator));
 
 static const char* Scatter_ver9_doc = R"DOC(
 Given `data`, `updates` and `indices` input tensors of rank r >= 1, write the values provided by `updates` 
@@ -3353,7 +3361,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                                             : // i - axis < q
                     data_shape.dim(i - q + 1); // i < out_rank < q + r - 1
           }
-        }));
+        })
+        .PartialDataPropagationFunction(gatherDataPropagator));
 
 static const char* Squeeze_ver1_doc = R"DOC(
 Remove single-dimensional entries from the shape of a tensor.
@@ -3414,7 +3423,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                    ->add_dim() = input_shape.dim(i);
             }
           }
-        }));
+        })
+        .PartialDataPropagationFunction(propagateDataFromInputToOutput));
 
 static const char* Unsqueeze_ver1_doc = R"DOC(
 Insert single-dimensional entries to the shape of a tensor.
@@ -3487,7 +3497,8 @@ ONNX_OPERATOR_SET_SCHEMA(
                 ->set_dim_value(1);
             ++j;
           }
-        }));
+        })
+        .PartialDataPropagationFunction(propagateDataFromInputToOutput));
 
 static const char* OneHot_ver9_doc = R"DOC(
     Produces a one-hot tensor based on inputs.
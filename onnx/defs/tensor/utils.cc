@@ -167,4 +167,57 @@ void resizeShapeInference_opset7_to_10(InferenceContext& ctx) {
   }
 }
 
+void symbolicReshapeShapeInference(
+    InferenceContext& ctx,
+    const TensorShapeProto& target_shape) {
+  const auto& input_type = ctx.getInputType(0)->tensor_type();
+  auto* output_shape =
+      ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+  TensorShapeProto::Dimension* negative_one_dim = nullptr;
+  bool has_symbolic_entry = false;
+  for (const auto& target : target_shape.dim()) {
+    auto* new_dim = output_shape->add_dim();
+    if (target.has_dim_param()) {
+      // A symbolic entry computed from dimension sizes may still be 0 or -1
+      // at runtime (e.g. "N - 1"). It is copied only if it is positive, or if
+      // it is the input dimension a 0 would copy anyway.
+      has_symbolic_entry = true;
+      const int i = output_shape->dim_size() - 1;
+      SymbolicDim entry = SymbolicDim::FromDimension(target);
+      if (entry.is_positive() ||
+          (input_type.has_shape() && i < input_type.shape().dim_size() &&
+           SymbolicDim::FromDimension(input_type.shape().dim(i)) == entry)) {
+        new_dim->set_dim_param(target.dim_param());
+      }
+    } else if (!target.has_dim_value()) {
+      // Unknown entry: it may even be 0 or -1, so nothing more is inferred.
+      continue;
+    } else if (target.dim_value() == -1) {
+      if (negative_one_dim) {
+        fail_shape_inference(
+            "Target shape may not have multiple -1 dimensions");
+      }
+      negative_one_dim = new_dim;
+    } else if (target.dim_value() == 0) {
+      if (input_type.has_shape()) {
+        int i = output_shape->dim_size() - 1;
+        if (i >= input_type.shape().dim_size()) {
+          fail_shape_inference("Invalid position of 0");
+        }
+        *new_dim = input_type.shape().dim(i);
+      }
+    } else if (target.dim_value() > 0) {
+      new_dim->set_dim_value(target.dim_value());
+    } else {
+      fail_shape_inference("Invalid dimension value: ", target.dim_value());
+    }
+  }
+  // The -1 entry is inferred from the others only when none of them may turn
+  // out to be 0 or -1.
+  if (negative_one_dim && !has_symbolic_entry && input_type.has_shape()) {
+    *negative_one_dim =
+        inferReshapedDim(input_type.shape(), *output_shape, negative_one_dim);
+  }
+}
+
 } // namespace ONNX_NAMESPACE
@@ -22,6 +22,12 @@ void resizeShapeInferenceHelper(
     const std::vector<int64_t>& sizes_data,
     TensorShapeProto* output_shape);
 
+// Reshape to a target shape known from data propagation, whose entries may
+// be symbolic (see InferenceContext::getSymbolicInput).
+void symbolicReshapeShapeInference(
+    InferenceContext& ctx,
+    const TensorShapeProto& target_shape);
+
 // The below is called by ops between opset 7 and opset 10, inclusively.
 void resizeShapeInference_opset7_to_10(InferenceContext& ctx);
 
@@ -1,15 +1,39 @@
-from typing import Dict, Text, Union
+from typing import Dict, List, Text, Union
 
 
 class CheckerContext(object):
     ir_version: int = ...
     opset_imports: Dict[Text, int] = ...
+    num_threads: int = ...
 
 
 class ValidationError(Exception):
     ...
 
 
+class DiagnosticCode(object):
+    InvalidModel: 'DiagnosticCode' = ...
+    InvalidGraph: 'DiagnosticCode' = ...
+    InvalidValueInfo: 'DiagnosticCode' = ...
+    InvalidInitializer: 'DiagnosticCode' = ...
+    UnsortedNode: 'DiagnosticCode' = ...
+    NotSSA: 'DiagnosticCode' = ...
+    InvalidNode: 'DiagnosticCode' = ...
+
+
+class Diagnostic(object):
+    @property
+    def code(self) -> DiagnosticCode: ...
+    @property
+    def graph_name(self) -> Text: ...
+    @property
+    def node_index(self) -> int: ...
+    @property
+    def op_type(self) -> Text: ...
+    @property
+    def message(self) -> Text: ...
+
+
 def check_value_info(bytes: bytes, checker_context: CheckerContext) -> None: ...
 def check_tensor(bytes: bytes, checker_context: CheckerContext) -> None: ...
 def check_sparse_tensor(bytes: bytes, checker_context: CheckerContext) -> None: ...
@@ -17,4 +41,6 @@ def check_attribute(bytes: bytes, checker_context: CheckerContext) -> None: ...
 def check_node(bytes: bytes, checker_context: CheckerContext) -> None: ...
 def check_graph(bytes: bytes, checker_context: CheckerContext) -> None: ...
 def check_model(bytes: bytes) -> None: ...
+def collect_model_diagnostics(bytes: bytes) -> List[Diagnostic]: ...
 def check_model_path(path: Text) -> None: ...
+def check_model_path_streaming(path: Text) -> None: ...
@@ -1 +1,7 @@
-def infer_shapes(b: bytes, check_type: bool) -> bytes: ...
+from typing import Any, Dict, List, Sequence, Text, Union
+
+def infer_shapes(b: bytes, check_type: bool = False, num_threads: int = 1, data_prop: bool = False) -> bytes: ...
+def infer_shapes_for_bindings(b: bytes, input_shapes: List[Dict[Text, Sequence[int]]], check_type: bool = False, data_prop: bool = False) -> List[List[bytes]]: ...
+def estimate_cost(b: bytes) -> Dict[Text, Union[int, bool]]: ...
+def plan_memory(b: bytes, alignment: int = 64) -> Dict[Text, Any]: ...
+def infer_shapes_path(model_path: Text, output_path: Text = '', check_type: bool = False) -> None: ...
@@ -34,6 +34,7 @@ Supported pass names:
     -- fuse_consecutive_transposes
     -- fuse_add_bias_into_conv
     -- fuse_transpose_into_gemm
+    -- infer_shapes
 """
 
 get_available_passes = C.get_available_passes
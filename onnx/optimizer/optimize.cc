@@ -2,6 +2,7 @@
 // Adventurous users should note that the APIs will probably change.
 
 #include "onnx/optimizer/optimize.h"
+#include "onnx/common/file_utils.h"
 
 namespace ONNX_NAMESPACE {
 namespace optimization {
@@ -37,6 +38,28 @@ ModelProto OptimizeFixed(
   Optimizer current_opt(names, true);
   return current_opt.optimize(mp_in);
 }
+
+namespace {
+ModelProto LoadModel(const std::string& model_path) {
+  ModelProto mp_in;
+  ONNX_ASSERTM(
+      ParseProtoFromPath(&mp_in, model_path),
+      "Unable to load model from file: %s",
+      model_path.c_str());
+  return mp_in;
+}
+} // namespace
+
+ModelProto Optimize(
+    const std::string& model_path,
+    const std::vector<std::string>& names) {
+  return Optimize(LoadModel(model_path), names);
+}
+ModelProto OptimizeFixed(
+    const std::string& model_path,
+    const std::vector<std::string>& names) {
+  return OptimizeFixed(LoadModel(model_path), names);
+}
 const std::vector<std::string> GetAvailablePasses() {
   return Optimizer::passes.GetAvailablePasses();
 }
@@ -52,5 +52,14 @@ ModelProto Optimize(
 ModelProto OptimizeFixed(
     const ModelProto& mp_in,
     const std::vector<std::string>& names);
+
+// Load the model at model_path through a memory mapping and optimize it.
+ModelProto Optimize(
+    const std::string& model_path,
+    const std::vector<std::string>& names);
+
+ModelProto OptimizeFixed(
+    const std::string& model_path,
+    const std::vector<std::string>& names);
 } // namespace optimization
 } // namespace ONNX_NAMESPACE
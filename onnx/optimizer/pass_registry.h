@@ -24,6 +24,7 @@
 #include "onnx/optimizer/passes/fuse_matmul_add_bias_into_gemm.h"
 #include "onnx/optimizer/passes/fuse_pad_into_conv.h"
 #include "onnx/optimizer/passes/fuse_transpose_into_gemm.h"
+#include "onnx/optimizer/passes/infer_shapes.h"
 #include "onnx/optimizer/passes/lift_lexical_references.h"
 #include "onnx/optimizer/passes/nop.h"
 #include "onnx/optimizer/passes/split.h"
@@ -60,6 +61,7 @@ struct GlobalPassRegistry {
     registerPass<FuseMatMulAddBiasIntoGemm>();
     registerPass<FusePadIntoConv>();
     registerPass<FuseTransposeIntoGemm>();
+    registerPass<InferShapes>();
     registerPass<LiftLexicalReferences>();
     registerPass<SplitInit>();
     registerPass<SplitPredict>();
@@ -0,0 +1,36 @@
+// ATTENTION: The code in this file is highly EXPERIMENTAL.
+// Adventurous users should note that the APIs will probably change.
+
+#pragma once
+
+// Infers the element types and shapes of all values of the graph, so that
+// shape-aware passes listed after it (e.g. fuse_matmul_add_bias_into_gemm)
+// can use them without a round trip through the ModelProto.
+
+#include "onnx/optimizer/pass.h"
+#include "onnx/shape_inference/ir_inference.h"
+
+namespace ONNX_NAMESPACE {
+namespace optimization {
+
+struct InferShapes final : public FullGraphBasedPass {
+  explicit InferShapes()
+      : FullGraphBasedPass(
+            PassType::Other,
+            PassEfficiency::Complete,
+            PassOptimizationType::None) {}
+
+  std::string getPassName() const override {
+    return "infer_shapes";
+  }
+  PassAnalysisType getPassAnalysisType() const override {
+    return PassAnalysisType::Empty;
+  }
+  std::shared_ptr<PostPassAnalysis> runPass(Graph& graph) override {
+    shape_inference::InferShapes(graph);
+    return std::make_shared<PostPassAnalysis>();
+  }
+};
+
+} // namespace optimization
+} // namespace ONNX_NAMESPACE
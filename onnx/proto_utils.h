@@ -3,6 +3,8 @@
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 
+#include <limits>
+
 #include "onnx/onnx_pb.h"
 
 #ifdef ONNX_USE_LITE_PROTO
@@ -27,11 +29,19 @@ inline std::string ProtoDebugString(const Message& proto) {
 
 template <typename Proto>
 bool ParseProtoFromBytes(Proto* proto, const char* buffer, size_t length) {
-  // Total bytes hard limit / warning limit are set to 1GB and 512MB
+  // Total bytes hard limit / warning limit are set to 2GB and 512MB
   // respectively.
+  if (length > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    return false;
+  }
   ::google::protobuf::io::ArrayInputStream input_stream(buffer, static_cast<int>(length));
   ::google::protobuf::io::CodedInputStream coded_stream(&input_stream);
+#if GOOGLE_PROTOBUF_VERSION >= 3011000
+  // Only one parameter is allowed as of protobuf 3.11
+  coded_stream.SetTotalBytesLimit((2048LL << 20) - 1);
+#else
   coded_stream.SetTotalBytesLimit((2048LL << 20) - 1, 512LL << 20);
+#endif
   return proto->ParseFromCodedStream(&coded_stream);
 }
 
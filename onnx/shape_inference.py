@@ -9,7 +9,9 @@ from __future__ import unicode_literals
 
 import onnx
 import onnx.onnx_cpp2py_export.shape_inference as C
-from onnx import ModelProto
+from onnx import ModelProto, ValueInfoProto
+from six import string_types
+from typing import Any, Dict, List, Sequence, Text, Union
 
 """Apply shape inference to the provided ModelProto.
 
@@ -19,18 +21,121 @@ If the inferred values conflict with values already provided in the
 graph, that means that the provided values are invalid (or there is a
 bug in shape inference), and the result is unspecified.
 
+With num_threads > 1, independent nodes of the main graph are inferred
+concurrently. The result, and the error raised for an invalid graph, is
+the same as with a single thread.
+
+With data_prop, the values of small integer tensors computed from shapes
+(Shape, Gather, Slice, Concat, Add, ...) are propagated through the main
+graph, so that e.g. a Reshape to a shape computed from another tensor's
+shape gets an inferred output shape.
+
 Arguments:
-    input (ModelProto,bool): ModelProto
+    input (ModelProto,bool,int,bool): ModelProto
 
 Return:
     return (ModelProto) model with inferred shape information
 """
 
 
-def infer_shapes(model, check_type=False):  # type: (ModelProto,bool) -> ModelProto
+def infer_shapes(model, check_type=False, num_threads=1, data_prop=False):  # type: (ModelProto,bool,int,bool) -> ModelProto
     if not isinstance(model, ModelProto):
         raise TypeError('Shape inference only accepts ModelProto, '
                          'incorrect type: {}'.format(type(model)))
     model_str = model.SerializeToString()
-    inferred_model_str = C.infer_shapes(model_str, check_type)
+    inferred_model_str = C.infer_shapes(model_str, check_type, num_threads, data_prop)
     return onnx.load_from_string(inferred_model_str)
+
+
+"""Apply shape inference to the provided ModelProto for several bindings of
+its inputs to concrete shapes, in a single pass over the graph.
+
+input_shapes is a list of bindings, each a dict from input name to a
+sequence of dims. Inputs missing from a binding keep their declared type.
+The model is not copied or modified.
+
+Arguments:
+    input (ModelProto,list,bool,bool): ModelProto
+
+Return:
+    return (list) for each binding, a list of ValueInfoProto with the
+    inferred types of the node outputs, in node order
+"""
+
+
+def infer_shapes_for_bindings(model, input_shapes, check_type=False, data_prop=False):  # type: (ModelProto, List[Dict[Text, Sequence[int]]], bool, bool) -> List[List[ValueInfoProto]]
+    if not isinstance(model, ModelProto):
+        raise TypeError('Shape inference only accepts ModelProto, '
+                        'incorrect type: {}'.format(type(model)))
+    results = C.infer_shapes_for_bindings(
+        model.SerializeToString(), [dict(b) for b in input_shapes], check_type, data_prop)
+    inferred = []
+    for value_infos in results:
+        inferred.append([ValueInfoProto.FromString(vi) for vi in value_infos])
+    return inferred
+
+
+"""Estimate the cost of running the provided ModelProto.
+
+Shapes are inferred first, then the cost functions of the ops (see
+OpSchema::CostModelFunction) estimate the FLOPs of each node of the main
+graph and the bytes of its inputs and outputs. Inputs with initializer or
+Constant data count as parameters, the others as activations.
+
+Return:
+    return (dict) the totals over the nodes: flops, param_bytes,
+    activation_bytes_read and activation_bytes_written, complete (False if
+    a needed shape was unknown) and num_unestimated_nodes (nodes whose op
+    has no cost function, counted for their bytes only)
+"""
+
+
+def estimate_cost(model):  # type: (ModelProto) -> Dict[Text, Union[int, bool]]
+    if not isinstance(model, ModelProto):
+        raise TypeError('estimate_cost only accepts ModelProto, '
+                        'incorrect type: {}'.format(type(model)))
+    return C.estimate_cost(model.SerializeToString())
+
+
+"""Plan the activation memory of the provided ModelProto.
+
+Shapes are inferred first. Then each tensor of the main graph, graph
+inputs that are not initializers and node outputs, gets its size and its
+lifetime in node indices: from the node producing it (-1 for graph inputs)
+to its last reader (the number of nodes for graph outputs). Nodes are
+assumed to run one at a time in graph order.
+
+The tensors are also placed in a single arena, each in the smallest free
+block that fits, with offsets rounded up to alignment. Tensors with
+overlapping lifetimes never share bytes of the arena.
+
+Return:
+    return (dict) tensors (a list of dicts with name, bytes, first_use,
+    last_use and offset; bytes and offset are -1 if the size is unknown),
+    peak_bytes and peak_node (the largest total size of the tensors live
+    while a node runs, and that node), arena_bytes and complete (False if
+    the size of a tensor is unknown)
+"""
+
+
+def plan_memory(model, alignment=64):  # type: (ModelProto, int) -> Dict[Text, Any]
+    if not isinstance(model, ModelProto):
+        raise TypeError('plan_memory only accepts ModelProto, '
+                        'incorrect type: {}'.format(type(model)))
+    return C.plan_memory(model.SerializeToString(), alignment)
+
+
+"""Apply shape inference to the model stored at model_path.
+
+The model is loaded directly from a memory mapping of the file, so models
+close to the 2GB protobuf limit are not copied through Python. The inferred
+model is written to output_path, or back to model_path if output_path is
+empty.
+"""
+
+
+def infer_shapes_path(model_path, output_path='', check_type=False):  # type: (Text, Text, bool) -> None
+    if not isinstance(model_path, string_types):
+        raise TypeError('infer_shapes_path only accepts model path (String), '
+                        'incorrect type: {}'.format(type(model_path)))
+    C.infer_shapes_path(model_path, output_path, check_type)
@@ -1,5 +1,22 @@
 #include "onnx/shape_inference/implementation.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+
+#include "onnx/common/file_utils.h"
+#include "onnx/defs/cost_functions.h"
+#include "onnx/defs/tensor_proto_util.h"
 #include "onnx/string_utils.h"
 
 namespace ONNX_NAMESPACE {
@@ -155,20 +172,521 @@ void mergeShapesAndTypes(
   }
 }
 
-static void InferShapesImpl(
+DataPropagationContextImpl::DataPropagationContextImpl(
+    const NodeProto& n,
+    const std::unordered_map<std::string, TypeProto*>& valueTypesByName,
+    const std::unordered_map<std::string, const TensorProto*>&
+        inputDataByName,
+    std::unordered_map<std::string, TensorShapeProto>& generatedShapeData)
+    : node_(n),
+      inputDataByName_(inputDataByName),
+      generatedShapeData_(generatedShapeData) {
+  for (const auto& attr : n.attribute()) {
+    attributesByName_[attr.name()] = &attr;
+  }
+  auto lookup = [&valueTypesByName](const std::string& name) {
+    auto iter = valueTypesByName.find(name);
+    return iter == valueTypesByName.end()
+        ? static_cast<const TypeProto*>(nullptr)
+        : iter->second;
+  };
+  for (const auto& input : n.input()) {
+    allInputTypes_.push_back(input.empty() ? nullptr : lookup(input));
+  }
+  for (const auto& output : n.output()) {
+    allOutputTypes_.push_back(output.empty() ? nullptr : lookup(output));
+  }
+}
+
+const TensorShapeProto* DataPropagationContextImpl::getInputData(
+    size_t index) {
+  if (index >= allInputTypes_.size()) {
+    throw std::runtime_error(
+        "input " + ONNX_NAMESPACE::to_string(index) + " is out of bounds");
+  }
+  const std::string& input = node_.input(static_cast<int>(index));
+  auto generated = generatedShapeData_.find(input);
+  if (generated != generatedShapeData_.end()) {
+    return &generated->second;
+  }
+  auto cached = constantInputData_.find(index);
+  if (cached != constantInputData_.end()) {
+    return &cached->second;
+  }
+
+  // Only small 1-D or scalar integer constants take part in shape arithmetic.
+  auto constant = inputDataByName_.find(input);
+  if (constant == inputDataByName_.end()) {
+    return nullptr;
+  }
+  const TensorProto* tensor = constant->second;
+  if (tensor->dims_size() > 1 ||
+      (tensor->dims_size() == 1 && tensor->dims(0) > 1024) ||
+      tensor->data_location() == TensorProto::EXTERNAL) {
+    return nullptr;
+  }
+  std::vector<int64_t> values;
+  if (tensor->data_type() == TensorProto::INT64) {
+    values = ParseData<int64_t>(tensor);
+  } else if (tensor->data_type() == TensorProto::INT32) {
+    const auto data = ParseData<int32_t>(tensor);
+    values.assign(data.begin(), data.end());
+  } else {
+    return nullptr;
+  }
+  TensorShapeProto& value = constantInputData_[index];
+  for (int64_t element : values) {
+    value.add_dim()->set_dim_value(element);
+  }
+  return &value;
+}
+
+void DataPropagationContextImpl::addOutputData(
+    size_t index,
+    TensorShapeProto&& value) {
+  if (index >= allOutputTypes_.size()) {
+    throw std::runtime_error(
+        "output " + ONNX_NAMESPACE::to_string(index) + " is out of bounds");
+  }
+  generatedShapeData_[node_.output(static_cast<int>(index))] =
+      std::move(value);
+}
+
+namespace {
+
+// Threads running batches of independent tasks. The calling thread takes
+// part in every batch, so a pool of n threads starts n - 1 workers.
+class WorkerPool final {
+ public:
+  explicit WorkerPool(int num_threads) {
+    try {
+      for (int i = 1; i < num_threads; ++i) {
+        threads_.emplace_back([this]() { work(); });
+      }
+    } catch (const std::system_error&) {
+      // Out of threads: tasks run on the calling thread instead.
+      stop();
+    }
+  }
+
+  ~WorkerPool() {
+    stop();
+  }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // Calls task(i) for every i < count and returns when all calls are done.
+  // task must not throw.
+  void run(size_t count, const std::function<void(size_t)>& task) {
+    if (threads_.empty() || count < 2) {
+      for (size_t i = 0; i < count; ++i) {
+        task(i);
+      }
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = &task;
+      count_ = count;
+      next_ = 0;
+      active_ = threads_.size();
+      ++generation_;
+    }
+    wake_.notify_all();
+    drain();
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return active_ == 0; });
+    task_ = nullptr;
+  }
+
+ private:
+  // Stops and joins the threads.
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+    threads_.clear();
+  }
+
+  void work() {
+    uint64_t seen = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+        if (stop_) {
+          return;
+        }
+        seen = generation_;
+      }
+      drain();
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--active_ == 0) {
+        done_.notify_one();
+      }
+    }
+  }
+
+  void drain() {
+    for (size_t i = next_++; i < count_; i = next_++) {
+      (*task_)(i);
+    }
+  }
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void(size_t)>* task_ = nullptr;
+  size_t count_ = 0;
+  std::atomic<size_t> next_{0};
+  size_t active_ = 0;
+  uint64_t generation_ = 0;
+  bool stop_ = false;
+};
+
+// Type of a node output without value_info, inferred in wavefront order. It
+// is added to the graph once all nodes are done.
+struct PendingValueInfo {
+  int node_index;
+  std::string name;
+  TypeProto type;
+};
+
+// Group the nodes of g in wavefronts: each node is placed right after the
+// wavefront that produces the last of its inputs. Nodes with graph attributes
+// may read any earlier value from their subgraphs, so they are placed after
+// all earlier nodes. Returns false if g is not in SSA form or not
+// topologically sorted, since the result would then depend on node order.
+bool levelizeNodes(const GraphProto& g, std::vector<std::vector<int>>* levels) {
+  std::unordered_map<std::string, int> producers;
+  for (int i = 0; i < g.node_size(); ++i) {
+    for (const auto& output : g.node(i).output()) {
+      if (!output.empty() && !producers.emplace(output, i).second) {
+        return false;
+      }
+    }
+  }
+
+  std::vector<int> node_levels(g.node_size());
+  int max_level = -1;
+  for (int i = 0; i < g.node_size(); ++i) {
+    const auto& n = g.node(i);
+    int level = 0;
+    for (const auto& attr : n.attribute()) {
+      if (attr.has_g() || attr.graphs_size() > 0) {
+        level = max_level + 1;
+        break;
+      }
+    }
+    for (const auto& input : n.input()) {
+      auto producer = producers.find(input);
+      if (producer == producers.end()) {
+        continue;
+      }
+      if (producer->second >= i) {
+        return false;
+      }
+      level = std::max(level, node_levels[producer->second] + 1);
+    }
+    node_levels[i] = level;
+    max_level = std::max(max_level, level);
+  }
+
+  levels->assign(max_level + 1, std::vector<int>());
+  for (int i = 0; i < g.node_size(); ++i) {
+    (*levels)[node_levels[i]].push_back(i);
+  }
+  return true;
+}
+
+// Run the inference function of schema, the resolved schema of the node of
+// ctx. Returns the schema if the inferred output types are to be merged into
+// the graph, or nullptr if the node is skipped.
+const OpSchema* inferNode(
+    InferenceContextImpl& ctx,
+    const OpSchema* schema,
+    const ISchemaRegistry* schema_registry,
+    FunctionInferenceCache* function_cache) {
+  if (!schema) {
+    return nullptr;
+  } else if (schema->has_type_and_shape_inference_function()) {
+    try {
+      schema->GetTypeAndShapeInferenceFunction()(ctx);
+    } catch (const ONNX_NAMESPACE::InferenceError& ex) {
+      (void)ex;
+      // Continue with inference for remaining nodes
+      return nullptr;
+    }
+  } else if (schema->HasFunction()) {
+    try {
+      InferShapeForFunctionNode(
+          schema->GetFunction(), schema_registry, ctx, function_cache);
+    } catch (const ONNX_NAMESPACE::InferenceError& function_ex) {
+      (void)function_ex;
+      return nullptr;
+    }
+  } else {
+    // Continue with inference for remaining nodes
+    return nullptr;
+  }
+  return schema;
+}
+
+// Merge the output types inferred for n, node node_index of its graph, into
+// valueTypesByName. Outputs without value_info get a new entry in pending if
+// it is not null, or else in g.
+void mergeInferredTypes(
+    const NodeProto& n,
+    int node_index,
+    const OpSchema* schema,
+    InferenceContextImpl& ctx,
+    std::unordered_map<std::string, TypeProto*>& valueTypesByName,
+    bool check_type,
     GraphProto* g,
-    const std::unordered_map<std::string, TypeProto*>&
-        outer_scope_value_types_by_name,
+    std::deque<PendingValueInfo>* pending) {
+  try {
+    if (check_type) {
+      schema->CheckInputOutputType(ctx);
+    }
+    for (int i = 0; i < n.output_size(); ++i) {
+      const auto* inferredType = ctx.getOutputType(i);
+      if (!inferredType->has_tensor_type() &&
+          !inferredType->has_sequence_type()) {
+        continue;
+      }
+
+      if (inferredType->has_tensor_type()) {
+        const auto& inferredTensorType = inferredType->tensor_type();
+
+        // Bail out early if shape inference does nothing useful.
+        if (inferredTensorType.elem_type() == TensorProto::UNDEFINED &&
+            !inferredTensorType.has_shape()) {
+          continue;
+        }
+      }
+
+      // Find any pre-existing type and shape info. If there is such,
+      // then check for compatibility with the inferred
+      // information. Otherwise, initialize it in an empty state.
+      auto iter = valueTypesByName.find(n.output(i));
+      TypeProto* existingType = nullptr;
+      if (iter != valueTypesByName.end()) {
+        existingType = iter->second;
+        checkShapesAndTypes(*inferredType, *existingType);
+      } else if (pending) {
+        pending->push_back(
+            PendingValueInfo{node_index, n.output(i), TypeProto()});
+        existingType = &pending->back().type;
+      } else {
+        auto vi = g->add_value_info();
+        vi->set_name(n.output(i));
+        existingType = vi->mutable_type();
+      }
+
+      // Now we can merge pre-existing and inferred info, without
+      // further need for error-checking.
+      mergeShapesAndTypes(*inferredType, existingType);
+
+      // Make merged info available to further inference.
+      valueTypesByName[n.output(i)] = existingType;
+    }
+  } catch (const std::runtime_error& err) {
+    std::string op_name = n.has_name() ? n.name() : "no name";
+    std::cerr << "(op_type:" << n.op_type() << ", name:" << n.name() << "): " << err.what() << '\n';
+    throw;
+  }
+}
+
+// Values computed by data propagation in the main graph.
+struct DataPropagationState {
+  std::unordered_map<std::string, TensorShapeProto> generatedShapeData;
+  // Fully known values, as tensors for InferenceContext::getInputData.
+  std::unordered_map<std::string, TensorProto> generatedTensors;
+};
+
+// Run the data propagation function of n's schema, and make the fully known
+// output values available as input data of later nodes.
+void propagateData(
+    const NodeProto& n,
+    const OpSchema* schema,
+    const std::unordered_map<std::string, TypeProto*>& valueTypesByName,
+    std::unordered_map<std::string, const TensorProto*>& inputDataByName,
+    DataPropagationState& state) {
+  if (!schema->has_data_propagation_function()) {
+    return;
+  }
+  DataPropagationContextImpl ctx(
+      n, valueTypesByName, inputDataByName, state.generatedShapeData);
+  try {
+    schema->GetDataPropagationFunction()(ctx);
+  } catch (const ONNX_NAMESPACE::InferenceError& ex) {
+    (void)ex;
+    return;
+  }
+
+  for (int i = 0; i < n.output_size(); ++i) {
+    const std::string& output = n.output(i);
+    auto value = state.generatedShapeData.find(output);
+    const TypeProto* type = ctx.getOutputType(i);
+    if (value == state.generatedShapeData.end() || type == nullptr ||
+        inputDataByName.count(output)) {
+      continue;
+    }
+    std::vector<int64_t> elements;
+    for (const auto& dim : value->second.dim()) {
+      if (!dim.has_dim_value()) {
+        break;
+      }
+      elements.push_back(dim.dim_value());
+    }
+    const auto& tensor_type = type->tensor_type();
+    if (elements.size() != static_cast<size_t>(value->second.dim_size()) ||
+        (tensor_type.shape().dim_size() == 0 && elements.size() != 1)) {
+      continue;
+    }
+    TensorProto& tensor = state.generatedTensors[output];
+    tensor.set_data_type(tensor_type.elem_type());
+    if (tensor_type.shape().dim_size() == 1) {
+      tensor.add_dims(static_cast<int64_t>(elements.size()));
+    }
+    for (int64_t element : elements) {
+      if (tensor_type.elem_type() == TensorProto::INT32) {
+        tensor.add_int32_data(static_cast<int32_t>(element));
+      } else {
+        tensor.add_int64_data(element);
+      }
+    }
+    inputDataByName[output] = &tensor;
+  }
+}
+
+// Infer the nodes of g wavefront by wavefront. The inference functions of a
+// wavefront only read types produced by earlier ones, so they run
+// concurrently; their results are then merged on this thread in node order.
+// Once a node fails, only nodes before it are still inferred, and the error
+// of the first failing node is thrown, as with sequential inference.
+void inferWavefronts(
+    GraphProto* g,
+    const std::vector<std::vector<int>>& levels,
+    std::unordered_map<std::string, TypeProto*>& valueTypesByName,
+    std::unordered_map<std::string, const TensorProto*>& inputDataByName,
+    GraphInferenceContext& graphInferenceContext,
     const std::unordered_map<std::string, int>& opset_imports,
-    bool check_type,
-    const ISchemaRegistry* schema_registry = OpSchemaRegistry::Instance()
-    ) {
-  std::unordered_map<std::string, TypeProto*> valueTypesByName{
-      outer_scope_value_types_by_name};
+    const ShapeInferenceOptions& options,
+    DataPropagationState* dataPropagation,
+    const ISchemaRegistry* schema_registry) {
+  WorkerPool pool(options.num_threads);
+  std::deque<PendingValueInfo> pending;
+  std::vector<std::unique_ptr<InferenceContextImpl>> contexts;
+  std::vector<const OpSchema*> schemas;
+  std::vector<std::exception_ptr> errors;
+  // The first failing node, in node order, and its error.
+  int failedNode = g->node_size();
+  std::exception_ptr failure;
+  // Schemas are resolved on this thread, as the cache is not thread-safe.
+  SchemaResolutionCache resolvedSchemas(opset_imports, schema_registry);
+  for (const auto& level : levels) {
+    if (level.front() >= failedNode) {
+      continue;
+    }
+    // Contexts are reused by the nodes in the same position of later levels.
+    while (contexts.size() < level.size()) {
+      contexts.emplace_back(new InferenceContextImpl(&graphInferenceContext));
+    }
+    schemas.resize(level.size());
+    for (size_t i = 0; i < level.size() && level[i] < failedNode; ++i) {
+      const NodeProto& n = g->node(level[i]);
+      schemas[i] = resolvedSchemas.GetSchema(n.op_type(), n.domain());
+    }
+    errors.assign(level.size(), nullptr);
+    pool.run(level.size(), [&](size_t i) {
+      if (level[i] >= failedNode) {
+        return;
+      }
+      try {
+        NodeProto& n = *g->mutable_node(level[i]);
+        contexts[i]->reset(
+            n,
+            graphInferenceContext.outer_scope,
+            inputDataByName,
+            dataPropagation ? &dataPropagation->generatedShapeData : nullptr);
+        schemas[i] = inferNode(
+            *contexts[i],
+            schemas[i],
+            schema_registry,
+            graphInferenceContext.function_cache);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+    for (size_t i = 0; i < level.size() && level[i] < failedNode; ++i) {
+      try {
+        if (errors[i]) {
+          std::rethrow_exception(errors[i]);
+        }
+        if (schemas[i]) {
+          mergeInferredTypes(
+              g->node(level[i]),
+              level[i],
+              schemas[i],
+              *contexts[i],
+              valueTypesByName,
+              options.check_type,
+              g,
+              &pending);
+          if (dataPropagation) {
+            propagateData(
+                g->node(level[i]),
+                schemas[i],
+                valueTypesByName,
+                inputDataByName,
+                *dataPropagation);
+          }
+        }
+      } catch (...) {
+        failedNode = level[i];
+        failure = std::current_exception();
+      }
+    }
+  }
 
-  GraphInferenceContext graphInferenceContext{
-      valueTypesByName, opset_imports, schema_registry};
+  // Add value_info in node order, as sequential inference does, up to the
+  // node that failed.
+  std::vector<PendingValueInfo*> ordered;
+  for (auto& value_info : pending) {
+    if (value_info.node_index <= failedNode) {
+      ordered.push_back(&value_info);
+    }
+  }
+  std::stable_sort(
+      ordered.begin(),
+      ordered.end(),
+      [](const PendingValueInfo* a, const PendingValueInfo* b) {
+        return a->node_index < b->node_index;
+      });
+  for (auto* value_info : ordered) {
+    auto vi = g->add_value_info();
+    vi->set_name(value_info->name);
+    vi->mutable_type()->Swap(&value_info->type);
+  }
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+}
 
+void collectValueTypes(
+    GraphProto* g,
+    std::unordered_map<std::string, TypeProto*>& valueTypesByName) {
+  valueTypesByName.reserve(
+      valueTypesByName.size() + g->value_info_size() + g->input_size() +
+      g->output_size() + g->node_size());
   for (auto& vi : *g->mutable_value_info()) {
     if (vi.has_type())
       valueTypesByName[vi.name()] = vi.mutable_type();
@@ -181,13 +699,16 @@ static void InferShapesImpl(
     if (vi.has_type())
       valueTypesByName[vi.name()] = vi.mutable_type();
   }
+}
 
-  std::unordered_map<std::string, const TensorProto*> inputDataByName;
-  for (const auto& tp : g->initializer()) {
+void collectInputData(
+    const GraphProto& g,
+    std::unordered_map<std::string, const TensorProto*>& inputDataByName) {
+  for (const auto& tp : g.initializer()) {
     inputDataByName[tp.name()] = &tp;
   }
   // Collect data from constant nodes.
-  for (const auto& n : g->node()) {
+  for (const auto& n : g.node()) {
       if (n.op_type() != "Constant" || n.output().size() != 1) {
           continue;
       }
@@ -199,88 +720,176 @@ static void InferShapesImpl(
           }
       }
   }
+}
 
-  for (auto& n : *g->mutable_node()) {
-    // Resolve domain for node
-    auto dit = opset_imports.find(n.domain());
-    if (dit == opset_imports.end()) {
-      continue;
+// Add the names of all node inputs in the graph attributes of n, including
+// nested ones, to names. This is a superset of the outer scope values the
+// subgraphs read.
+void collectSubgraphInputs(
+    const NodeProto& n,
+    std::unordered_set<std::string>& names) {
+  for (const auto& attr : n.attribute()) {
+    auto collect = [&names](const GraphProto& graph) {
+      for (const auto& node : graph.node()) {
+        names.insert(node.input().begin(), node.input().end());
+        collectSubgraphInputs(node, names);
+      }
+    };
+    if (attr.has_g()) {
+      collect(attr.g());
+    }
+    for (const auto& graph : attr.graphs()) {
+      collect(graph);
+    }
+  }
+}
+
+// Drop the types inferred for the subgraphs of n, recursively.
+void clearSubgraphValueInfo(NodeProto& n) {
+  for (auto& attr : *n.mutable_attribute()) {
+    auto clear = [](GraphProto& graph) {
+      graph.clear_value_info();
+      for (auto& node : *graph.mutable_node()) {
+        clearSubgraphValueInfo(node);
+      }
+    };
+    if (attr.has_g()) {
+      clear(*attr.mutable_g());
     }
-    auto domain_version = dit->second;
+    for (auto& graph : *attr.mutable_graphs()) {
+      clear(graph);
+    }
+  }
+}
 
-    const auto schema =
-        schema_registry->GetSchema(n.op_type(), domain_version, n.domain());
-    InferenceContextImpl ctx(
-        n, valueTypesByName, inputDataByName, &graphInferenceContext);
-    if (!schema) {
-      continue;
-    } else if (schema->has_type_and_shape_inference_function()){
-      try {
-        schema->GetTypeAndShapeInferenceFunction()(ctx);
-      } catch (const ONNX_NAMESPACE::InferenceError& ex) {
-        (void)ex;
-        // Continue with inference for remaining nodes
-        continue;
+// Best-fit allocation of blocks of one arena, which grows when no free
+// block fits. Released blocks are merged with their free neighbours.
+class ArenaAllocator {
+ public:
+  int64_t allocate(int64_t size) {
+    auto best = free_.end();
+    for (auto it = free_.begin(); it != free_.end(); ++it) {
+      if (it->second >= size &&
+          (best == free_.end() || it->second < best->second)) {
+        best = it;
       }
-    } else if (schema->HasFunction()) {
-      try {
-        InferShapeForFunctionNode(
-          schema->GetFunction(), schema_registry, ctx);
-      } catch (const ONNX_NAMESPACE::InferenceError& function_ex) {
-        (void)function_ex;
-        continue;
+    }
+    if (best == free_.end()) {
+      int64_t offset = size_;
+      if (!free_.empty()) {
+        auto last = std::prev(free_.end());
+        if (last->first + last->second == size_) {
+          offset = last->first;
+          free_.erase(last);
+        }
       }
-    } else {
-      // Continue with inference for remaining nodes
-      continue;
-	}
+      size_ = offset + size;
+      return offset;
+    }
+    int64_t offset = best->first;
+    int64_t remaining = best->second - size;
+    free_.erase(best);
+    if (remaining > 0) {
+      free_[offset + size] = remaining;
+    }
+    return offset;
+  }
 
-    try {
-      if (check_type) {
-        schema->CheckInputOutputType(ctx);
+  void release(int64_t offset, int64_t size) {
+    auto next = free_.lower_bound(offset);
+    if (next != free_.end() && offset + size == next->first) {
+      size += next->second;
+      next = free_.erase(next);
+    }
+    if (next != free_.begin()) {
+      auto prev = std::prev(next);
+      if (prev->first + prev->second == offset) {
+        prev->second += size;
+        return;
       }
-      for (int i = 0; i < n.output_size(); ++i) {
-        const auto* inferredType = ctx.getOutputType(i);
-        if (!inferredType->has_tensor_type() &&
-            !inferredType->has_sequence_type()) {
-          continue;
-        }
+    }
+    free_[offset] = size;
+  }
 
-        if (inferredType->has_tensor_type()) {
-          const auto& inferredTensorType = inferredType->tensor_type();
+  int64_t size() const {
+    return size_;
+  }
 
-          // Bail out early if shape inference does nothing useful.
-          if (inferredTensorType.elem_type() == TensorProto::UNDEFINED &&
-              !inferredTensorType.has_shape()) {
-            continue;
-          }
-        }
+ private:
+  // Free blocks by offset.
+  std::map<int64_t, int64_t> free_;
+  int64_t size_ = 0;
+};
 
-        // Find any pre-existing type and shape info. If there is such,
-        // then check for compatibility with the inferred
-        // information. Otherwise, initialize it in an empty state.
-        auto iter = valueTypesByName.find(n.output(i));
-        TypeProto* existingType = nullptr;
-        if (iter != valueTypesByName.end()) {
-          existingType = iter->second;
-          checkShapesAndTypes(*inferredType, *existingType);
-        } else {
-          auto vi = g->add_value_info();
-          vi->set_name(n.output(i));
-          existingType = vi->mutable_type();
-        }
+} // namespace
 
-        // Now we can merge pre-existing and inferred info, without
-        // further need for error-checking.
-        mergeShapesAndTypes(*inferredType, existingType);
+// Infer the nodes of g. valueTypesByName only holds the types of g's own
+// values; those of the enclosing graphs are looked up in outer_scope, which
+// is null for a main graph.
+static void InferShapesImpl(
+    GraphProto* g,
+    const ValueTypeScope* outer_scope,
+    const std::unordered_map<std::string, int>& opset_imports,
+    const ShapeInferenceOptions& options,
+    const ISchemaRegistry* schema_registry = OpSchemaRegistry::Instance(),
+    FunctionInferenceCache* function_cache = nullptr) {
+  std::unordered_map<std::string, TypeProto*> valueTypesByName;
 
-        // Make merged info available to further inference.
-        valueTypesByName[n.output(i)] = existingType;
+  // Nodes, and the graph attributes of nodes, see the values of g and of
+  // its enclosing graphs.
+  GraphInferenceContext graphInferenceContext{
+      ValueTypeScope(&valueTypesByName, outer_scope),
+      opset_imports,
+      schema_registry};
+  FunctionInferenceCache mainGraphFunctionCache;
+  graphInferenceContext.function_cache =
+      function_cache ? function_cache : &mainGraphFunctionCache;
+
+  collectValueTypes(g, valueTypesByName);
+
+  std::unordered_map<std::string, const TensorProto*> inputDataByName;
+  collectInputData(*g, inputDataByName);
+
+  DataPropagationState dataPropagationState;
+  DataPropagationState* dataPropagation =
+      options.enable_data_propagation ? &dataPropagationState : nullptr;
+
+  std::vector<std::vector<int>> levels;
+  if (options.num_threads > 1 && levelizeNodes(*g, &levels)) {
+    inferWavefronts(
+        g,
+        levels,
+        valueTypesByName,
+        inputDataByName,
+        graphInferenceContext,
+        opset_imports,
+        options,
+        dataPropagation,
+        schema_registry);
+    return;
+  }
+
+  SchemaResolutionCache resolvedSchemas(opset_imports, schema_registry);
+  InferenceContextImpl ctx(&graphInferenceContext);
+  for (int i = 0; i < g->node_size(); ++i) {
+    NodeProto& n = *g->mutable_node(i);
+    ctx.reset(
+        n,
+        graphInferenceContext.outer_scope,
+        inputDataByName,
+        dataPropagation ? &dataPropagation->generatedShapeData : nullptr);
+    const OpSchema* schema = inferNode(
+        ctx,
+        resolvedSchemas.GetSchema(n.op_type(), n.domain()),
+        schema_registry,
+        graphInferenceContext.function_cache);
+    if (schema) {
+      mergeInferredTypes(
+          n, i, schema, ctx, valueTypesByName, options.check_type, g, nullptr);
+      if (dataPropagation) {
+        propagateData(
+            n, schema, valueTypesByName, inputDataByName, *dataPropagation);
       }
-    } catch (const std::runtime_error& err) {
-      std::string op_name = n.has_name() ? n.name() : "no name";
-      std::cerr << "(op_type:" << n.op_type() << ", name:" << n.name() << "): " << err.what() << '\n';
-      throw;
     }
   }
 }
@@ -291,19 +900,38 @@ void InferShapes(
     bool check_type,
     const ISchemaRegistry* schema_registry
     ) {
+  ShapeInferenceOptions options;
+  options.check_type = check_type;
+  InferShapes(g, opset_imports, options, schema_registry);
+}
+
+void InferShapes(
+    ModelProto& m,
+    bool check_type,
+    const ISchemaRegistry* schema_registry
+    ) {
+  ShapeInferenceOptions options;
+  options.check_type = check_type;
+  InferShapes(m, options, schema_registry);
+}
+
+void InferShapes(
+    GraphProto* g,
+    const std::unordered_map<std::string, int>& opset_imports,
+    const ShapeInferenceOptions& options,
+    const ISchemaRegistry* schema_registry) {
   InferShapesImpl(
       g,
-      std::unordered_map<std::string, TypeProto*>(0),
+      nullptr,
       opset_imports,
-      check_type,
+      options,
       schema_registry);
 }
 
 void InferShapes(
     ModelProto& m,
-    bool check_type,
-    const ISchemaRegistry* schema_registry
-    ) {
+    const ShapeInferenceOptions& options,
+    const ISchemaRegistry* schema_registry) {
   std::unordered_map<std::string, int> opset_imports;
   for (const auto& opset_import : m.opset_import()) {
     opset_imports[opset_import.domain()] =
@@ -312,13 +940,532 @@ void InferShapes(
   auto* g = m.mutable_graph();
   InferShapesImpl(
       g,
-      std::unordered_map<std::string, TypeProto*>(0),
+      nullptr,
       opset_imports,
-      check_type,
+      options,
       schema_registry);
 }
 
-void InferShapeForFunctionNode(
+size_t InferShapesIncremental(
+    ModelProto& m,
+    const std::vector<std::string>& changed_values,
+    const ShapeInferenceOptions& options,
+    const ISchemaRegistry* schema_registry) {
+  std::unordered_map<std::string, int> opset_imports;
+  for (const auto& opset_import : m.opset_import()) {
+    opset_imports[opset_import.domain()] =
+        static_cast<int>(opset_import.version());
+  }
+  auto* g = m.mutable_graph();
+
+  std::unordered_map<std::string, TypeProto*> valueTypesByName;
+  GraphInferenceContext graphInferenceContext{
+      valueTypesByName, opset_imports, schema_registry};
+  FunctionInferenceCache functionCache;
+  graphInferenceContext.function_cache = &functionCache;
+  collectValueTypes(g, valueTypesByName);
+  std::unordered_map<std::string, const TensorProto*> inputDataByName;
+  collectInputData(*g, inputDataByName);
+
+  // Types of graph inputs and outputs are declared by the model and kept;
+  // the entries of value_info hold the results of earlier inference and are
+  // replaced when re-inferred.
+  std::unordered_set<std::string> declared;
+  for (const auto& vi : g->input()) {
+    declared.insert(vi.name());
+  }
+  for (const auto& vi : g->output()) {
+    declared.insert(vi.name());
+  }
+
+  // Nodes are visited in graph order, so the producer of a changed value is
+  // always visited before its consumers.
+  std::unordered_set<std::string> changed(
+      changed_values.begin(), changed_values.end());
+  std::unordered_map<std::string, TypeProto*> replacedTypes;
+  std::deque<PendingValueInfo> pending;
+  std::unordered_set<std::string> subgraphInputs;
+  std::vector<std::string> previousTypes;
+  size_t reinferred = 0;
+  SchemaResolutionCache resolvedSchemas(opset_imports, schema_registry);
+  InferenceContextImpl ctx(&graphInferenceContext);
+  for (int i = 0; i < g->node_size(); ++i) {
+    NodeProto& n = *g->mutable_node(i);
+    bool dirty = false;
+    for (const auto& input : n.input()) {
+      dirty = dirty || changed.count(input);
+    }
+    for (const auto& output : n.output()) {
+      dirty = dirty || changed.count(output);
+    }
+    if (!dirty && n.attribute_size() > 0) {
+      subgraphInputs.clear();
+      collectSubgraphInputs(n, subgraphInputs);
+      for (const auto& input : subgraphInputs) {
+        dirty = dirty || changed.count(input);
+      }
+    }
+    if (!dirty) {
+      continue;
+    }
+
+    ++reinferred;
+    previousTypes.assign(n.output_size(), std::string());
+    for (int k = 0; k < n.output_size(); ++k) {
+      const std::string& output = n.output(k);
+      auto iter = valueTypesByName.find(output);
+      if (iter == valueTypesByName.end()) {
+        continue;
+      }
+      previousTypes[k] = iter->second->SerializeAsString();
+      if (!declared.count(output)) {
+        replacedTypes[output] = iter->second;
+        valueTypesByName.erase(iter);
+      }
+    }
+    clearSubgraphValueInfo(n);
+
+    ctx.reset(n, graphInferenceContext.outer_scope, inputDataByName);
+    const OpSchema* schema = inferNode(
+        ctx,
+        resolvedSchemas.GetSchema(n.op_type(), n.domain()),
+        schema_registry,
+        &functionCache);
+    if (schema) {
+      mergeInferredTypes(
+          n, i, schema, ctx, valueTypesByName, options.check_type, g, &pending);
+    }
+
+    // Propagate only past outputs whose type changed.
+    for (int k = 0; k < n.output_size(); ++k) {
+      auto iter = valueTypesByName.find(n.output(k));
+      std::string type = iter == valueTypesByName.end()
+          ? std::string()
+          : iter->second->SerializeAsString();
+      if (type != previousTypes[k]) {
+        changed.insert(n.output(k));
+      }
+    }
+  }
+
+  // Re-inferred types replace their old value_info entries in place; values
+  // that no longer have a type lose their entry.
+  for (auto& value_info : pending) {
+    auto replaced = replacedTypes.find(value_info.name);
+    if (replaced != replacedTypes.end()) {
+      replaced->second->Swap(&value_info.type);
+      replacedTypes.erase(replaced);
+    } else {
+      auto vi = g->add_value_info();
+      vi->set_name(value_info.name);
+      vi->mutable_type()->Swap(&value_info.type);
+    }
+  }
+  if (!replacedTypes.empty()) {
+    auto* value_infos = g->mutable_value_info();
+    int kept = 0;
+    for (int i = 0; i < value_infos->size(); ++i) {
+      if (!replacedTypes.count(value_infos->Get(i).name())) {
+        value_infos->SwapElements(kept++, i);
+      }
+    }
+    while (value_infos->size() > kept) {
+      value_infos->RemoveLast();
+    }
+  }
+  return reinferred;
+}
+
+namespace {
+
+// The types of the main graph inferred for one binding, with everything
+// inference of a node needs besides the node itself.
+struct BindingState {
+  BindingState(
+      const std::unordered_map<std::string, int>& opset_imports,
+      const ISchemaRegistry* schema_registry)
+      : graphInferenceContext{
+            ValueTypeScope(&valueTypesByName),
+            opset_imports,
+            schema_registry},
+        subgraphContext{&graphInferenceContext} {}
+
+  // The types of the graph inputs and outputs, copied from the model.
+  std::deque<TypeProto> declaredTypes;
+  std::unordered_map<std::string, TypeProto*> valueTypesByName;
+  // The inferred types of the other node outputs.
+  std::deque<PendingValueInfo> inferredTypes;
+  std::unordered_map<std::string, const TensorProto*> inputDataByName;
+  DataPropagationState dataPropagation;
+  GraphInferenceContext graphInferenceContext;
+  // The context of the nodes with graph attributes, which are copied.
+  InferenceContextImpl subgraphContext;
+  NodeProto nodeCopy;
+};
+
+bool hasGraphAttribute(const NodeProto& n) {
+  for (const auto& attr : n.attribute()) {
+    if (attr.has_g() || attr.graphs_size() > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+std::vector<std::vector<ValueInfoProto>> InferShapesForBindings(
+    const ModelProto& m,
+    const std::vector<InputShapeBinding>& bindings,
+    const ShapeInferenceOptions& options,
+    const ISchemaRegistry* schema_registry) {
+  std::unordered_map<std::string, int> opset_imports;
+  for (const auto& opset_import : m.opset_import()) {
+    opset_imports[opset_import.domain()] =
+        static_cast<int>(opset_import.version());
+  }
+  // Nodes are only read, but for those with graph attributes, which are
+  // copied.
+  const GraphProto* g = &m.graph();
+  std::unordered_map<std::string, const TensorProto*> inputDataByName;
+  collectInputData(*g, inputDataByName);
+
+  // Shared by the bindings, which often have some input types in common, and
+  // by the subgraphs inferred for them.
+  FunctionInferenceCache functionCache;
+  std::vector<std::unique_ptr<BindingState>> states;
+  for (size_t b = 0; b < bindings.size(); ++b) {
+    states.emplace_back(new BindingState(opset_imports, schema_registry));
+    auto& state = *states.back();
+    state.graphInferenceContext.function_cache = &functionCache;
+    for (const auto& binding : bindings[b]) {
+      if (std::none_of(
+              g->input().begin(),
+              g->input().end(),
+              [&binding](const ValueInfoProto& vi) {
+                return vi.name() == binding.first;
+              })) {
+        fail_shape_inference(
+            "Binding ", b, " has a shape for unknown input ", binding.first);
+      }
+    }
+    for (const auto* value_infos : {&g->input(), &g->output()}) {
+      for (const auto& vi : *value_infos) {
+        if (!vi.has_type()) {
+          continue;
+        }
+        state.declaredTypes.push_back(vi.type());
+        TypeProto* type = &state.declaredTypes.back();
+        auto bound = bindings[b].find(vi.name());
+        if (value_infos == &g->input() && bound != bindings[b].end()) {
+          if (!type->has_tensor_type()) {
+            fail_shape_inference(
+                "Binding ", b, " has a shape for non-tensor input ", vi.name());
+          }
+          TypeProto boundType;
+          boundType.mutable_tensor_type()->set_elem_type(
+              type->tensor_type().elem_type());
+          *boundType.mutable_tensor_type()->mutable_shape() = bound->second;
+          checkShapesAndTypes(boundType, *type);
+          *type->mutable_tensor_type()->mutable_shape() = bound->second;
+        }
+        state.valueTypesByName[vi.name()] = type;
+      }
+    }
+    state.inputDataByName = inputDataByName;
+  }
+
+  SchemaResolutionCache resolvedSchemas(opset_imports, schema_registry);
+  InferenceContextImpl ctx;
+  for (int i = 0; i < g->node_size(); ++i) {
+    const NodeProto& n = g->node(i);
+    const OpSchema* schema =
+        resolvedSchemas.GetSchema(n.op_type(), n.domain());
+    if (!schema) {
+      continue;
+    }
+    const bool copied = hasGraphAttribute(n);
+    if (!copied) {
+      ctx.resetAttributes(n);
+    }
+    for (auto& statePtr : states) {
+      auto& state = *statePtr;
+      auto* generatedShapeData = options.enable_data_propagation
+          ? &state.dataPropagation.generatedShapeData
+          : nullptr;
+      InferenceContextImpl* nodeCtx = &ctx;
+      if (copied) {
+        state.nodeCopy = n;
+        nodeCtx = &state.subgraphContext;
+        nodeCtx->reset(
+            state.nodeCopy,
+            state.graphInferenceContext.outer_scope,
+            state.inputDataByName,
+            generatedShapeData);
+      } else {
+        ctx.resetTypes(
+            n,
+            state.graphInferenceContext.outer_scope,
+            state.inputDataByName,
+            generatedShapeData);
+      }
+      if (!inferNode(*nodeCtx, schema, schema_registry, &functionCache)) {
+        continue;
+      }
+      mergeInferredTypes(
+          n,
+          i,
+          schema,
+          *nodeCtx,
+          state.valueTypesByName,
+          options.check_type,
+          nullptr,
+          &state.inferredTypes);
+      if (options.enable_data_propagation) {
+        propagateData(
+            n,
+            schema,
+            state.valueTypesByName,
+            state.inputDataByName,
+            state.dataPropagation);
+      }
+    }
+  }
+
+  std::vector<std::vector<ValueInfoProto>> results(states.size());
+  for (size_t b = 0; b < states.size(); ++b) {
+    const auto& valueTypesByName = states[b]->valueTypesByName;
+    for (const auto& n : g->node()) {
+      for (const auto& output : n.output()) {
+        auto type = valueTypesByName.find(output);
+        if (type == valueTypesByName.end()) {
+          continue;
+        }
+        results[b].emplace_back();
+        results[b].back().set_name(output);
+        *results[b].back().mutable_type() = *type->second;
+      }
+    }
+  }
+  return results;
+}
+
+GraphCost EstimateCost(
+    const ModelProto& m,
+    const ISchemaRegistry* schema_registry) {
+  std::unordered_map<std::string, int> opset_imports;
+  for (const auto& opset_import : m.opset_import()) {
+    opset_imports[opset_import.domain()] =
+        static_cast<int>(opset_import.version());
+  }
+  const GraphProto& g = m.graph();
+
+  // The declared types, copied as the model is only read. Initializers need
+  // not be graph inputs, and then have no declared type.
+  std::deque<TypeProto> declaredTypes;
+  std::unordered_map<std::string, TypeProto*> valueTypesByName;
+  for (const auto* value_infos : {&g.value_info(), &g.input(), &g.output()}) {
+    for (const auto& vi : *value_infos) {
+      if (vi.has_type()) {
+        declaredTypes.push_back(vi.type());
+        valueTypesByName[vi.name()] = &declaredTypes.back();
+      }
+    }
+  }
+  for (const auto& tp : g.initializer()) {
+    if (valueTypesByName.count(tp.name())) {
+      continue;
+    }
+    declaredTypes.emplace_back();
+    auto* tensor_type = declaredTypes.back().mutable_tensor_type();
+    tensor_type->set_elem_type(tp.data_type());
+    auto* shape = tensor_type->mutable_shape();
+    for (int64_t dim : tp.dims()) {
+      shape->add_dim()->set_dim_value(dim);
+    }
+    valueTypesByName[tp.name()] = &declaredTypes.back();
+  }
+  const ValueTypeScope valueTypes(&valueTypesByName);
+  std::unordered_map<std::string, const TensorProto*> inputDataByName;
+  collectInputData(g, inputDataByName);
+  SchemaResolutionCache resolvedSchemas(opset_imports, schema_registry);
+
+  GraphCost cost;
+  cost.nodes.reserve(g.node_size());
+  InferenceContextImpl ctx;
+  for (const auto& n : g.node()) {
+    ctx.reset(n, valueTypes, inputDataByName);
+    bool typed = true;
+    for (const auto& input : n.input()) {
+      typed = typed && (input.empty() || valueTypes.find(input) != nullptr);
+    }
+    for (int i = 0; i < n.output_size(); ++i) {
+      if (n.output(i).empty()) {
+        continue;
+      }
+      const TypeProto* type = valueTypes.find(n.output(i));
+      if (type != nullptr) {
+        ctx.getOutputType(i)->CopyFrom(*type);
+      } else {
+        typed = false;
+      }
+    }
+
+    const OpSchema* schema =
+        resolvedSchemas.GetSchema(n.op_type(), n.domain());
+    OpCost nodeCost;
+    if (schema != nullptr && schema->has_cost_function()) {
+      nodeCost = schema->GetCostFunction()(ctx);
+    } else {
+      nodeCost = dataMovementCost(ctx);
+      ++cost.num_unestimated_nodes;
+    }
+    nodeCost.complete = nodeCost.complete && typed;
+    cost.total += nodeCost;
+    cost.nodes.push_back(nodeCost);
+  }
+  return cost;
+}
+
+MemoryPlan PlanMemory(const ModelProto& m, int64_t alignment) {
+  const GraphProto& g = m.graph();
+  std::unordered_map<std::string, const TypeProto*> valueTypes;
+  for (const auto* value_infos : {&g.value_info(), &g.input(), &g.output()}) {
+    for (const auto& vi : *value_infos) {
+      if (vi.has_type()) {
+        valueTypes[vi.name()] = &vi.type();
+      }
+    }
+  }
+  std::unordered_set<std::string> initializers;
+  for (const auto& tp : g.initializer()) {
+    initializers.insert(tp.name());
+  }
+
+  MemoryPlan plan;
+  std::unordered_map<std::string, size_t> tensorsByName;
+  auto addTensor = [&](const std::string& name, int node) {
+    if (name.empty() ||
+        !tensorsByName.emplace(name, plan.tensors.size()).second) {
+      return;
+    }
+    TensorLifetime tensor;
+    tensor.name = name;
+    auto type = valueTypes.find(name);
+    tensor.bytes =
+        type != valueTypes.end() ? tensorBytes(type->second) : int64_t(-1);
+    tensor.first_use = node;
+    tensor.last_use = node;
+    plan.tensors.push_back(std::move(tensor));
+  };
+  auto useTensor = [&](const std::string& name, int node) {
+    auto tensor = tensorsByName.find(name);
+    if (tensor != tensorsByName.end()) {
+      auto& last_use = plan.tensors[tensor->second].last_use;
+      last_use = std::max(last_use, node);
+    }
+  };
+
+  for (const auto& vi : g.input()) {
+    if (!initializers.count(vi.name())) {
+      addTensor(vi.name(), -1);
+    }
+  }
+  const int numNodes = g.node_size();
+  for (int i = 0; i < numNodes; ++i) {
+    const auto& n = g.node(i);
+    for (const auto& input : n.input()) {
+      useTensor(input, i);
+    }
+    std::unordered_set<std::string> subgraphInputs;
+    collectSubgraphInputs(n, subgraphInputs);
+    for (const auto& input : subgraphInputs) {
+      useTensor(input, i);
+    }
+    for (const auto& output : n.output()) {
+      addTensor(output, i);
+    }
+  }
+  for (const auto& vi : g.output()) {
+    useTensor(vi.name(), numNodes);
+  }
+
+  // Tensors allocated and freed at each node, offset by one for the graph
+  // inputs. Graph outputs are never freed.
+  std::vector<std::vector<size_t>> allocated(numNodes + 1);
+  std::vector<std::vector<size_t>> freed(numNodes + 1);
+  // The change of the live size when each node starts, offset by one.
+  std::vector<int64_t> liveDelta(numNodes + 3, 0);
+  for (size_t t = 0; t < plan.tensors.size(); ++t) {
+    const auto& tensor = plan.tensors[t];
+    if (tensor.bytes < 0) {
+      plan.complete = false;
+      continue;
+    }
+    allocated[tensor.first_use + 1].push_back(t);
+    if (tensor.last_use < numNodes) {
+      freed[tensor.last_use + 1].push_back(t);
+    }
+    liveDelta[tensor.first_use + 1] += tensor.bytes;
+    liveDelta[tensor.last_use + 2] -= tensor.bytes;
+  }
+
+  auto alignedSize = [alignment](int64_t bytes) {
+    return alignment > 1 ? (bytes + alignment - 1) / alignment * alignment
+                         : bytes;
+  };
+  ArenaAllocator arena;
+  int64_t live = 0;
+  for (int step = 0; step <= numNodes; ++step) {
+    live += liveDelta[step];
+    if (live > plan.peak_bytes) {
+      plan.peak_bytes = live;
+      plan.peak_node = step - 1;
+    }
+    for (size_t t : allocated[step]) {
+      auto& tensor = plan.tensors[t];
+      int64_t size = alignedSize(tensor.bytes);
+      tensor.offset = size > 0 ? arena.allocate(size) : 0;
+    }
+    for (size_t t : freed[step]) {
+      const auto& tensor = plan.tensors[t];
+      int64_t size = alignedSize(tensor.bytes);
+      if (size > 0) {
+        arena.release(tensor.offset, size);
+      }
+    }
+  }
+  plan.arena_bytes = arena.size();
+  return plan;
+}
+
+void InferShapes(
+    const std::string& model_path,
+    const std::string& save_path,
+    bool check_type,
+    const ISchemaRegistry* schema_registry
+    ) {
+  ModelProto model;
+  if (!ParseProtoFromPath(&model, model_path)) {
+    fail_shape_inference(
+        "Unable to load model from file: ",
+        model_path,
+        ". Please check if it is a valid protobuf file of model.");
+  }
+  InferShapes(model, check_type, schema_registry);
+
+  const std::string& output_path = save_path.empty() ? model_path : save_path;
+  std::fstream output(
+      output_path, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!output.good() || !model.SerializeToOstream(&output)) {
+    fail_shape_inference("Unable to save inferred model to ", output_path);
+  }
+}
+
+namespace {
+
+// Infers the output types of the node of ctx from the nodes of func.
+void InferShapeForFunctionBody(
     const FunctionProto* func,
     const ISchemaRegistry* schema_registry,
     InferenceContext& ctx) {
@@ -412,6 +1559,105 @@ void InferShapeForFunctionNode(
   }
 }
 
+// Input data of function ops past this size, such as weight initializers,
+// costs more to key by contents than inferring the body again.
+const size_t kMaxKeyedDataBytes = 4096;
+
+} // namespace
+
+bool FunctionInferenceCache::makeKey(
+    const FunctionProto* func,
+    InferenceContext& ctx,
+    std::string* key) {
+  // Each part is prefixed with its length, an absent part being empty.
+  // Input data is keyed by contents rather than address: data propagated in
+  // a subgraph does not outlive it, and its address may be reused.
+  key->clear();
+  auto appendPart = [key](const ::google::protobuf::MessageLite* part) {
+    std::string serialized;
+    if (part != nullptr) {
+      part->SerializeToString(&serialized);
+    }
+    key->append(ONNX_NAMESPACE::to_string(serialized.size()));
+    key->push_back(':');
+    key->append(serialized);
+  };
+  for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+    const TensorProto* data = ctx.getInputData(i);
+    if (data != nullptr && data->ByteSizeLong() > kMaxKeyedDataBytes) {
+      return false;
+    }
+    appendPart(ctx.getInputType(i));
+    appendPart(data);
+  }
+  for (const auto& name : func->attribute()) {
+    appendPart(ctx.getAttribute(name));
+  }
+  return true;
+}
+
+bool FunctionInferenceCache::lookup(
+    const FunctionProto* func,
+    const std::string& key,
+    InferenceContext& ctx) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto functionEntries = entries_.find(func);
+  if (functionEntries == entries_.end()) {
+    return false;
+  }
+  auto entry = functionEntries->second.find(key);
+  if (entry == functionEntries->second.end()) {
+    return false;
+  }
+  if (entry->second.error) {
+    std::rethrow_exception(entry->second.error);
+  }
+  const auto& outputTypes = entry->second.output_types;
+  for (size_t i = 0; i < outputTypes.size(); ++i) {
+    ctx.getOutputType(i)->CopyFrom(outputTypes[i]);
+  }
+  return true;
+}
+
+void FunctionInferenceCache::insert(
+    const FunctionProto* func,
+    std::string&& key,
+    InferenceContext& ctx,
+    std::exception_ptr error) {
+  Entry entry;
+  entry.error = error;
+  if (!error) {
+    for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+      entry.output_types.push_back(*ctx.getOutputType(i));
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_[func].emplace(std::move(key), std::move(entry));
+}
+
+void InferShapeForFunctionNode(
+    const FunctionProto* func,
+    const ISchemaRegistry* schema_registry,
+    InferenceContext& ctx,
+    FunctionInferenceCache* function_cache) {
+  std::string key;
+  if (function_cache == nullptr ||
+      !FunctionInferenceCache::makeKey(func, ctx, &key)) {
+    InferShapeForFunctionBody(func, schema_registry, ctx);
+    return;
+  }
+  if (function_cache->lookup(func, key, ctx)) {
+    return;
+  }
+  try {
+    InferShapeForFunctionBody(func, schema_registry, ctx);
+  } catch (const ONNX_NAMESPACE::InferenceError&) {
+    function_cache->insert(func, std::move(key), ctx, std::current_exception());
+    throw;
+  }
+  function_cache->insert(func, std::move(key), ctx);
+}
+
 std::vector<const TypeProto*> GraphInferencerImpl::doInferencing(
     const std::vector<const TypeProto*>& inputTypes,
     const std::vector<const TensorProto*>& inputData) {
@@ -461,10 +1707,11 @@ std::vector<const TypeProto*> GraphInferencerImpl::doInferencing(
 
   InferShapesImpl(
       g_,
-      *context_->outer_scope_value_types_by_name, // never null
+      &context_->outer_scope,
       context_->opset_imports,
-      false,
-      context_->schema_registry);
+      ShapeInferenceOptions(),
+      context_->schema_registry,
+      context_->function_cache);
 
   std::vector<const TypeProto*> graphOutputTypes;
   for (const ValueInfoProto& output : g_->output()) {
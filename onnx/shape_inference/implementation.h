@@ -1,5 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <exception>
+#include <mutex>
+
 #include "onnx/defs/function.h"
 #include "onnx/defs/schema.h"
 #include "onnx/proto_utils.h"
@@ -8,22 +12,115 @@
 namespace ONNX_NAMESPACE {
 namespace shape_inference {
 
+struct ShapeInferenceOptions {
+  // Checks the type-equality for input and output
+  bool check_type = false;
+  // Number of threads running inference functions of the main graph. Nodes
+  // are grouped in wavefronts whose inputs are all produced by earlier
+  // wavefronts, and the nodes of a wavefront are inferred concurrently.
+  // Inferred types are merged in node order, so the result, and the error
+  // thrown for an invalid graph, is the same as with a single thread. Values
+  // <= 1 infer one node at a time.
+  int num_threads = 1;
+  // Propagates the values of the small integer tensors computed by shape
+  // arithmetic (Shape, Gather, Slice, Concat, Add, ...) through the main
+  // graph, so that e.g. the target shape of a Reshape built from the shape
+  // of another tensor is known. Fully known values are visible through
+  // InferenceContext::getInputData, partially symbolic ones through
+  // getSymbolicInput. Not used by InferShapesIncremental.
+  bool enable_data_propagation = false;
+};
+
+// The types of the values visible in a graph: those of the graph itself,
+// then those of the enclosing graphs. A nested graph refers to the scope of
+// its enclosing graph instead of copying its types, so that inferring many
+// subgraphs costs nothing per value of the main graph.
+struct ValueTypeScope {
+  explicit ValueTypeScope(
+      const std::unordered_map<std::string, TypeProto*>* types_in,
+      const ValueTypeScope* outer_in = nullptr)
+      : types{types_in}, outer{outer_in} {}
+
+  // The type of name in the innermost scope that has it, or nullptr.
+  TypeProto* find(const std::string& name) const {
+    for (const ValueTypeScope* scope = this; scope; scope = scope->outer) {
+      auto iter = scope->types->find(name);
+      if (iter != scope->types->end()) {
+        return iter->second;
+      }
+    }
+    return nullptr;
+  }
+
+  const std::unordered_map<std::string, TypeProto*>* types;
+  const ValueTypeScope* outer;
+};
+
+// The output types inferred from the bodies of function ops, by function,
+// input types, input data and the attributes the body refers to. A model
+// using a function op many times with the same inputs and attributes infers
+// its body once per cache. Thread-safe.
+class FunctionInferenceCache final {
+ public:
+  // Sets key to the key of the inputs and attributes of ctx for func.
+  // Input data is keyed by contents, so returns false, and ctx is not
+  // cached, if some input data is larger than a small shape tensor.
+  static bool makeKey(
+      const FunctionProto* func,
+      InferenceContext& ctx,
+      std::string* key);
+  // Sets the output types of ctx to those cached for func and key, or
+  // rethrows the error inferring the body failed with. Returns false if
+  // nothing is cached.
+  bool lookup(
+      const FunctionProto* func,
+      const std::string& key,
+      InferenceContext& ctx);
+  // Caches the output types of ctx, or the current exception if error.
+  void insert(
+      const FunctionProto* func,
+      std::string&& key,
+      InferenceContext& ctx,
+      std::exception_ptr error = nullptr);
+
+ private:
+  struct Entry {
+    std::vector<TypeProto> output_types;
+    std::exception_ptr error;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<
+      const FunctionProto*,
+      std::unordered_map<std::string, Entry>>
+      entries_;
+};
+
 struct GraphInferenceContext {
   GraphInferenceContext(
       const std::unordered_map<std::string, TypeProto*>&
           outer_scope_value_types_by_name_in,
       const std::unordered_map<std::string, int> opset_imports_in,
       const ISchemaRegistry* schema_registry_in = OpSchemaRegistry::Instance())
-      : outer_scope_value_types_by_name{&outer_scope_value_types_by_name_in},
+      : outer_scope{&outer_scope_value_types_by_name_in},
+        opset_imports{opset_imports_in},
+        schema_registry{schema_registry_in} {}
+
+  // The enclosing scopes must outlive the context.
+  GraphInferenceContext(
+      const ValueTypeScope& outer_scope_in,
+      const std::unordered_map<std::string, int> opset_imports_in,
+      const ISchemaRegistry* schema_registry_in = OpSchemaRegistry::Instance())
+      : outer_scope{outer_scope_in},
         opset_imports{opset_imports_in},
         schema_registry{schema_registry_in} {}
-        
 
-  const std::unordered_map<std::string, TypeProto*>*
-      outer_scope_value_types_by_name;
+  // Types visible to the graph attributes inferred through this context.
+  const ValueTypeScope outer_scope;
   const std::unordered_map<std::string, int> opset_imports;
   const ISchemaRegistry* schema_registry;
-  
+  // Shared by the graph and the graphs nested in it.
+  FunctionInferenceCache* function_cache = nullptr;
 };
 
 class GraphInferencerImpl : public GraphInferencer {
@@ -40,29 +137,93 @@ class GraphInferencerImpl : public GraphInferencer {
   const GraphInferenceContext* context_;
 };
 
+// Inference context of one node. A context can be reset to another node,
+// which reuses its storage: inferring a graph through one context per thread
+// allocates nothing for the nodes but their inferred output types.
 struct InferenceContextImpl : public InferenceContext {
   InferenceContextImpl(
       NodeProto& n,
       const std::unordered_map<std::string, TypeProto*>& valueTypesByName,
       const std::unordered_map<std::string, const TensorProto*>&
           inputDataByName,
-      const GraphInferenceContext* graphInferenceContext = nullptr)
+      const GraphInferenceContext* graphInferenceContext = nullptr,
+      const std::unordered_map<std::string, TensorShapeProto>*
+          generatedShapeData = nullptr)
       : graphInferenceContext_{graphInferenceContext} {
-    for (auto& attr : *n.mutable_attribute()) {
-      attributesByName_[attr.name()] = &attr;
-      if (attr.has_g()) {
-        // need a mutable GraphProto to run inferencing on this attribute
-        graphProtoAttributesByName_[attr.name()] = attr.mutable_g();
-      }
+    reset(
+        n,
+        ValueTypeScope(&valueTypesByName),
+        inputDataByName,
+        generatedShapeData);
+  }
+
+  // A context without a node. reset() must be called before it is used.
+  explicit InferenceContextImpl(
+      const GraphInferenceContext* graphInferenceContext = nullptr)
+      : graphInferenceContext_{graphInferenceContext} {}
+
+  // Makes this the context of n, whose input types are looked up in
+  // valueTypes. The types inferred for the previous node are discarded.
+  void reset(
+      NodeProto& n,
+      const ValueTypeScope& valueTypes,
+      const std::unordered_map<std::string, const TensorProto*>&
+          inputDataByName,
+      const std::unordered_map<std::string, TensorShapeProto>*
+          generatedShapeData = nullptr) {
+    resetAttributes(n);
+    resetTypes(n, valueTypes, inputDataByName, generatedShapeData);
+  }
+
+  // As above, for a node that is only read: its graph attributes cannot be
+  // inferred.
+  void reset(
+      const NodeProto& n,
+      const ValueTypeScope& valueTypes,
+      const std::unordered_map<std::string, const TensorProto*>&
+          inputDataByName,
+      const std::unordered_map<std::string, TensorShapeProto>*
+          generatedShapeData = nullptr) {
+    resetAttributes(n);
+    resetTypes(n, valueTypes, inputDataByName, generatedShapeData);
+  }
+
+  // The two halves of reset, so that inferring n for several sets of input
+  // types only sorts its attributes once. Graph attributes are still
+  // inferred with the GraphInferenceContext of this context.
+  void resetAttributes(NodeProto& n) {
+    resetAttributes(static_cast<const NodeProto&>(n));
+    mutableNode_ = &n;
+  }
+
+  void resetAttributes(const NodeProto& n) {
+    mutableNode_ = nullptr;
+    attributes_.clear();
+    for (const auto& attr : n.attribute()) {
+      attributes_.push_back(&attr);
     }
+    // Stable, so that the last of duplicate attributes is found, as before.
+    std::stable_sort(
+        attributes_.begin(),
+        attributes_.end(),
+        [](const AttributeProto* a, const AttributeProto* b) {
+          return a->name() < b->name();
+        });
+    graphAttributeInferencers_.clear();
+  }
 
+  void resetTypes(
+      const NodeProto& n,
+      const ValueTypeScope& valueTypes,
+      const std::unordered_map<std::string, const TensorProto*>&
+          inputDataByName,
+      const std::unordered_map<std::string, TensorShapeProto>*
+          generatedShapeData = nullptr) {
+    allInputTypes_.clear();
+    allInputData_.clear();
+    allSymbolicInputs_.clear();
     for (const auto& input : n.input()) {
-      auto valueTypesIter = valueTypesByName.find(input);
-      if (valueTypesIter != valueTypesByName.end()) {
-        allInputTypes_.push_back(valueTypesIter->second);
-      } else {
-        allInputTypes_.push_back(nullptr);
-      }
+      allInputTypes_.push_back(valueTypes.find(input));
 
       const auto inputDataIter = inputDataByName.find(input);
       if (inputDataIter != inputDataByName.cend()) {
@@ -70,18 +231,28 @@ struct InferenceContextImpl : public InferenceContext {
       } else {
         allInputData_.push_back(nullptr);
       }
+
+      if (generatedShapeData) {
+        const auto generatedIter = generatedShapeData->find(input);
+        allSymbolicInputs_.push_back(
+            generatedIter != generatedShapeData->cend()
+                ? &generatedIter->second
+                : nullptr);
+      }
     }
 
-    allOutputTypes_.resize(n.output_size());
+    // Output types are kept across nodes and only cleared.
+    numOutputs_ = static_cast<size_t>(n.output_size());
+    if (allOutputTypes_.size() < numOutputs_) {
+      allOutputTypes_.resize(numOutputs_);
+    }
+    for (size_t i = 0; i < numOutputs_; ++i) {
+      allOutputTypes_[i].Clear();
+    }
   }
 
   const AttributeProto* getAttribute(const std::string& name) const override {
-    auto iter = attributesByName_.find(name);
-    if (iter == attributesByName_.end()) {
-      return nullptr;
-    } else {
-      return iter->second;
-    }
+    return findAttribute(name);
   }
 
   size_t getNumInputs() const override {
@@ -104,12 +275,21 @@ struct InferenceContextImpl : public InferenceContext {
     return allInputData_[index];
   }
 
+  const TensorShapeProto* getSymbolicInput(size_t index) const override {
+    if (index >= allInputTypes_.size()) {
+      throw std::runtime_error(
+          "input " + ONNX_NAMESPACE::to_string(index) + " is out of bounds");
+    }
+    return index < allSymbolicInputs_.size() ? allSymbolicInputs_[index]
+                                             : nullptr;
+  }
+
   size_t getNumOutputs() const override {
-    return allOutputTypes_.size();
+    return numOutputs_;
   }
 
   TypeProto* getOutputType(size_t index) override {
-    if (index >= allOutputTypes_.size()) {
+    if (index >= numOutputs_) {
       throw std::runtime_error(
           "output " + ONNX_NAMESPACE::to_string(index) + " is out of bounds");
     }
@@ -128,14 +308,29 @@ struct InferenceContextImpl : public InferenceContext {
     auto entry = graphAttributeInferencers_.find(attr_name);
     if (entry == graphAttributeInferencers_.cend()) {
       // create GraphInferencer instance
-      auto attrNameToGraphProto = graphProtoAttributesByName_.find(attr_name);
-      if (attrNameToGraphProto == graphProtoAttributesByName_.cend()) {
+      const AttributeProto* attr = findAttribute(attr_name);
+      if (attr == nullptr || !attr->has_g()) {
         fail_type_inference(
             "Attribute ", attr_name, " does not contain a graph.");
       }
 
-      std::unique_ptr<GraphInferencer> new_inferencer{new GraphInferencerImpl(
-          *attrNameToGraphProto->second, *graphInferenceContext_)};
+      // need a mutable GraphProto to run inferencing on this attribute
+      GraphProto* graph = nullptr;
+      if (mutableNode_) {
+        for (auto& mutableAttr : *mutableNode_->mutable_attribute()) {
+          if (&mutableAttr == attr) {
+            graph = mutableAttr.mutable_g();
+          }
+        }
+      }
+      if (graph == nullptr) {
+        fail_type_inference(
+            "Graph attribute ",
+            attr_name,
+            " of a read-only node is not inferred.");
+      }
+      std::unique_ptr<GraphInferencer> new_inferencer{
+          new GraphInferencerImpl(*graph, *graphInferenceContext_)};
 
       inferencer = new_inferencer.get();
       graphAttributeInferencers_.emplace(attr_name, std::move(new_inferencer));
@@ -146,11 +341,30 @@ struct InferenceContextImpl : public InferenceContext {
     return inferencer;
   }
 
+  const AttributeProto* findAttribute(const std::string& name) const {
+    auto iter = std::upper_bound(
+        attributes_.begin(),
+        attributes_.end(),
+        name,
+        [](const std::string& key, const AttributeProto* attr) {
+          return key < attr->name();
+        });
+    if (iter == attributes_.begin() || (*--iter)->name() != name) {
+      return nullptr;
+    }
+    return *iter;
+  }
+
   std::vector<const TensorProto*> allInputData_;
-  std::unordered_map<std::string, const AttributeProto*> attributesByName_;
-  std::unordered_map<std::string, GraphProto*> graphProtoAttributesByName_;
+  std::vector<const TensorShapeProto*> allSymbolicInputs_;
+  // The attributes of the node, sorted by name.
+  std::vector<const AttributeProto*> attributes_;
+  // The node, if it may be modified by inferring its graph attributes.
+  NodeProto* mutableNode_ = nullptr;
   std::vector<const TypeProto*> allInputTypes_;
+  // Only the first numOutputs_ types belong to the current node.
   std::vector<TypeProto> allOutputTypes_;
+  size_t numOutputs_ = 0;
   const GraphInferenceContext* graphInferenceContext_;
 
   // mutable as internal cache of GraphInferencer instances
@@ -158,6 +372,62 @@ struct InferenceContextImpl : public InferenceContext {
       graphAttributeInferencers_;
 };
 
+struct DataPropagationContextImpl : public DataPropagationContext {
+  DataPropagationContextImpl(
+      const NodeProto& n,
+      const std::unordered_map<std::string, TypeProto*>& valueTypesByName,
+      const std::unordered_map<std::string, const TensorProto*>&
+          inputDataByName,
+      std::unordered_map<std::string, TensorShapeProto>& generatedShapeData);
+
+  const AttributeProto* getAttribute(const std::string& name) const override {
+    auto iter = attributesByName_.find(name);
+    if (iter == attributesByName_.end()) {
+      return nullptr;
+    } else {
+      return iter->second;
+    }
+  }
+
+  size_t getNumInputs() const override {
+    return allInputTypes_.size();
+  }
+
+  const TypeProto* getInputType(size_t index) const override {
+    if (index >= allInputTypes_.size()) {
+      throw std::runtime_error(
+          "input " + ONNX_NAMESPACE::to_string(index) + " is out of bounds");
+    }
+    return allInputTypes_[index];
+  }
+
+  size_t getNumOutputs() const override {
+    return allOutputTypes_.size();
+  }
+
+  const TypeProto* getOutputType(size_t index) const override {
+    if (index >= allOutputTypes_.size()) {
+      throw std::runtime_error(
+          "output " + ONNX_NAMESPACE::to_string(index) + " is out of bounds");
+    }
+    return allOutputTypes_[index];
+  }
+
+  const TensorShapeProto* getInputData(size_t index) override;
+
+  void addOutputData(size_t index, TensorShapeProto&& value) override;
+
+ private:
+  const NodeProto& node_;
+  const std::unordered_map<std::string, const TensorProto*>& inputDataByName_;
+  std::unordered_map<std::string, TensorShapeProto>& generatedShapeData_;
+  std::unordered_map<std::string, const AttributeProto*> attributesByName_;
+  std::vector<const TypeProto*> allInputTypes_;
+  std::vector<const TypeProto*> allOutputTypes_;
+  // Values of constant inputs, converted on first use.
+  std::unordered_map<size_t, TensorShapeProto> constantInputData_;
+};
+
 void checkShapesAndTypes(
     const TypeProto_Tensor& inferredType,
     const TypeProto_Tensor& existingType);
@@ -195,10 +465,127 @@ void InferShapes(
     const ISchemaRegistry* schema_registry = OpSchemaRegistry::Instance()
     );
 
+void InferShapes(
+    ModelProto& m,
+    const ShapeInferenceOptions& options,
+    const ISchemaRegistry* schema_registry = OpSchemaRegistry::Instance());
+
+void InferShapes(
+    GraphProto* g,
+    const std::unordered_map<std::string, int>& opset_imports,
+    const ShapeInferenceOptions& options,
+    const ISchemaRegistry* schema_registry = OpSchemaRegistry::Instance());
+
+// Update the types inferred for m after an edit, re-running inference only
+// for nodes downstream of changed_values: the names of values whose type
+// changed (such as a graph input) or which are produced by an edited node.
+// m must have been through InferShapes before the edit. value_info entries of
+// re-inferred values are replaced, everything else is reused, and inference
+// stops at nodes whose output types come out unchanged. Types declared for
+// graph inputs and outputs are kept and checked as in InferShapes. Returns the
+// number of nodes re-inferred.
+size_t InferShapesIncremental(
+    ModelProto& m,
+    const std::vector<std::string>& changed_values,
+    const ShapeInferenceOptions& options = ShapeInferenceOptions(),
+    const ISchemaRegistry* schema_registry = OpSchemaRegistry::Instance());
+
+// Concrete shapes of graph inputs, by input name.
+using InputShapeBinding = std::unordered_map<std::string, TensorShapeProto>;
+
+// Infer the main graph of m once for each of bindings, in a single pass over
+// its nodes: each schema is resolved, and the attributes of each node are
+// sorted, once for all bindings. Inputs missing from a binding keep their
+// declared type. m is not modified, and the value_info already in m is not
+// used. Returns, for each binding, the types of the node outputs in node
+// order, which InferShapes on a copy of m with the bound input shapes would
+// add to value_info or merge into the graph outputs. Nodes with graph
+// attributes are copied for each binding, so that the types inferred for
+// their subgraphs do not mix. options.num_threads is not used.
+std::vector<std::vector<ValueInfoProto>> InferShapesForBindings(
+    const ModelProto& m,
+    const std::vector<InputShapeBinding>& bindings,
+    const ShapeInferenceOptions& options = ShapeInferenceOptions(),
+    const ISchemaRegistry* schema_registry = OpSchemaRegistry::Instance());
+
+// Estimated cost of the nodes of a graph.
+struct GraphCost {
+  // The sum of the costs of the nodes. Not complete if the cost of a node is
+  // not complete.
+  OpCost total;
+  // The cost of each node, in graph order.
+  std::vector<OpCost> nodes;
+  // Nodes whose op has no cost function (OpSchema::CostModelFunction). Only
+  // the bytes of their inputs and outputs are counted.
+  size_t num_unestimated_nodes = 0;
+};
+
+// Estimate the FLOPs and bytes moved by the nodes of the main graph of m,
+// from the types recorded in its inputs, outputs and value_info, so m should
+// have been through InferShapes. Initializers and Constant outputs count as
+// parameters. Nodes of nested graphs and the bodies of functions are not
+// included.
+GraphCost EstimateCost(
+    const ModelProto& m,
+    const ISchemaRegistry* schema_registry = OpSchemaRegistry::Instance());
+
+// The lifetime of a tensor of the main graph, in node indices.
+struct TensorLifetime {
+  std::string name;
+  // Size in bytes, or -1 if the shape or element type is unknown.
+  int64_t bytes = -1;
+  // The index of the node producing the tensor, or -1 for a graph input.
+  int first_use = -1;
+  // The index of the last node reading the tensor, directly or from a
+  // subgraph, or the number of nodes for a graph output.
+  int last_use = -1;
+  // Offset of the tensor in the arena, or -1 if its size is unknown.
+  int64_t offset = -1;
+};
+
+// Activation memory of the main graph, with its nodes run one at a time in
+// graph order.
+struct MemoryPlan {
+  // Graph inputs that are not initializers, then node outputs, in graph
+  // order.
+  std::vector<TensorLifetime> tensors;
+  // The largest total size of the tensors live while a node runs, and that
+  // node (-1 if the graph inputs alone are largest).
+  int64_t peak_bytes = 0;
+  int peak_node = -1;
+  // Size of an arena holding each tensor at its offset for its lifetime.
+  int64_t arena_bytes = 0;
+  // False if the size of a tensor is unknown. Such tensors are left out of
+  // the peak and the arena.
+  bool complete = true;
+};
+
+// Plan the activation memory of the main graph of m from the types recorded
+// in its inputs, outputs and value_info, so m should have been through
+// InferShapes. Initializers are not planned. A tensor is live from the node
+// producing it to its last reader, and the outputs of a node never share
+// memory with its inputs. Tensors are placed in graph order, each in the
+// smallest free block of the arena that fits, and freed after their last
+// use. Offsets and sizes in the arena are rounded up to alignment.
+MemoryPlan PlanMemory(const ModelProto& m, int64_t alignment = 64);
+
+// Infer shapes for the model stored at model_path and write the result to
+// save_path, or back to model_path if save_path is empty. The model is parsed
+// directly from a memory mapping of the file.
+void InferShapes(
+    const std::string& model_path,
+    const std::string& save_path = "",
+    bool check_type = false,
+    const ISchemaRegistry* schema_registry = OpSchemaRegistry::Instance()
+    );
+
+// Infer the output types of the node of ctx from func, its function body.
+// The results are reused from function_cache if it is not null.
 void InferShapeForFunctionNode(
     const FunctionProto* func,
     const ISchemaRegistry* schema_registry,
-    InferenceContext& ctx);
+    InferenceContext& ctx,
+    FunctionInferenceCache* function_cache = nullptr);
 
 } // namespace shape_inference
 } // namespace ONNX_NAMESPACE
@@ -0,0 +1,409 @@
+// ATTENTION: The code in this file is highly EXPERIMENTAL.
+// Adventurous users should note that the APIs will probably change.
+
+#include "onnx/shape_inference/ir_inference.h"
+
+#include "onnx/common/ir_pb_converter.h"
+
+namespace ONNX_NAMESPACE {
+namespace shape_inference {
+
+namespace {
+
+// Writes the type of value into type. Empty sizes are only written if
+// keep_empty_sizes is set, see the comment on InferShapes.
+void encodeValueType(
+    const Value* value,
+    bool keep_empty_sizes,
+    TypeProto* type) {
+  auto* tensor_type = type->mutable_tensor_type();
+  tensor_type->set_elem_type(value->elemType());
+  if (!value->has_sizes() || (value->sizes().empty() && !keep_empty_sizes)) {
+    return;
+  }
+  auto* shape = tensor_type->mutable_shape();
+  for (const Dimension& d : value->sizes()) {
+    auto* dim = shape->add_dim();
+    if (d.is_int) {
+      dim->set_dim_value(d.dim);
+    } else if (!d.param.empty()) {
+      dim->set_dim_param(d.param);
+    }
+  }
+}
+
+void setValueType(Value* value, const TypeProto_Tensor& type) {
+  value->setElemType(type.elem_type());
+  if (!type.has_shape()) {
+    return;
+  }
+  std::vector<Dimension> sizes;
+  sizes.reserve(type.shape().dim_size());
+  for (const auto& dim : type.shape().dim()) {
+    if (dim.has_dim_value()) {
+      sizes.emplace_back(dim.dim_value());
+    } else {
+      sizes.emplace_back(dim.dim_param());
+    }
+  }
+  value->setSizes(std::move(sizes));
+}
+
+// Inference state of one graph. Types are converted from the IR on first
+// use, and inferred types are stored both here and in the IR.
+class GraphInference final {
+ public:
+  GraphInference(
+      Graph& graph,
+      GraphInference* outer,
+      const std::unordered_map<std::string, int>& opset_imports,
+      const ShapeInferenceOptions& options,
+      const ISchemaRegistry* schema_registry)
+      : graph_(graph),
+        outer_(outer),
+        opset_imports_(opset_imports),
+        options_(options),
+        schema_registry_(schema_registry) {}
+
+  void run();
+
+  // The type of value, or nullptr if it has none.
+  const TypeProto* getType(const Value* value);
+
+  // The initializer of value, or nullptr if it is not an initialized input.
+  const TensorProto* getData(const Value* value);
+
+  // Merges inferred into the type of value, checking first that they are
+  // compatible if check is set.
+  void mergeType(Value* value, const TypeProto& inferred, bool check);
+
+  const std::unordered_map<std::string, int>& opset_imports() const {
+    return opset_imports_;
+  }
+
+  const ISchemaRegistry* schema_registry() const {
+    return schema_registry_;
+  }
+
+  // Shared by the graph and the graphs nested in it.
+  FunctionInferenceCache* function_cache() {
+    return outer_ ? outer_->function_cache() : &functionCache_;
+  }
+
+ private:
+  // The value named name in this graph or an enclosing one, or nullptr.
+  const Value* findValue(const std::string& name);
+
+  // Indexes the values and initializers of the graph by name.
+  void buildIndex();
+
+  Graph& graph_;
+  GraphInference* outer_;
+  const std::unordered_map<std::string, int>& opset_imports_;
+  const ShapeInferenceOptions options_;
+  const ISchemaRegistry* schema_registry_;
+  // Types of the values seen so far. Values without a type map to an empty
+  // TypeProto.
+  std::unordered_map<const Value*, TypeProto> types_;
+  std::unordered_map<const Value*, TensorProto> data_;
+  // Built by buildIndex on first use.
+  std::unordered_map<std::string, const Value*> valuesByName_;
+  std::unordered_map<std::string, const Tensor*> initializersByName_;
+  bool indexed_ = false;
+  // Used by the outermost graph only.
+  FunctionInferenceCache functionCache_;
+};
+
+class SubgraphInferencer final : public GraphInferencer {
+ public:
+  SubgraphInferencer(Graph& graph, GraphInference& outer)
+      : graph_(graph), outer_(outer) {}
+
+  std::vector<const TypeProto*> doInferencing(
+      const std::vector<const TypeProto*>& inputTypes,
+      const std::vector<const TensorProto*>& inputData) override;
+
+ private:
+  Graph& graph_;
+  GraphInference& outer_;
+  // Holds the output types returned by the last doInferencing.
+  std::unique_ptr<GraphInference> inference_;
+  const TypeProto emptyType_;
+};
+
+class NodeInferenceContext final : public InferenceContext {
+ public:
+  NodeInferenceContext(Node* node, GraphInference& graph)
+      : node_(node), graph_(graph), outputTypes_(node->outputs().size()) {}
+
+  const AttributeProto* getAttribute(const std::string& name) const override {
+    auto iter = attributes_.find(name);
+    if (iter != attributes_.end()) {
+      return &iter->second;
+    }
+    for (Symbol symbol : node_->attributeNames()) {
+      if (name == symbol.toString()) {
+        AttributeProto& attr = attributes_[name];
+        encodeAttribute(&attr, node_, symbol);
+        return &attr;
+      }
+    }
+    return nullptr;
+  }
+
+  size_t getNumInputs() const override {
+    return node_->inputs().size();
+  }
+
+  const TypeProto* getInputType(size_t index) const override {
+    return graph_.getType(input(index));
+  }
+
+  const TensorProto* getInputData(size_t index) const override {
+    return graph_.getData(input(index));
+  }
+
+  size_t getNumOutputs() const override {
+    return outputTypes_.size();
+  }
+
+  TypeProto* getOutputType(size_t index) override {
+    if (index >= outputTypes_.size()) {
+      throw std::runtime_error(
+          "output " + ONNX_NAMESPACE::to_string(index) + " is out of bounds");
+    }
+    return &outputTypes_[index];
+  }
+
+  GraphInferencer* getGraphAttributeInferencer(
+      const std::string& attr_name) override {
+    auto entry = graphAttributeInferencers_.find(attr_name);
+    if (entry != graphAttributeInferencers_.end()) {
+      return entry->second.get();
+    }
+    for (Symbol symbol : node_->attributeNames()) {
+      if (attr_name == symbol.toString() &&
+          node_->kindOf(symbol) == AttributeKind::g) {
+        std::unique_ptr<GraphInferencer>& inferencer =
+            graphAttributeInferencers_[attr_name];
+        inferencer.reset(new SubgraphInferencer(*node_->g(symbol), graph_));
+        return inferencer.get();
+      }
+    }
+    fail_type_inference("Attribute ", attr_name, " does not contain a graph.");
+  }
+
+ private:
+  const Value* input(size_t index) const {
+    if (index >= node_->inputs().size()) {
+      throw std::runtime_error(
+          "input " + ONNX_NAMESPACE::to_string(index) + " is out of bounds");
+    }
+    return node_->inputs()[index];
+  }
+
+  Node* node_;
+  GraphInference& graph_;
+  std::vector<TypeProto> outputTypes_;
+  // Attributes converted to protos on first use.
+  mutable std::unordered_map<std::string, AttributeProto> attributes_;
+  std::unordered_map<std::string, std::unique_ptr<GraphInferencer>>
+      graphAttributeInferencers_;
+};
+
+void GraphInference::run() {
+  SchemaResolutionCache resolvedSchemas(opset_imports_, schema_registry_);
+  for (Node* n : graph_.nodes()) {
+    if (n->kind() == kUndefined || n->kind() == kCaptured) {
+      continue;
+    }
+    const OpSchema* schema =
+        resolvedSchemas.GetSchema(n->kind().toString(), n->domain());
+    if (!schema) {
+      continue;
+    }
+
+    NodeInferenceContext ctx(n, *this);
+    try {
+      if (schema->has_type_and_shape_inference_function()) {
+        schema->GetTypeAndShapeInferenceFunction()(ctx);
+      } else if (schema->HasFunction()) {
+        InferShapeForFunctionNode(
+            schema->GetFunction(), schema_registry_, ctx, function_cache());
+      } else {
+        continue;
+      }
+    } catch (const ONNX_NAMESPACE::InferenceError& ex) {
+      (void)ex;
+      // Continue with inference for remaining nodes
+      continue;
+    }
+
+    if (options_.check_type) {
+      schema->CheckInputOutputType(ctx);
+    }
+    for (size_t i = 0; i < n->outputs().size(); ++i) {
+      mergeType(n->outputs()[i], *ctx.getOutputType(i), true);
+    }
+  }
+}
+
+const TypeProto* GraphInference::getType(const Value* value) {
+  const Node* producer = value->node();
+  if (producer->kind() == kUndefined) {
+    return nullptr;
+  }
+  if (producer->kind() == kCaptured) {
+    // A value of an enclosing graph.
+    const Value* outer_value =
+        outer_ ? outer_->findValue(value->uniqueName()) : nullptr;
+    return outer_value ? outer_->getType(outer_value) : nullptr;
+  }
+
+  auto iter = types_.find(value);
+  if (iter == types_.end()) {
+    iter = types_.emplace(value, TypeProto()).first;
+    if (value->elemType() != TensorProto::UNDEFINED || value->has_sizes()) {
+      encodeValueType(value, true, &iter->second);
+    }
+  }
+  return iter->second.value_case() == TypeProto::VALUE_NOT_SET ? nullptr
+                                                                : &iter->second;
+}
+
+const TensorProto* GraphInference::getData(const Value* value) {
+  if (value->node()->kind() != kParam) {
+    return nullptr;
+  }
+  auto iter = data_.find(value);
+  if (iter != data_.end()) {
+    return &iter->second;
+  }
+  buildIndex();
+  auto initializer = initializersByName_.find(value->uniqueName());
+  if (initializer == initializersByName_.end()) {
+    return nullptr;
+  }
+  TensorProto& data = data_[value];
+  encodeTensor(&data, *initializer->second);
+  return &data;
+}
+
+void GraphInference::mergeType(
+    Value* value,
+    const TypeProto& inferred,
+    bool check) {
+  // The IR only holds tensor types.
+  if (!inferred.has_tensor_type()) {
+    return;
+  }
+  const auto& inferredTensorType = inferred.tensor_type();
+  // Bail out early if shape inference does nothing useful.
+  if (inferredTensorType.elem_type() == TensorProto::UNDEFINED &&
+      !inferredTensorType.has_shape()) {
+    return;
+  }
+
+  TypeProto& type = types_[value];
+  type.Clear();
+  if (value->elemType() != TensorProto::UNDEFINED || value->has_sizes()) {
+    encodeValueType(value, false, &type);
+    if (check) {
+      checkShapesAndTypes(inferred, type);
+    }
+  }
+  mergeShapesAndTypes(inferred, &type);
+  setValueType(value, type.tensor_type());
+}
+
+void GraphInference::buildIndex() {
+  if (indexed_) {
+    return;
+  }
+  indexed_ = true;
+  for (const Value* input : graph_.inputs()) {
+    valuesByName_[input->uniqueName()] = input;
+  }
+  for (const Node* n : graph_.nodes()) {
+    if (n->kind() == kUndefined) {
+      continue;
+    }
+    for (const Value* output : n->outputs()) {
+      valuesByName_.emplace(output->uniqueName(), output);
+    }
+  }
+  const auto& names = graph_.initializer_names();
+  const auto& initializers = graph_.initializers();
+  for (size_t i = 0; i < names.size(); ++i) {
+    initializersByName_[names[i]] = &initializers[i];
+  }
+}
+
+const Value* GraphInference::findValue(const std::string& name) {
+  buildIndex();
+  auto iter = valuesByName_.find(name);
+  if (iter != valuesByName_.end()) {
+    return iter->second;
+  }
+  return outer_ ? outer_->findValue(name) : nullptr;
+}
+
+std::vector<const TypeProto*> SubgraphInferencer::doInferencing(
+    const std::vector<const TypeProto*>& inputTypes,
+    const std::vector<const TensorProto*>& inputData) {
+  (void)inputData;
+  auto inputs = graph_.inputs();
+  if (inputs.size() != inputTypes.size()) {
+    fail_shape_inference(
+        "Graph has ",
+        inputs.size(),
+        " inputs but ",
+        inputTypes.size(),
+        " were provided");
+  }
+
+  // Subgraphs are inferred with the default options, as for GraphProtos.
+  inference_.reset(new GraphInference(
+      graph_,
+      &outer_,
+      outer_.opset_imports(),
+      ShapeInferenceOptions(),
+      outer_.schema_registry()));
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const TypeProto* inferredInput = inputTypes[i];
+    if (!inferredInput) {
+      continue;
+    }
+    if (!inferredInput->has_tensor_type()) {
+      fail_type_inference(
+          "Graph input #", i, " is tensor type, but provided type is not.");
+    }
+    inference_->mergeType(inputs[i], *inferredInput, false);
+  }
+
+  inference_->run();
+
+  std::vector<const TypeProto*> graphOutputTypes;
+  for (const Value* output : graph_.outputs()) {
+    const TypeProto* type = inference_->getType(output);
+    graphOutputTypes.push_back(type ? type : &emptyType_);
+  }
+  return graphOutputTypes;
+}
+
+} // namespace
+
+void InferShapes(
+    Graph& graph,
+    const ShapeInferenceOptions& options,
+    const ISchemaRegistry* schema_registry) {
+  std::unordered_map<std::string, int> opset_imports;
+  for (const auto& opset : graph.opset_versions_mutable()) {
+    opset_imports[opset.domain()] = static_cast<int>(opset.version());
+  }
+  GraphInference(graph, nullptr, opset_imports, options, schema_registry)
+      .run();
+}
+
+} // namespace shape_inference
+} // namespace ONNX_NAMESPACE
@@ -0,0 +1,36 @@
+// ATTENTION: The code in this file is highly EXPERIMENTAL.
+// Adventurous users should note that the APIs will probably change.
+
+#pragma once
+
+#include "onnx/common/ir.h"
+#include "onnx/shape_inference/implementation.h"
+
+namespace ONNX_NAMESPACE {
+namespace shape_inference {
+
+// Infers the element types and shapes of the values of an IR graph, and of
+// the graphs nested in its attributes, and stores them with
+// Value::setElemType and Value::setSizes. The registered inference functions
+// run directly against the graph; neither the graph nor its initializers are
+// converted to protos, only the attributes and initializers an inference
+// function asks for.
+//
+// Schemas are resolved with graph.opset_versions_mutable(). As with
+// InferShapes on a ModelProto, nodes whose inference fails are skipped, and
+// inferred types that conflict with the declared ones throw InferenceError.
+//
+// The IR keeps no difference between a value without a shape and a scalar.
+// Values are read as scalars when their sizes are empty, but the inferred
+// shape of a node output or subgraph input replaces empty sizes instead of
+// conflicting with them.
+//
+// options.num_threads and options.enable_data_propagation are not supported
+// and ignored.
+void InferShapes(
+    Graph& graph,
+    const ShapeInferenceOptions& options = ShapeInferenceOptions(),
+    const ISchemaRegistry* schema_registry = OpSchemaRegistry::Instance());
+
+} // namespace shape_inference
+} // namespace ONNX_NAMESPACE
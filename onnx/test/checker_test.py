@@ -2,6 +2,9 @@ from __future__ import absolute_import
 from __future__ import division
 from __future__ import print_function
 from __future__ import unicode_literals
+import os
+import shutil
+import tempfile
 import unittest
 
 from typing import Sequence
@@ -10,6 +13,7 @@ import numpy as np  # type: ignore
 from onnx import checker, helper
 from onnx import TensorProto, GraphProto, SparseTensorProto
 import onnx.onnx_cpp2py_export.checker as C
+import onnx
 import onnx.defs
 
 
@@ -89,6 +93,36 @@ class TestChecker(unittest.TestCase):
         graph.initializer[0].name = 'X'
         checker.check_graph(graph)
 
+    def test_check_graph_parallel_initializers(self):  # type: () -> None
+        ctx = C.CheckerContext()
+        ctx.ir_version = onnx.IR_VERSION
+        ctx.opset_imports = {'': onnx.defs.onnx_opset_version()}
+        ctx.num_threads = 4
+
+        node = helper.make_node(
+            "Relu", ["X"], ["Y"], name="test")
+        graph = helper.make_graph(
+            [node],
+            "test",
+            [helper.make_tensor_value_info("X", TensorProto.FLOAT, [1, 2])],
+            [helper.make_tensor_value_info("Y", TensorProto.FLOAT, [1, 2])])
+        for i in range(16):
+            tensor = helper.make_tensor(
+                name='init_{}'.format(i),
+                data_type=TensorProto.FLOAT,
+                dims=[2, 3],
+                vals=np.random.randn(2, 3).astype(np.float32).tobytes(),
+                raw=True)
+            graph.initializer.extend([tensor])
+        checker.check_graph(graph, ctx)
+
+        # The first invalid initializer in graph order is the one reported.
+        graph.initializer[9].data_type = TensorProto.STRING
+        graph.initializer[3].data_type = TensorProto.UNDEFINED
+        with self.assertRaises(checker.ValidationError) as cm:
+            checker.check_graph(graph, ctx)
+        self.assertIn('init_3', str(cm.exception))
+
     def test_check_graph_optional_input(self):  # type: () -> None
         # GivenTensorFill's input is marked optional, hence it is used in this test.
         node = helper.make_node(
@@ -149,6 +183,59 @@ class TestChecker(unittest.TestCase):
 
         checker.check_model(model)
 
+    def test_collect_model_diagnostics(self):  # type: () -> None
+        nodes = [
+            helper.make_node("Relu", ["X"], ["Y"]),
+            helper.make_node("Relu", ["W"], ["Z"]),
+            helper.make_node("Relu", ["Y"], ["Y"]),
+            helper.make_node("NoSuchOp", ["Y"], ["A"]),
+        ]
+        graph = helper.make_graph(
+            nodes,
+            "test",
+            [helper.make_tensor_value_info("X", TensorProto.FLOAT, [1, 2])],
+            [helper.make_tensor_value_info("A", TensorProto.FLOAT, [1, 2])])
+        model = helper.make_model(graph, producer_name='test')
+        self.assertRaises(checker.ValidationError, checker.check_model, model)
+
+        diagnostics = checker.collect_model_diagnostics(model)
+        self.assertEqual(
+            [(d.code, d.graph_name, d.node_index) for d in diagnostics],
+            [(checker.DiagnosticCode.UnsortedNode, "test", 1),
+             (checker.DiagnosticCode.NotSSA, "test", 2),
+             (checker.DiagnosticCode.InvalidNode, "test", 3)])
+        self.assertEqual(diagnostics[2].op_type, "NoSuchOp")
+
+        nodes[1].input[0] = "X"
+        del nodes[2:]
+        graph.output[0].name = "Z"
+        model = helper.make_model(
+            helper.make_graph(nodes, "test", graph.input, graph.output),
+            producer_name='test')
+        self.assertEqual(checker.collect_model_diagnostics(model), [])
+
+    def test_check_model_streaming(self):  # type: () -> None
+        node = helper.make_node(
+            "Add", ["X", "W"], ["Y"], name="test")
+        graph = helper.make_graph(
+            [node],
+            "test",
+            [helper.make_tensor_value_info("X", TensorProto.FLOAT, [2, 3])],
+            [helper.make_tensor_value_info("Y", TensorProto.FLOAT, [2, 3])],
+            initializer=[self._sample_float_tensor])
+        graph.initializer[0].name = 'W'
+        model = helper.make_model(graph, producer_name='test')
+        temp_dir = tempfile.mkdtemp()
+        model_path = os.path.join(temp_dir, 'model.onnx')
+        onnx.save(model, model_path)
+        checker.check_model_streaming(model_path)
+
+        # Header checks still apply to initializers whose data is skipped.
+        model.graph.initializer[0].data_type = TensorProto.STRING
+        onnx.save(model, model_path)
+        self.assertRaises(checker.ValidationError, checker.check_model_streaming, model_path)
+        shutil.rmtree(temp_dir)
+
     def test_check_old_model(self):  # type: () -> None
         node = helper.make_node(
             "Pad", ["X"], ["Y"], paddings=(0, 0, 0, 0))
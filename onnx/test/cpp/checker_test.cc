@@ -0,0 +1,389 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include "gtest/gtest.h"
+#include "onnx/checker.h"
+#include "onnx/shape_inference/implementation.h"
+
+namespace ONNX_NAMESPACE {
+namespace Test {
+
+using namespace checker;
+
+TEST(LexicalScopeContextTest, NestedScopes) {
+  LexicalScopeContext outer;
+  outer.add("x");
+  {
+    LexicalScopeContext inner{outer};
+    inner.add("y");
+    EXPECT_TRUE(inner.this_graph_has("y"));
+    EXPECT_FALSE(inner.this_graph_has("x"));
+    EXPECT_TRUE(inner.this_or_ancestor_graph_has("x"));
+    EXPECT_FALSE(outer.this_or_ancestor_graph_has("y"));
+
+    LexicalScopeContext innermost{inner};
+    EXPECT_TRUE(innermost.this_or_ancestor_graph_has("x"));
+    EXPECT_TRUE(innermost.this_or_ancestor_graph_has("y"));
+    EXPECT_FALSE(innermost.this_or_ancestor_graph_has("z"));
+  }
+  LexicalScopeContext sibling{outer};
+  EXPECT_FALSE(sibling.this_or_ancestor_graph_has("y"));
+  EXPECT_TRUE(sibling.this_or_ancestor_graph_has("x"));
+}
+
+TEST(LexicalScopeContextTest, SiblingAndShadowingScopes) {
+  LexicalScopeContext outer;
+  outer.add("x");
+  LexicalScopeContext first{outer};
+  LexicalScopeContext second{outer};
+  first.add("t");
+  second.add("t");
+  second.add("x");
+  EXPECT_TRUE(first.this_graph_has("t"));
+  EXPECT_TRUE(second.this_graph_has("t"));
+  EXPECT_FALSE(first.this_graph_has("x"));
+  EXPECT_TRUE(second.this_graph_has("x"));
+  EXPECT_FALSE(outer.this_or_ancestor_graph_has("t"));
+}
+
+TEST(LexicalScopeContextTest, DirectOutputNamesChanges) {
+  LexicalScopeContext outer;
+  outer.output_names.insert("x");
+  LexicalScopeContext inner{outer};
+  inner.output_names.insert("y");
+  EXPECT_TRUE(inner.this_or_ancestor_graph_has("x"));
+  EXPECT_TRUE(inner.this_graph_has("y"));
+
+  outer.output_names.erase("x");
+  EXPECT_FALSE(inner.this_or_ancestor_graph_has("x"));
+  EXPECT_EQ(inner.output_names.size(), 1);
+
+  // Changes keeping the number of names are seen too.
+  inner.output_names.erase("y");
+  inner.output_names.insert("z");
+  EXPECT_FALSE(inner.this_graph_has("y"));
+  EXPECT_TRUE(inner.this_graph_has("z"));
+  {
+    LexicalScopeContext sibling{outer};
+    sibling.output_names.insert("w");
+  }
+  EXPECT_FALSE(inner.this_or_ancestor_graph_has("w"));
+}
+
+TEST(LexicalScopeContextTest, CopiedScopes) {
+  LexicalScopeContext outer;
+  outer.add("x");
+  LexicalScopeContext copied;
+  copied.output_names = outer.output_names;
+  EXPECT_TRUE(copied.this_graph_has("x"));
+  copied.add("y");
+  EXPECT_TRUE(copied.this_graph_has("x"));
+  EXPECT_TRUE(copied.this_graph_has("y"));
+  EXPECT_FALSE(outer.this_graph_has("y"));
+
+  LexicalScopeContext assigned;
+  assigned.add("z");
+  assigned = copied;
+  EXPECT_TRUE(assigned.this_graph_has("y"));
+  EXPECT_FALSE(assigned.this_graph_has("z"));
+  assigned.output_names.clear();
+  EXPECT_FALSE(assigned.this_graph_has("x"));
+  EXPECT_TRUE(copied.this_graph_has("x"));
+}
+
+static void SetFloatType(ValueInfoProto* value_info, const std::string& name) {
+  value_info->set_name(name);
+  auto* tensor_type = value_info->mutable_type()->mutable_tensor_type();
+  tensor_type->set_elem_type(TensorProto::FLOAT);
+  tensor_type->mutable_shape()->add_dim()->set_dim_value(2);
+}
+
+// Y = Relu(X); Z = If(C) { Identity(Y) } else { Identity(Y) }
+static ModelProto MakeIfModel() {
+  ModelProto model;
+  model.set_ir_version(IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain(ONNX_DOMAIN);
+  opset->set_version(13);
+
+  GraphProto* graph = model.mutable_graph();
+  graph->set_name("main");
+  SetFloatType(graph->add_input(), "X");
+  auto* cond = graph->add_input();
+  cond->set_name("C");
+  auto* cond_type = cond->mutable_type()->mutable_tensor_type();
+  cond_type->set_elem_type(TensorProto::BOOL);
+  cond_type->mutable_shape();
+  SetFloatType(graph->add_output(), "Z");
+
+  NodeProto* relu = graph->add_node();
+  relu->set_op_type("Relu");
+  relu->add_input("X");
+  relu->add_output("Y");
+
+  NodeProto* if_node = graph->add_node();
+  if_node->set_op_type("If");
+  if_node->add_input("C");
+  if_node->add_output("Z");
+  for (const char* branch : {"then_branch", "else_branch"}) {
+    AttributeProto* attr = if_node->add_attribute();
+    attr->set_name(branch);
+    attr->set_type(AttributeProto::GRAPH);
+    GraphProto* body = attr->mutable_g();
+    body->set_name(branch);
+    SetFloatType(body->add_output(), std::string(branch) + "_out");
+    NodeProto* identity = body->add_node();
+    identity->set_op_type("Identity");
+    identity->add_input("Y");
+    identity->add_output(std::string(branch) + "_out");
+  }
+  return model;
+}
+
+TEST(ValidationCacheTest, RecheckUnchangedModel) {
+  auto cache = std::make_shared<ValidationCache>();
+  ModelProto model = MakeIfModel();
+  CheckerContext ctx;
+  ctx.set_validation_cache(cache);
+  check_model(model, ctx);
+  // The If node, with its branches. Relu is checked every time.
+  EXPECT_EQ(cache->size(), 1);
+
+  CheckerContext recheck_ctx;
+  recheck_ctx.set_validation_cache(cache);
+  check_model(model, recheck_ctx);
+  EXPECT_EQ(cache->size(), 1);
+
+  cache->clear();
+  EXPECT_EQ(cache->size(), 0);
+}
+
+TEST(ValidationCacheTest, RecheckEditedModel) {
+  auto cache = std::make_shared<ValidationCache>();
+  ModelProto model = MakeIfModel();
+  CheckerContext ctx;
+  ctx.set_validation_cache(cache);
+  check_model(model, ctx);
+
+  // An edited node is validated again.
+  ModelProto bad_attribute = model;
+  AttributeProto* attr =
+      bad_attribute.mutable_graph()->mutable_node(0)->add_attribute();
+  attr->set_name("alpha");
+  attr->set_type(AttributeProto::FLOAT);
+  attr->set_f(1.0f);
+  CheckerContext bad_attribute_ctx;
+  bad_attribute_ctx.set_validation_cache(cache);
+  EXPECT_THROW(check_model(bad_attribute, bad_attribute_ctx), ValidationError);
+
+  // The unchanged If node is cached, but its branches read an outer scope
+  // value that is no longer defined.
+  ModelProto renamed_output = model;
+  renamed_output.mutable_graph()->mutable_node(0)->set_output(0, "Y2");
+  CheckerContext renamed_output_ctx;
+  renamed_output_ctx.set_validation_cache(cache);
+  EXPECT_THROW(
+      check_model(renamed_output, renamed_output_ctx), ValidationError);
+
+  // Or that define a value of the outer scope again.
+  ModelProto shadowed_output = model;
+  NodeProto* identity = shadowed_output.mutable_graph()->add_node();
+  identity->set_op_type("Identity");
+  identity->add_input("X");
+  identity->add_output("then_branch_out");
+  shadowed_output.mutable_graph()->mutable_node()->SwapElements(1, 2);
+  CheckerContext shadowed_output_ctx;
+  shadowed_output_ctx.set_validation_cache(cache);
+  EXPECT_THROW(
+      check_model(shadowed_output, shadowed_output_ctx), ValidationError);
+
+  // The If node is validated again under a different opset.
+  size_t cached = cache->size();
+  ModelProto old_opset = model;
+  old_opset.mutable_opset_import(0)->set_version(11);
+  CheckerContext old_opset_ctx;
+  old_opset_ctx.set_validation_cache(cache);
+  check_model(old_opset, old_opset_ctx);
+  EXPECT_EQ(cache->size(), cached + 1);
+}
+
+TEST(ValidationCacheTest, LargeSubgraphsNotCached) {
+  ModelProto model = MakeIfModel();
+  GraphProto* then_branch =
+      model.mutable_graph()->mutable_node(1)->mutable_attribute(0)->mutable_g();
+  NodeProto* constant = then_branch->add_node();
+  constant->set_op_type("Constant");
+  constant->add_output("K");
+  AttributeProto* value = constant->add_attribute();
+  value->set_name("value");
+  value->set_type(AttributeProto::TENSOR);
+  TensorProto* tensor = value->mutable_t();
+  tensor->set_data_type(TensorProto::FLOAT);
+  tensor->add_dims(4096);
+  tensor->set_raw_data(std::string(4096 * sizeof(float), '\0'));
+
+  auto cache = std::make_shared<ValidationCache>();
+  CheckerContext ctx;
+  ctx.set_validation_cache(cache);
+  check_model(model, ctx);
+  EXPECT_EQ(cache->size(), 0);
+}
+
+TEST(ValidationCacheTest, ExternalDataNotCached) {
+  const std::string location = "validation_cache_test.bin";
+  std::ofstream(location, std::ios::binary) << std::string(16, '\0');
+  ModelProto model = MakeIfModel();
+  GraphProto* then_branch =
+      model.mutable_graph()->mutable_node(1)->mutable_attribute(0)->mutable_g();
+  NodeProto* constant = then_branch->add_node();
+  constant->set_op_type("Constant");
+  constant->add_output("K");
+  AttributeProto* value = constant->add_attribute();
+  value->set_name("value");
+  value->set_type(AttributeProto::TENSOR);
+  TensorProto* tensor = value->mutable_t();
+  tensor->set_data_type(TensorProto::FLOAT);
+  tensor->add_dims(4);
+  tensor->set_data_location(TensorProto::EXTERNAL);
+  StringStringEntryProto* entry = tensor->add_external_data();
+  entry->set_key("location");
+  entry->set_value(location);
+
+  auto cache = std::make_shared<ValidationCache>();
+  CheckerContext ctx;
+  ctx.set_validation_cache(cache);
+  check_model(model, ctx);
+  // The If node holding the Constant is left out.
+  EXPECT_EQ(cache->size(), 0);
+
+  // Its data is checked again.
+  std::remove(location.c_str());
+  CheckerContext recheck_ctx;
+  recheck_ctx.set_validation_cache(cache);
+  EXPECT_THROW(check_model(model, recheck_ctx), ValidationError);
+}
+
+TEST(ValidationCacheTest, SchemaRegistrationInvalidates) {
+  auto cache = std::make_shared<ValidationCache>();
+  ModelProto model = MakeIfModel();
+  CheckerContext ctx;
+  ctx.set_validation_cache(cache);
+  check_model(model, ctx);
+  EXPECT_EQ(cache->size(), 1);
+
+  OpSchemaRegistry::DomainToVersionRange::Instance().AddDomainToVersion(
+      "test.validationcache", 1, 1);
+  OpSchema schema;
+  schema.SetName("CustomOp").SetDomain("test.validationcache").SinceVersion(1);
+  RegisterSchema(std::move(schema));
+  CheckerContext recheck_ctx;
+  recheck_ctx.set_validation_cache(cache);
+  check_model(model, recheck_ctx);
+  EXPECT_EQ(cache->size(), 2);
+
+  // Deregistration too.
+  DeregisterSchema("CustomOp", 1, "test.validationcache");
+  check_model(model, recheck_ctx);
+  EXPECT_EQ(cache->size(), 3);
+}
+
+TEST(DiagnosticsTest, CollectAllErrors) {
+  ModelProto model = MakeIfModel();
+  GraphProto* graph = model.mutable_graph();
+  // Unsorted: reads the output of the If node that follows it.
+  NodeProto* unsorted = graph->add_node();
+  unsorted->set_op_type("Relu");
+  unsorted->add_input("Z");
+  unsorted->add_output("R");
+  graph->mutable_node()->SwapElements(1, 2);
+  // Invalid subgraph node.
+  graph->mutable_node(2)
+      ->mutable_attribute(1)
+      ->mutable_g()
+      ->mutable_node(0)
+      ->set_op_type("NoSuchOp");
+
+  EXPECT_THROW(check_model(model), ValidationError);
+  std::vector<Diagnostic> diagnostics = collect_model_diagnostics(model);
+  ASSERT_EQ(diagnostics.size(), 2);
+  EXPECT_EQ(diagnostics[0].code, DiagnosticCode::UnsortedNode);
+  EXPECT_EQ(diagnostics[0].graph_name, "main");
+  EXPECT_EQ(diagnostics[0].node_index, 1);
+  EXPECT_EQ(diagnostics[0].op_type, "Relu");
+  EXPECT_EQ(diagnostics[1].code, DiagnosticCode::InvalidNode);
+  EXPECT_EQ(diagnostics[1].graph_name, "else_branch");
+  EXPECT_EQ(diagnostics[1].node_index, 0);
+  EXPECT_EQ(diagnostics[1].op_type, "NoSuchOp");
+  // The node dump is only rendered on request.
+  EXPECT_EQ(diagnostics[0].message.find("op_type"), std::string::npos);
+  EXPECT_NE(diagnostics[0].to_string().find("op_type"), std::string::npos);
+
+  // The invalid subgraph must not be cached along with its If node.
+  auto cache = std::make_shared<ValidationCache>();
+  CheckerContext ctx;
+  ctx.set_validation_cache(cache);
+  std::vector<Diagnostic> recorded;
+  ctx.set_diagnostics(&recorded);
+  check_model(model, ctx);
+  check_model(model, ctx);
+  EXPECT_EQ(recorded.size(), 4);
+}
+
+// Forwards to the default registry, counting the lookups.
+class CountingSchemaRegistry final : public ISchemaRegistry {
+ public:
+  const OpSchema* GetSchema(
+      const std::string& key,
+      const int maxInclusiveVersion,
+      const std::string& domain) const override {
+    ++lookups;
+    return OpSchemaRegistry::Schema(key, maxInclusiveVersion, domain);
+  }
+
+  mutable int lookups = 0;
+};
+
+TEST(SchemaResolutionCacheTest, LookupOncePerOp) {
+  ModelProto model = MakeIfModel();
+  GraphProto* graph = model.mutable_graph();
+  // Y = Relu(Relu(Relu(Relu(X))))
+  graph->mutable_node(0)->set_output(0, "Y0");
+  for (int i = 1; i < 4; ++i) {
+    NodeProto* relu = graph->add_node();
+    relu->set_op_type("Relu");
+    relu->add_input("Y" + std::to_string(i - 1));
+    relu->add_output(i == 3 ? "Y" : "Y" + std::to_string(i));
+  }
+  graph->mutable_node()->SwapElements(1, 4);
+  graph->mutable_node()->SwapElements(1, 2);
+  graph->mutable_node()->SwapElements(2, 3);
+
+  CountingSchemaRegistry registry;
+  CheckerContext ctx;
+  ctx.set_schema_registry(&registry);
+  check_model(model, ctx);
+  // Relu, If and, through the context copies of the branches, Identity.
+  EXPECT_EQ(registry.lookups, 3);
+  // The cache belongs to that run, and a later run resolves afresh.
+  EXPECT_EQ(ctx.get_schema_cache(), nullptr);
+  registry.lookups = 0;
+  check_model(model, ctx);
+  EXPECT_EQ(registry.lookups, 3);
+
+  SchemaResolutionCache cache({{ONNX_DOMAIN, 13}}, &registry);
+  registry.lookups = 0;
+  EXPECT_EQ(cache.GetSchema("NoSuchOp", ONNX_DOMAIN), nullptr);
+  EXPECT_EQ(cache.GetSchema("NoSuchOp", ONNX_DOMAIN), nullptr);
+  EXPECT_EQ(cache.GetSchema("Relu", "com.example"), nullptr);
+  EXPECT_EQ(cache.GetDomainVersion("com.example"), nullptr);
+  EXPECT_EQ(*cache.GetDomainVersion(ONNX_DOMAIN), 13);
+  EXPECT_EQ(registry.lookups, 1);
+
+  registry.lookups = 0;
+  shape_inference::InferShapes(model, false, &registry);
+  // Relu and If for the main graph, and Identity once for each branch.
+  EXPECT_EQ(registry.lookups, 4);
+}
+
+} // namespace Test
+} // namespace ONNX_NAMESPACE
@@ -1,5 +1,10 @@
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <map>
+#include <thread>
 #include "gtest/gtest.h"
+#include "onnx/defs/operator_sets.h"
 #include "onnx/defs/schema.h"
 
 namespace ONNX_NAMESPACE
@@ -20,5 +25,233 @@ namespace ONNX_NAMESPACE
 			EXPECT_NE(opSchema->attributes().count("beta"), 0);
 			EXPECT_EQ(opSchema->attributes().at("beta").type, AttributeProto_AttributeType_FLOAT);
 		}
+
+		TEST(OpRegistrationTest, VersionLookup)
+		{
+			// Since versions of each (op_type, domain), in increasing order.
+			std::map<std::pair<std::string, std::string>, std::vector<int>> versions;
+			for (const auto& schema : OpSchemaRegistry::get_all_schemas_with_history())
+			{
+				versions[{schema.Name(), schema.domain()}].push_back(schema.SinceVersion());
+			}
+			for (auto& op : versions)
+			{
+				const std::string& name = op.first.first;
+				const std::string& domain = op.first.second;
+				std::vector<int>& since = op.second;
+				std::sort(since.begin(), since.end());
+				EXPECT_EQ(OpSchemaRegistry::Schema(name, since.front() - 1, domain), nullptr) << name;
+				for (size_t i = 0; i < since.size(); ++i)
+				{
+					const int last = i + 1 < since.size() ? since[i + 1] - 1 : since[i] + 100;
+					for (int version = since[i]; version <= last; ++version)
+					{
+						const OpSchema* schema = OpSchemaRegistry::Schema(name, version, domain);
+						ASSERT_NE(schema, nullptr) << name << " " << version;
+						EXPECT_EQ(schema->Name(), name);
+						EXPECT_EQ(schema->SinceVersion(), since[i]) << name << " " << version;
+					}
+				}
+				EXPECT_EQ(OpSchemaRegistry::Schema(name, domain)->SinceVersion(), since.back());
+			}
+			EXPECT_EQ(OpSchemaRegistry::Schema("Gemm", 13, "unknown.domain"), nullptr);
+			EXPECT_EQ(OpSchemaRegistry::Schema("NotAnOp", 13), nullptr);
+		}
+
+		TEST(OpRegistrationTest, SchemaTables)
+		{
+			size_t count = 0;
+			for (const auto& table : OnnxOperatorSetSchemaTables())
+			{
+				for (const auto& entry : table)
+				{
+					const OpSchema* schema = OpSchemaRegistry::Schema(entry.name, entry.since_version);
+					ASSERT_NE(schema, nullptr) << entry.name;
+					EXPECT_EQ(schema->Name(), entry.name);
+					EXPECT_EQ(schema->SinceVersion(), entry.since_version);
+					// Schemas are constructed once, on their first lookup.
+					EXPECT_EQ(OpSchemaRegistry::Schema(entry.name, entry.since_version), schema);
+					++count;
+				}
+			}
+			size_t registered = 0;
+			for (const auto& schema : OpSchemaRegistry::get_all_schemas_with_history())
+			{
+				registered += schema.domain() == ONNX_DOMAIN;
+			}
+			EXPECT_EQ(count, registered);
+		}
+
+		TEST(OpRegistrationTest, OpsetView)
+		{
+			const std::unordered_map<std::string, int> imports{{ONNX_DOMAIN, 11}, {AI_ONNX_ML_DOMAIN, 2}};
+			auto view = OpsetView::Get(imports);
+			// Views are shared by the callers asking for the same imports.
+			EXPECT_EQ(OpsetView::Get({{AI_ONNX_ML_DOMAIN, 2}, {ONNX_DOMAIN, 11}}), view);
+			EXPECT_NE(OpsetView::Get({{ONNX_DOMAIN, 13}}), view);
+			ASSERT_NE(view->GetDomainVersion(ONNX_DOMAIN), nullptr);
+			EXPECT_EQ(*view->GetDomainVersion(ONNX_DOMAIN), 11);
+			EXPECT_EQ(view->GetDomainVersion(AI_ONNX_TRAINING_DOMAIN), nullptr);
+
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; ++t)
+			{
+				threads.emplace_back([&view, &imports]()
+				{
+					EXPECT_EQ(OpsetView::Get(imports), view);
+					for (const char* op : {"Add", "Gemm", "ReduceSum", "Split", "Clip"})
+					{
+						EXPECT_EQ(view->GetSchema(op, ONNX_DOMAIN), OpSchemaRegistry::Schema(op, 11));
+					}
+					EXPECT_EQ(view->GetSchema("TreeEnsembleClassifier", AI_ONNX_ML_DOMAIN), OpSchemaRegistry::Schema("TreeEnsembleClassifier", 2, AI_ONNX_ML_DOMAIN));
+				});
+			}
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+			// Ops introduced after the imported version, unknown ops and ops of
+			// domains not imported have no schema.
+			EXPECT_EQ(view->GetSchema("Celu", ONNX_DOMAIN), nullptr);
+			EXPECT_EQ(view->GetSchema("NotAnOp", ONNX_DOMAIN), nullptr);
+			EXPECT_EQ(view->GetSchema("Gradient", AI_ONNX_PREVIEW_TRAINING_DOMAIN), nullptr);
+
+			// Registering a schema makes the views resolved before stale.
+			const std::unordered_map<std::string, int> customImports{{"test.opsetview", 1}};
+			OpSchemaRegistry::DomainToVersionRange::Instance().AddDomainToVersion("test.opsetview", 1, 1);
+			auto customView = OpsetView::Get(customImports);
+			EXPECT_EQ(customView->GetSchema("ViewOp", "test.opsetview"), nullptr);
+			OpSchema schema;
+			schema.SetName("ViewOp").SetDomain("test.opsetview").SinceVersion(1);
+			RegisterSchema(std::move(schema));
+			auto updatedView = OpsetView::Get(customImports);
+			EXPECT_NE(updatedView, customView);
+			ASSERT_NE(updatedView->GetSchema("ViewOp", "test.opsetview"), nullptr);
+			EXPECT_EQ(updatedView->GetSchema("ViewOp", "test.opsetview"), OpSchemaRegistry::Schema("ViewOp", 1, "test.opsetview"));
+
+			// Each thread keeps its last few views, but any number of imports
+			// may be resolved, and views in use are still shared.
+			auto current = OpsetView::Get(imports);
+			for (int version = 1; version <= 13; ++version)
+			{
+				auto versionView = OpsetView::Get({{ONNX_DOMAIN, version}});
+				EXPECT_EQ(*versionView->GetDomainVersion(ONNX_DOMAIN), version);
+				EXPECT_EQ(OpsetView::Get({{ONNX_DOMAIN, version}}), versionView);
+			}
+			EXPECT_EQ(OpsetView::Get(imports), current);
+		}
+
+		TEST(OpRegistrationTest, ConcurrentRegistration)
+		{
+			const std::string domain = "test.concurrent";
+			OpSchemaRegistry::DomainToVersionRange::Instance().AddDomainToVersion(domain, 1, 1);
+			const int count = 200;
+			std::atomic<bool> done(false);
+			// Lookups run while schemas and domains are registered and deregistered.
+			std::vector<std::thread> readers;
+			for (int t = 0; t < 4; ++t)
+			{
+				readers.emplace_back([&]()
+				{
+					while (!done.load())
+					{
+						EXPECT_NE(OpSchemaRegistry::Schema("Add", 13), nullptr);
+						for (int i = 0; i < count; i += 17)
+						{
+							const std::string name = "Op" + std::to_string(i);
+							const OpSchema* schema = OpSchemaRegistry::Schema(name, 1, domain);
+							if (schema != nullptr)
+							{
+								EXPECT_EQ(schema->Name(), name);
+							}
+						}
+						EXPECT_EQ(OpSchemaRegistry::DomainToVersionRange::Instance().Map().count(domain), 1);
+					}
+				});
+			}
+			for (int i = 0; i < count; ++i)
+			{
+				OpSchema schema;
+				schema.SetName("Op" + std::to_string(i)).SetDomain(domain).SinceVersion(1);
+				RegisterSchema(std::move(schema));
+				OpSchemaRegistry::DomainToVersionRange::Instance().AddDomainToVersion(domain + "." + std::to_string(i), 1, 1);
+				if (i % 2 == 0)
+				{
+					DeregisterSchema("Op" + std::to_string(i), 1, domain);
+				}
+			}
+			done = true;
+			for (auto& reader : readers)
+			{
+				reader.join();
+			}
+
+			for (int i = 0; i < count; ++i)
+			{
+				EXPECT_EQ(OpSchemaRegistry::Schema("Op" + std::to_string(i), 1, domain) != nullptr, i % 2 == 1) << i;
+			}
+			// A deregistered schema stays valid, and its version may be registered again.
+			const OpSchema* deregistered = OpSchemaRegistry::Schema("Op1", domain);
+			DeregisterSchema("Op1", 1, domain);
+			EXPECT_EQ(OpSchemaRegistry::Schema("Op1", domain), nullptr);
+			EXPECT_EQ(deregistered->Name(), "Op1");
+			OpSchema schema;
+			schema.SetName("Op1").SetDomain(domain).SinceVersion(1);
+			RegisterSchema(std::move(schema));
+			ASSERT_NE(OpSchemaRegistry::Schema("Op1", domain), nullptr);
+			EXPECT_NE(OpSchemaRegistry::Schema("Op1", domain), deregistered);
+			EXPECT_THROW(DeregisterSchema("Op0", 1, domain), SchemaError);
+
+			// Deregistering a schema makes the views resolved before stale.
+			const std::unordered_map<std::string, int> imports{{domain, 1}};
+			auto view = OpsetView::Get(imports);
+			ASSERT_NE(view->GetSchema("Op3", domain), nullptr);
+			DeregisterSchema("Op3", 1, domain);
+			auto updatedView = OpsetView::Get(imports);
+			EXPECT_NE(updatedView, view);
+			EXPECT_EQ(updatedView->GetSchema("Op3", domain), nullptr);
+			EXPECT_EQ(updatedView->GetSchema("Op5", domain), OpSchemaRegistry::Schema("Op5", 1, domain));
+		}
+
+		TEST(OpRegistrationTest, RegistrationChurn)
+		{
+			const std::string domain = "test.churn";
+			OpSchemaRegistry::DomainToVersionRange::Instance().AddDomainToVersion(domain, 1, 2);
+			std::atomic<bool> done(false);
+			// The versions replaced by each change are freed while lookups run.
+			std::vector<std::thread> readers;
+			for (int t = 0; t < 4; ++t)
+			{
+				readers.emplace_back([&]()
+				{
+					while (!done.load())
+					{
+						const OpSchema* schema = OpSchemaRegistry::Schema("Churn", 2, domain);
+						if (schema != nullptr)
+						{
+							EXPECT_EQ(schema->Name(), "Churn");
+							EXPECT_EQ(schema->domain(), domain);
+						}
+					}
+				});
+			}
+			for (int i = 0; i < 1000; ++i)
+			{
+				OpSchema schema;
+				schema.SetName("Churn").SetDomain(domain).SinceVersion(1 + i % 2);
+				RegisterSchema(std::move(schema));
+				if (i % 2 == 1)
+				{
+					DeregisterSchema("Churn", 1, domain);
+					DeregisterSchema("Churn", 2, domain);
+				}
+			}
+			done = true;
+			for (auto& reader : readers)
+			{
+				reader.join();
+			}
+			EXPECT_EQ(OpSchemaRegistry::Schema("Churn", 2, domain), nullptr);
+		}
 	}
 }
\ No newline at end of file
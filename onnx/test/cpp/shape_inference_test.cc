@@ -4,7 +4,9 @@
 #include "onnx/defs/shape_inference.h"
 #include "onnx/onnx_pb.h"
 
+#include "onnx/common/ir_pb_converter.h"
 #include "onnx/shape_inference/implementation.h"
+#include "onnx/shape_inference/ir_inference.h"
 
 using namespace ONNX_NAMESPACE::shape_inference;
 
@@ -397,5 +399,815 @@ TEST(GraphInferencerImplTest, Scan9_BasicTest) {
   doInferencingTest(false);
 }
 
+TEST(ShapeInferenceTest, ReuseInferenceContext) {
+  TypeProto x_type;
+  CreateDims(*x_type.mutable_tensor_type(), 2);
+  SetDimValues(*x_type.mutable_tensor_type(), {2, 3});
+  std::unordered_map<std::string, TypeProto*> valueTypesByName{{"X", &x_type}};
+  ValueTypeScope valueTypes(&valueTypesByName);
+  std::unordered_map<std::string, const TensorProto*> inputDataByName;
+
+  NodeProto split;
+  split.add_input("X");
+  split.add_output("A");
+  split.add_output("B");
+  for (const char* name : {"split", "axis", "b", "a"}) {
+    AttributeProto* attr = split.add_attribute();
+    attr->set_name(name);
+    attr->set_type(AttributeProto::INT);
+    attr->set_i(name[0]);
+  }
+  NodeProto relu;
+  relu.add_input("Y");
+  relu.add_output("Z");
+
+  InferenceContextImpl ctx;
+  ctx.reset(split, valueTypes, inputDataByName);
+  EXPECT_EQ(ctx.getNumInputs(), 1);
+  EXPECT_EQ(ctx.getInputType(0), &x_type);
+  EXPECT_EQ(ctx.getNumOutputs(), 2);
+  for (const char* name : {"a", "axis", "b", "split"}) {
+    ASSERT_NE(ctx.getAttribute(name), nullptr);
+    EXPECT_EQ(ctx.getAttribute(name)->i(), name[0]);
+  }
+  EXPECT_EQ(ctx.getAttribute("c"), nullptr);
+  EXPECT_EQ(ctx.getAttribute(""), nullptr);
+  ctx.getOutputType(0)->mutable_tensor_type()->set_elem_type(
+      TensorProto::FLOAT);
+
+  // Nothing of the previous node is visible after a reset.
+  ctx.reset(relu, valueTypes, inputDataByName);
+  EXPECT_EQ(ctx.getNumInputs(), 1);
+  EXPECT_EQ(ctx.getInputType(0), nullptr);
+  EXPECT_EQ(ctx.getNumOutputs(), 1);
+  EXPECT_EQ(ctx.getAttribute("axis"), nullptr);
+  EXPECT_FALSE(ctx.getOutputType(0)->has_tensor_type());
+  EXPECT_THROW(ctx.getOutputType(1), std::runtime_error);
+}
+
+static NodeProto* AddNode(
+    GraphProto* graph,
+    const std::string& op_type,
+    const std::vector<std::string>& inputs,
+    const std::string& output) {
+  NodeProto* node = graph->add_node();
+  node->set_op_type(op_type);
+  for (const auto& input : inputs) {
+    node->add_input(input);
+  }
+  node->add_output(output);
+  return node;
+}
+
+// Wide layers of independent nodes, followed by an If whose branches read a
+// value of the main graph.
+static ModelProto CreateWideModel() {
+  ModelProto model;
+  model.set_ir_version(IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain(ONNX_DOMAIN);
+  opset->set_version(11);
+  GraphProto* graph = model.mutable_graph();
+  auto* x = graph->add_input();
+  x->set_name("X");
+  auto* x_type = x->mutable_type()->mutable_tensor_type();
+  x_type->set_elem_type(TensorProto::FLOAT);
+  x_type->mutable_shape()->add_dim()->set_dim_value(4);
+  x_type->mutable_shape()->add_dim()->set_dim_param("N");
+  auto* cond = graph->add_input();
+  cond->set_name("C");
+  cond->mutable_type()->mutable_tensor_type()->set_elem_type(
+      TensorProto::BOOL);
+
+  std::string sum = "X";
+  for (int i = 0; i < 32; ++i) {
+    const std::string id = std::to_string(i);
+    AddNode(graph, "Relu", {"X"}, "relu" + id);
+    AddNode(graph, "Sigmoid", {"relu" + id}, "sigmoid" + id);
+    AddNode(graph, "Add", {sum, "sigmoid" + id}, "sum" + id);
+    sum = "sum" + id;
+  }
+  NodeProto* if_node = AddNode(graph, "If", {"C"}, "Y");
+  for (const char* branch : {"then_branch", "else_branch"}) {
+    AttributeProto* attr = if_node->add_attribute();
+    attr->set_name(branch);
+    attr->set_type(AttributeProto::GRAPH);
+    GraphProto* body = attr->mutable_g();
+    body->set_name(branch);
+    AddNode(body, "Neg", {sum}, std::string(branch) + "_out");
+    auto* out = body->add_output();
+    out->set_name(std::string(branch) + "_out");
+    out->mutable_type()->mutable_tensor_type()->set_elem_type(
+        TensorProto::FLOAT);
+  }
+  AddNode(graph, "Transpose", {"Y"}, "Z");
+  return model;
+}
+
+TEST(ShapeInferenceTest, ParallelMatchesSequential) {
+  ModelProto sequential = CreateWideModel();
+  InferShapes(sequential);
+
+  ModelProto parallel = CreateWideModel();
+  ShapeInferenceOptions options;
+  options.num_threads = 4;
+  InferShapes(parallel, options);
+
+  // Every node output has a type, including those inferred from subgraphs.
+  EXPECT_EQ(parallel.graph().value_info_size(), 32 * 3 + 2);
+  EXPECT_EQ(sequential.SerializeAsString(), parallel.SerializeAsString());
+}
+
+static std::string InferShapesError(
+    ModelProto& model,
+    const ShapeInferenceOptions& options) {
+  try {
+    InferShapes(model, options);
+  } catch (const std::runtime_error& err) {
+    return err.what();
+  }
+  return std::string();
+}
+
+TEST(ShapeInferenceTest, ParallelErrorsMatchSequential) {
+  // A = Relu(X); B = Relu(A); C = Relu(X), where the given types of B and C
+  // both conflict with the inferred one. B comes first in node order but
+  // its wavefront is inferred after C's.
+  ModelProto model;
+  model.set_ir_version(IR_VERSION);
+  model.add_opset_import()->set_version(13);
+  GraphProto* graph = model.mutable_graph();
+  auto* x = graph->add_input();
+  x->set_name("X");
+  x->mutable_type()->mutable_tensor_type()->set_elem_type(TensorProto::FLOAT);
+  AddNode(graph, "Relu", {"X"}, "A");
+  AddNode(graph, "Relu", {"A"}, "B");
+  AddNode(graph, "Relu", {"X"}, "C");
+  auto* b = graph->add_value_info();
+  b->set_name("B");
+  b->mutable_type()->mutable_tensor_type()->set_elem_type(TensorProto::INT32);
+  auto* c = graph->add_value_info();
+  c->set_name("C");
+  c->mutable_type()->mutable_tensor_type()->set_elem_type(TensorProto::INT64);
+
+  ModelProto sequential = model;
+  const std::string sequential_error =
+      InferShapesError(sequential, ShapeInferenceOptions());
+  ModelProto parallel = model;
+  ShapeInferenceOptions options;
+  options.num_threads = 4;
+  const std::string parallel_error = InferShapesError(parallel, options);
+
+  EXPECT_NE(sequential_error.find("INT32"), std::string::npos);
+  EXPECT_EQ(sequential_error, parallel_error);
+  EXPECT_EQ(sequential.SerializeAsString(), parallel.SerializeAsString());
+}
+
+static GraphProto* AddBranch(NodeProto* if_node, const char* branch) {
+  AttributeProto* attr = if_node->add_attribute();
+  attr->set_name(branch);
+  attr->set_type(AttributeProto::GRAPH);
+  GraphProto* body = attr->mutable_g();
+  body->set_name(branch);
+  auto* out = body->add_output();
+  out->set_name(if_node->output(0) + "_" + branch);
+  out->mutable_type()->mutable_tensor_type()->set_elem_type(
+      TensorProto::FLOAT);
+  return body;
+}
+
+TEST(ShapeInferenceTest, NestedSubgraphScopes) {
+  ModelProto model = CreateWideModel();
+  GraphProto* graph = model.mutable_graph();
+  graph->mutable_node()->RemoveLast(); // Transpose
+  graph->mutable_node()->RemoveLast(); // If
+
+  // Y = If(C) { A = Relu(X); Y = If(C) { X + A } else { A } }
+  //     else { Neg(X) }
+  NodeProto* outer_if = AddNode(graph, "If", {"C"}, "Y");
+  GraphProto* then_body = AddBranch(outer_if, "then_branch");
+  AddNode(then_body, "Relu", {"X"}, "A");
+  NodeProto* inner_if = AddNode(then_body, "If", {"C"}, "Y_then_branch");
+  AddNode(
+      AddBranch(inner_if, "then_branch"),
+      "Add",
+      {"X", "A"},
+      "Y_then_branch_then_branch");
+  AddNode(
+      AddBranch(inner_if, "else_branch"),
+      "Identity",
+      {"A"},
+      "Y_then_branch_else_branch");
+  AddNode(AddBranch(outer_if, "else_branch"), "Neg", {"X"}, "Y_else_branch");
+
+  InferShapes(model);
+  const GraphProto& inner_then = model.graph()
+                                     .node(graph->node_size() - 1)
+                                     .attribute(0)
+                                     .g()
+                                     .node(1)
+                                     .attribute(0)
+                                     .g();
+  const auto& inner_shape = inner_then.output(0).type().tensor_type().shape();
+  ASSERT_EQ(inner_shape.dim_size(), 2);
+  EXPECT_EQ(inner_shape.dim(0).dim_value(), 4);
+  EXPECT_EQ(inner_shape.dim(1).dim_param(), "N");
+  // Inner graphs don't get the types of the values of the outer graphs.
+  EXPECT_EQ(inner_then.value_info_size(), 0);
+
+  const ValueInfoProto* y = nullptr;
+  for (const auto& value_info : model.graph().value_info()) {
+    if (value_info.name() == "Y") {
+      y = &value_info;
+    }
+  }
+  ASSERT_NE(y, nullptr);
+  EXPECT_EQ(y->type().tensor_type().shape().dim_size(), 2);
+}
+
+// X -> Relu -> A -> Shape -> S -> Identity -> T, and an independent
+// W -> Neg -> B.
+static ModelProto CreateIncrementalModel(int64_t x_dim) {
+  ModelProto model;
+  model.set_ir_version(IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain(ONNX_DOMAIN);
+  opset->set_version(11);
+  GraphProto* graph = model.mutable_graph();
+  for (const char* name : {"X", "W"}) {
+    auto* input = graph->add_input();
+    input->set_name(name);
+    auto* type = input->mutable_type()->mutable_tensor_type();
+    type->set_elem_type(TensorProto::FLOAT);
+    type->mutable_shape()->add_dim()->set_dim_value(
+        name[0] == 'X' ? x_dim : 4);
+    type->mutable_shape()->add_dim()->set_dim_value(3);
+  }
+  AddNode(graph, "Relu", {"X"}, "A");
+  AddNode(graph, "Shape", {"A"}, "S");
+  AddNode(graph, "Identity", {"S"}, "T");
+  AddNode(graph, "Neg", {"W"}, "B");
+  return model;
+}
+
+TEST(ShapeInferenceTest, IncrementalInference) {
+  ModelProto model = CreateIncrementalModel(4);
+  InferShapes(model);
+  ASSERT_EQ(model.graph().value_info_size(), 4);
+
+  // Only Relu and Shape are re-inferred: the type of S doesn't depend on the
+  // changed dimension.
+  model.mutable_graph()
+      ->mutable_input(0)
+      ->mutable_type()
+      ->mutable_tensor_type()
+      ->mutable_shape()
+      ->mutable_dim(0)
+      ->set_dim_value(8);
+  EXPECT_EQ(InferShapesIncremental(model, {"X"}), 2);
+  EXPECT_EQ(
+      model.graph().value_info(0).type().tensor_type().shape().dim(0)
+          .dim_value(),
+      8);
+
+  ModelProto expected = CreateIncrementalModel(8);
+  InferShapes(expected);
+  EXPECT_EQ(model.SerializeAsString(), expected.SerializeAsString());
+
+  // A replaced node is re-inferred along with its consumers.
+  model.mutable_graph()->mutable_node(1)->set_op_type("Neg");
+  EXPECT_EQ(InferShapesIncremental(model, {"S"}), 2);
+  EXPECT_EQ(model.graph().value_info(1).name(), "S");
+  EXPECT_EQ(
+      model.graph().value_info(1).type().tensor_type().elem_type(),
+      TensorProto::FLOAT);
+  EXPECT_EQ(
+      model.graph().value_info(2).type().tensor_type().shape().dim_size(), 2);
+}
+
+// Adds an int64 initializer, and a graph input declaring its type.
+static void AddInt64Initializer(
+    GraphProto* graph,
+    const std::string& name,
+    const std::vector<int64_t>& values,
+    bool scalar = false) {
+  TensorProto* initializer = graph->add_initializer();
+  initializer->set_name(name);
+  initializer->set_data_type(TensorProto::INT64);
+  auto* input = graph->add_input();
+  input->set_name(name);
+  auto* type = input->mutable_type()->mutable_tensor_type();
+  type->set_elem_type(TensorProto::INT64);
+  type->mutable_shape();
+  if (!scalar) {
+    initializer->add_dims(values.size());
+    type->mutable_shape()->add_dim()->set_dim_value(values.size());
+  }
+  for (int64_t value : values) {
+    initializer->add_int64_data(value);
+  }
+}
+
+static ModelProto CreateShapeComputationModel() {
+  ModelProto model;
+  model.set_ir_version(IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain(ONNX_DOMAIN);
+  opset->set_version(13);
+  GraphProto* graph = model.mutable_graph();
+  auto* x = graph->add_input();
+  x->set_name("X");
+  auto* x_type = x->mutable_type()->mutable_tensor_type();
+  x_type->set_elem_type(TensorProto::FLOAT);
+  x_type->mutable_shape()->add_dim()->set_dim_param("batch");
+  x_type->mutable_shape()->add_dim()->set_dim_param("seq");
+  x_type->mutable_shape()->add_dim()->set_dim_value(64);
+  AddInt64Initializer(graph, "zero", {0});
+  AddInt64Initializer(graph, "one", {1});
+  AddInt64Initializer(graph, "two", {2});
+  AddInt64Initializer(graph, "three", {3});
+  AddInt64Initializer(graph, "minus_one", {-1});
+  AddInt64Initializer(graph, "scalar_one", {1}, true);
+
+  AddNode(graph, "Shape", {"X"}, "S");
+  AddNode(graph, "Gather", {"S", "zero"}, "batch");
+  AddNode(graph, "Gather", {"S", "scalar_one"}, "seq");
+  AttributeProto* axes =
+      AddNode(graph, "Unsqueeze", {"seq"}, "seq_1d")->add_attribute();
+  axes->set_name("axes");
+  axes->set_type(AttributeProto::INTS);
+  axes->add_ints(0);
+  // ConstantOfShape((batch, seq + 1))
+  AddNode(graph, "Add", {"seq_1d", "one"}, "seq_plus_one");
+  AddNode(graph, "Concat", {"batch", "seq_plus_one"}, "padded_shape")
+      ->add_attribute()
+      ->set_name("axis");
+  AddNode(graph, "ConstantOfShape", {"padded_shape"}, "padded");
+  // Reshape(X, (-1, 64)), with a fully known target shape.
+  AddNode(graph, "Slice", {"S", "two", "three"}, "features");
+  AddNode(graph, "Concat", {"minus_one", "features"}, "flat_shape")
+      ->add_attribute()
+      ->set_name("axis");
+  AddNode(graph, "Reshape", {"X", "flat_shape"}, "flat");
+  // Reshape(X, (batch * seq, 64)), with a symbolic target shape.
+  AddNode(graph, "Mul", {"batch", "seq_1d"}, "rows");
+  AddNode(graph, "Concat", {"rows", "features"}, "rows_shape")
+      ->add_attribute()
+      ->set_name("axis");
+  AddNode(graph, "Reshape", {"X", "rows_shape"}, "rows_flat");
+  // Reshape(X, (batch, seq, -1)), which keeps the symbolic dimensions.
+  AddNode(graph, "Concat", {"batch", "seq_1d", "minus_one"}, "kept_shape")
+      ->add_attribute()
+      ->set_name("axis");
+  AddNode(graph, "Reshape", {"X", "kept_shape"}, "kept");
+  // Reshape(X, (seq + 1, seq - 1, batch)); only seq + 1 cannot be 0 or -1.
+  AddNode(graph, "Sub", {"seq_1d", "one"}, "seq_minus_one");
+  AddNode(
+      graph, "Concat", {"seq_plus_one", "seq_minus_one", "batch"}, "mixed_shape")
+      ->add_attribute()
+      ->set_name("axis");
+  AddNode(graph, "Reshape", {"X", "mixed_shape"}, "mixed");
+  for (auto& node : *graph->mutable_node()) {
+    if (node.op_type() == "Concat") {
+      node.mutable_attribute(0)->set_type(AttributeProto::INT);
+      node.mutable_attribute(0)->set_i(0);
+    }
+  }
+  return model;
+}
+
+static const TensorShapeProto* InferredShape(
+    const ModelProto& model,
+    const std::string& name) {
+  for (const auto& value_info : model.graph().value_info()) {
+    if (value_info.name() == name &&
+        value_info.type().tensor_type().has_shape()) {
+      return &value_info.type().tensor_type().shape();
+    }
+  }
+  return nullptr;
+}
+
+TEST(ShapeInferenceTest, DataPropagation) {
+  ModelProto model = CreateShapeComputationModel();
+  InferShapes(model);
+  EXPECT_EQ(InferredShape(model, "rows_flat"), nullptr);
+  EXPECT_EQ(InferredShape(model, "flat"), nullptr);
+
+  model = CreateShapeComputationModel();
+  ShapeInferenceOptions options;
+  options.enable_data_propagation = true;
+  InferShapes(model, options);
+  const TensorShapeProto* padded = InferredShape(model, "padded");
+  ASSERT_NE(padded, nullptr);
+  ASSERT_EQ(padded->dim_size(), 2);
+  EXPECT_EQ(padded->dim(0).dim_param(), "batch");
+  EXPECT_EQ(padded->dim(1).dim_param(), "seq + 1");
+  const TensorShapeProto* flat = InferredShape(model, "flat");
+  ASSERT_NE(flat, nullptr);
+  ASSERT_EQ(flat->dim_size(), 2);
+  EXPECT_EQ(flat->dim(0).dim_param(), "batch*seq");
+  EXPECT_EQ(flat->dim(1).dim_value(), 64);
+  // batch*seq may be 0 at runtime, in which case Reshape copies batch.
+  const TensorShapeProto* rows_flat = InferredShape(model, "rows_flat");
+  ASSERT_NE(rows_flat, nullptr);
+  ASSERT_EQ(rows_flat->dim_size(), 2);
+  EXPECT_FALSE(rows_flat->dim(0).has_dim_param());
+  EXPECT_EQ(rows_flat->dim(1).dim_value(), 64);
+  const TensorShapeProto* kept = InferredShape(model, "kept");
+  ASSERT_NE(kept, nullptr);
+  ASSERT_EQ(kept->dim_size(), 3);
+  EXPECT_EQ(kept->dim(0).dim_param(), "batch");
+  EXPECT_EQ(kept->dim(1).dim_param(), "seq");
+  EXPECT_FALSE(kept->dim(2).has_dim_value());
+  const TensorShapeProto* mixed = InferredShape(model, "mixed");
+  ASSERT_NE(mixed, nullptr);
+  ASSERT_EQ(mixed->dim_size(), 3);
+  EXPECT_EQ(mixed->dim(0).dim_param(), "seq + 1");
+  EXPECT_FALSE(mixed->dim(1).has_dim_param());
+  EXPECT_FALSE(mixed->dim(2).has_dim_param());
+
+  ModelProto parallel = CreateShapeComputationModel();
+  options.num_threads = 4;
+  InferShapes(parallel, options);
+  EXPECT_EQ(model.SerializeAsString(), parallel.SerializeAsString());
+}
+
+static std::string DimsToString(const TypeProto& type) {
+  std::string dims;
+  for (const auto& dim : type.tensor_type().shape().dim()) {
+    dims += (dim.has_dim_value() ? std::to_string(dim.dim_value())
+                                 : dim.dim_param()) +
+        ",";
+  }
+  return std::to_string(type.tensor_type().elem_type()) + ":" + dims;
+}
+
+TEST(ShapeInferenceTest, InferIRGraph) {
+  ModelProto model = CreateWideModel();
+  // Flatten Z through an initialized shape input.
+  GraphProto* graph = model.mutable_graph();
+  TensorProto* shape = graph->add_initializer();
+  shape->set_name("shape");
+  shape->set_data_type(TensorProto::INT64);
+  shape->add_dims(1);
+  shape->add_int64_data(-1);
+  auto* shape_input = graph->add_input();
+  shape_input->set_name("shape");
+  auto* shape_type = shape_input->mutable_type()->mutable_tensor_type();
+  shape_type->set_elem_type(TensorProto::INT64);
+  shape_type->mutable_shape()->add_dim()->set_dim_value(1);
+  AddNode(graph, "Reshape", {"Z", "shape"}, "flat");
+
+  ModelProto expected = model;
+  InferShapes(expected);
+
+  std::shared_ptr<Graph> ir(ImportModelProto(model));
+  InferShapes(*ir);
+  const Value* flat = nullptr;
+  for (Node* node : ir->nodes()) {
+    if (node->kind() == kReshape) {
+      flat = node->output();
+    }
+  }
+  ASSERT_NE(flat, nullptr);
+  ASSERT_EQ(flat->sizes().size(), 1);
+  EXPECT_EQ(flat->sizes()[0].param, "4*N");
+  EXPECT_EQ(flat->elemType(), TensorProto::FLOAT);
+
+  // The types in the graph are those inferred from the ModelProto.
+  ModelProto exported;
+  ExportModelProto(&exported, ir);
+  std::unordered_map<std::string, std::string> inferred;
+  for (const auto& value_info : exported.graph().value_info()) {
+    inferred[value_info.name()] = DimsToString(value_info.type());
+  }
+  EXPECT_EQ(inferred.size(), expected.graph().value_info_size());
+  for (const auto& value_info : expected.graph().value_info()) {
+    EXPECT_EQ(inferred[value_info.name()], DimsToString(value_info.type()))
+        << value_info.name();
+  }
+}
+
+static void AddInitializer(
+    GraphProto* graph,
+    const std::string& name,
+    const std::vector<int64_t>& dims) {
+  TensorProto* tensor = graph->add_initializer();
+  tensor->set_name(name);
+  tensor->set_data_type(TensorProto::FLOAT);
+  int64_t size = 1;
+  for (int64_t dim : dims) {
+    tensor->add_dims(dim);
+    size *= dim;
+  }
+  for (int64_t i = 0; i < size; ++i) {
+    tensor->add_float_data(0.f);
+  }
+}
+
+TEST(ShapeInferenceTest, EstimateCost) {
+  ModelProto model;
+  model.set_ir_version(IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain(ONNX_DOMAIN);
+  opset->set_version(13);
+  GraphProto* graph = model.mutable_graph();
+  auto* x = graph->add_input();
+  x->set_name("X");
+  auto* x_type = x->mutable_type()->mutable_tensor_type();
+  x_type->set_elem_type(TensorProto::FLOAT);
+  for (int64_t dim : {1, 3, 8, 8}) {
+    x_type->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  AddInitializer(graph, "W", {4, 3, 3, 3});
+  AddInitializer(graph, "B", {4});
+  // Shape inference reads the types of initializers from the graph inputs.
+  for (const auto& initializer : graph->initializer()) {
+    auto* input = graph->add_input();
+    input->set_name(initializer.name());
+    auto* type = input->mutable_type()->mutable_tensor_type();
+    type->set_elem_type(initializer.data_type());
+    for (int64_t dim : initializer.dims()) {
+      type->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+  }
+  NodeProto* conv = AddNode(graph, "Conv", {"X", "W", "B"}, "Y");
+  AttributeProto* pads = conv->add_attribute();
+  pads->set_name("pads");
+  pads->set_type(AttributeProto::INTS);
+  for (int i = 0; i < 4; ++i) {
+    pads->add_ints(1);
+  }
+  NodeProto* pool = AddNode(graph, "MaxPool", {"Y"}, "P");
+  for (const char* name : {"kernel_shape", "strides"}) {
+    AttributeProto* attr = pool->add_attribute();
+    attr->set_name(name);
+    attr->set_type(AttributeProto::INTS);
+    attr->add_ints(2);
+    attr->add_ints(2);
+  }
+  AddNode(graph, "Transpose", {"P"}, "T");
+  InferShapes(model);
+
+  GraphCost cost = EstimateCost(model);
+  ASSERT_EQ(cost.nodes.size(), 3);
+  // Conv: (1, 4, 8, 8) outputs, 3 * 3 * 3 multiply-accumulates each, and
+  // the bias.
+  EXPECT_EQ(cost.nodes[0].flops, 2 * 27 * 256 + 256);
+  EXPECT_EQ(cost.nodes[0].param_bytes, (108 + 4) * 4);
+  EXPECT_EQ(cost.nodes[0].activation_bytes_read, 192 * 4);
+  EXPECT_EQ(cost.nodes[0].activation_bytes_written, 256 * 4);
+  // MaxPool: (1, 4, 4, 4) outputs over 2x2 windows.
+  EXPECT_EQ(cost.nodes[1].flops, 64 * 4);
+  // Transpose has no cost function.
+  EXPECT_EQ(cost.nodes[2].flops, 0);
+  EXPECT_EQ(cost.nodes[2].activation_bytes_written, 64 * 4);
+  EXPECT_EQ(cost.num_unestimated_nodes, 1);
+  EXPECT_EQ(cost.total.flops, 2 * 27 * 256 + 256 + 64 * 4);
+  EXPECT_EQ(cost.total.activation_bytes_read, (192 + 256 + 64) * 4);
+  EXPECT_TRUE(cost.total.complete);
+
+  // A symbolic batch leaves the estimate incomplete.
+  graph->clear_value_info();
+  x_type->mutable_shape()->mutable_dim(0)->set_dim_param("N");
+  InferShapes(model);
+  cost = EstimateCost(model);
+  EXPECT_FALSE(cost.nodes[0].complete);
+  EXPECT_EQ(cost.nodes[0].param_bytes, (108 + 4) * 4);
+  EXPECT_FALSE(cost.total.complete);
+}
+
+TEST(ShapeInferenceTest, PlanMemory) {
+  ModelProto model;
+  model.set_ir_version(IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain(ONNX_DOMAIN);
+  opset->set_version(13);
+  GraphProto* graph = model.mutable_graph();
+  auto* x = graph->add_input();
+  x->set_name("X");
+  auto* x_type = x->mutable_type()->mutable_tensor_type();
+  x_type->set_elem_type(TensorProto::FLOAT);
+  x_type->mutable_shape()->add_dim()->set_dim_value(4);
+  x_type->mutable_shape()->add_dim()->set_dim_value(4);
+  AddNode(graph, "Relu", {"X"}, "A");
+  AddNode(graph, "Relu", {"A"}, "B");
+  AddNode(graph, "Add", {"A", "B"}, "C");
+  AddNode(graph, "Relu", {"C"}, "D");
+  graph->add_output()->set_name("D");
+  InferShapes(model);
+
+  MemoryPlan plan = PlanMemory(model);
+  ASSERT_EQ(plan.tensors.size(), 5);
+  const std::vector<std::pair<int, int>> lifetimes = {
+      {-1, 0}, {0, 2}, {1, 2}, {2, 3}, {3, 4}};
+  // X is freed after the first Relu and its block reused for B; A and B are
+  // freed together, and D reuses their merged block.
+  const std::vector<int64_t> offsets = {0, 64, 0, 128, 0};
+  for (size_t i = 0; i < plan.tensors.size(); ++i) {
+    EXPECT_EQ(plan.tensors[i].bytes, 64);
+    EXPECT_EQ(plan.tensors[i].first_use, lifetimes[i].first);
+    EXPECT_EQ(plan.tensors[i].last_use, lifetimes[i].second);
+    EXPECT_EQ(plan.tensors[i].offset, offsets[i]) << plan.tensors[i].name;
+  }
+  // A, B and C are live while the Add runs.
+  EXPECT_EQ(plan.peak_bytes, 192);
+  EXPECT_EQ(plan.peak_node, 2);
+  EXPECT_EQ(plan.arena_bytes, 192);
+  EXPECT_TRUE(plan.complete);
+
+  // Sizes are rounded up to the alignment in the arena only.
+  plan = PlanMemory(model, 256);
+  EXPECT_EQ(plan.peak_bytes, 192);
+  EXPECT_EQ(plan.arena_bytes, 768);
+
+  graph->clear_value_info();
+  x_type->mutable_shape()->mutable_dim(0)->set_dim_param("N");
+  InferShapes(model);
+  plan = PlanMemory(model);
+  EXPECT_EQ(plan.tensors[0].bytes, -1);
+  EXPECT_EQ(plan.tensors[0].offset, -1);
+  EXPECT_EQ(plan.peak_bytes, 0);
+  EXPECT_FALSE(plan.complete);
+}
+
+TEST(ShapeInferenceTest, InferShapesForBindings) {
+  const ModelProto model = CreateWideModel();
+  std::vector<InputShapeBinding> bindings(3);
+  const int64_t batch_sizes[] = {2, 5};
+  for (size_t b = 0; b < 2; ++b) {
+    TensorShapeProto& shape = bindings[b]["X"];
+    shape.add_dim()->set_dim_value(4);
+    shape.add_dim()->set_dim_value(batch_sizes[b]);
+  }
+  // The last binding keeps the declared (4, N).
+  auto results = InferShapesForBindings(model, bindings);
+  ASSERT_EQ(results.size(), bindings.size());
+
+  for (size_t b = 0; b < bindings.size(); ++b) {
+    ModelProto expected = model;
+    auto* x = expected.mutable_graph()->mutable_input(0);
+    if (bindings[b].count("X")) {
+      *x->mutable_type()->mutable_tensor_type()->mutable_shape() =
+          bindings[b]["X"];
+    }
+    InferShapes(expected);
+    const auto& value_info = expected.graph().value_info();
+    ASSERT_EQ(results[b].size(), value_info.size());
+    for (int i = 0; i < value_info.size(); ++i) {
+      EXPECT_EQ(
+          results[b][i].SerializeAsString(),
+          value_info.Get(i).SerializeAsString())
+          << value_info.Get(i).name();
+    }
+  }
+  EXPECT_EQ(
+      results[0].back().type().tensor_type().shape().dim(0).dim_value(), 2);
+  // The model itself is not modified.
+  EXPECT_EQ(model.graph().value_info_size(), 0);
+
+  bindings[0]["Y"] = bindings[0]["X"];
+  EXPECT_THROW(InferShapesForBindings(model, bindings), InferenceError);
+  bindings[0].erase("Y");
+  bindings[0]["X"].add_dim()->set_dim_value(1);
+  EXPECT_THROW(InferShapesForBindings(model, bindings), std::runtime_error);
+}
+
+// Counts the lookups of the schema of op_type.
+class OpLookupCountingRegistry final : public ISchemaRegistry {
+ public:
+  explicit OpLookupCountingRegistry(const std::string& op_type)
+      : op_type_(op_type) {}
+
+  const OpSchema* GetSchema(
+      const std::string& key,
+      const int maxInclusiveVersion,
+      const std::string& domain) const override {
+    if (key == op_type_) {
+      ++count;
+    }
+    return OpSchemaRegistry::Instance()->GetSchema(
+        key, maxInclusiveVersion, domain);
+  }
+
+  mutable int count = 0;
+
+ private:
+  const std::string op_type_;
+};
+
+TEST(ShapeInferenceTest, FunctionInferenceCache) {
+  ModelProto model;
+  model.set_ir_version(IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain(ONNX_DOMAIN);
+  opset->set_version(13);
+  GraphProto* graph = model.mutable_graph();
+  for (const char* name : {"X", "W"}) {
+    auto* input = graph->add_input();
+    input->set_name(name);
+    auto* type = input->mutable_type()->mutable_tensor_type();
+    type->set_elem_type(TensorProto::FLOAT);
+    CreateDims(*type, 4);
+    SetDimValues(*type, {2, name[0] == 'X' ? 3 : 6, 4, 5});
+  }
+  // MeanVarianceNormalization has no inference function of its own, only a
+  // function body, with two ReduceMean nodes.
+  for (int i = 0; i < 8; ++i) {
+    const std::string id = std::to_string(i);
+    AddNode(
+        graph, "MeanVarianceNormalization", {i < 6 ? "X" : "W"}, "Y" + id);
+  }
+  AttributeProto* axes = graph->mutable_node(5)->add_attribute();
+  axes->set_name("axes");
+  axes->set_type(AttributeProto::INTS);
+  axes->add_ints(1);
+
+  OpLookupCountingRegistry registry("ReduceMean");
+  InferShapes(model, false, &registry);
+  // Bodies are inferred for X with the default axes, X with axes [1] and W.
+  EXPECT_EQ(registry.count, 3 * 2);
+  ASSERT_EQ(graph->value_info_size(), 8);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(
+        DimsToString(graph->value_info(i).type()),
+        i < 6 ? "1:2,3,4,5," : "1:2,6,4,5,");
+  }
+}
+
+TEST(ShapeInferenceTest, FunctionInferenceCacheForBindings) {
+  ModelProto model;
+  model.set_ir_version(IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain(ONNX_DOMAIN);
+  opset->set_version(13);
+  GraphProto* graph = model.mutable_graph();
+  auto* x = graph->add_input();
+  x->set_name("X");
+  auto* x_type = x->mutable_type()->mutable_tensor_type();
+  x_type->set_elem_type(TensorProto::FLOAT);
+  CreateDims(*x_type, 4);
+  auto* cond = graph->add_input();
+  cond->set_name("cond");
+  cond->mutable_type()->mutable_tensor_type()->set_elem_type(
+      TensorProto::BOOL);
+  cond->mutable_type()->mutable_tensor_type()->mutable_shape();
+  // If(cond, MeanVarianceNormalization(X), MeanVarianceNormalization(X))
+  NodeProto* if_node = AddNode(graph, "If", {"cond"}, "Y");
+  for (const char* name : {"then_branch", "else_branch"}) {
+    AttributeProto* branch = if_node->add_attribute();
+    branch->set_name(name);
+    branch->set_type(AttributeProto::GRAPH);
+    GraphProto* body = branch->mutable_g();
+    body->set_name(name);
+    AddNode(body, "MeanVarianceNormalization", {"X"}, "Z");
+    auto* z = body->add_output();
+    z->set_name("Z");
+    z->mutable_type()->mutable_tensor_type()->set_elem_type(
+        TensorProto::FLOAT);
+  }
+
+  std::vector<InputShapeBinding> bindings(2);
+  for (auto& binding : bindings) {
+    for (int64_t dim : {2, 3, 4, 5}) {
+      binding["X"].add_dim()->set_dim_value(dim);
+    }
+  }
+  OpLookupCountingRegistry registry("ReduceMean");
+  auto results = InferShapesForBindings(
+      model, bindings, ShapeInferenceOptions(), &registry);
+  // One body for both branches of both bindings.
+  EXPECT_EQ(registry.count, 2);
+  for (const auto& result : results) {
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(DimsToString(result[0].type()), "1:2,3,4,5,");
+  }
+
+  // Input data is keyed by contents only while it is small.
+  graph->clear_node();
+  AddNode(graph, "MeanVarianceNormalization", {"X"}, "Y0");
+  AddNode(graph, "MeanVarianceNormalization", {"X"}, "Y1");
+  TensorProto* weights = graph->add_initializer();
+  weights->set_name("X");
+  weights->set_data_type(TensorProto::FLOAT);
+  for (int64_t dim : {2, 3, 4, 5}) {
+    weights->add_dims(dim);
+  }
+  weights->mutable_float_data()->Resize(2 * 3 * 4 * 5, 0.f);
+  SetDimValues(*x_type, {2, 3, 4, 5});
+  ModelProto inferred = model;
+  registry.count = 0;
+  InferShapes(inferred, false, &registry);
+  EXPECT_EQ(registry.count, 2);
+  weights->set_dims(1, 30);
+  weights->mutable_float_data()->Resize(2 * 30 * 4 * 5, 0.f);
+  SetDimValues(*x_type, {2, 30, 4, 5});
+  inferred = model;
+  registry.count = 0;
+  InferShapes(inferred, false, &registry);
+  EXPECT_EQ(registry.count, 2 * 2);
+}
+
 } // namespace Test
 } // namespace ONNX_NAMESPACE
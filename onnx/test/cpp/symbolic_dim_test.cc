@@ -0,0 +1,201 @@
+#include <iostream>
+#include <limits>
+#include "gtest/gtest.h"
+#include "onnx/defs/symbolic_dim.h"
+#include "onnx/shape_inference/implementation.h"
+
+namespace ONNX_NAMESPACE {
+namespace Test {
+
+static std::string Canonical(const std::string& text) {
+  return SymbolicDim::Parse(text).ToString();
+}
+
+TEST(SymbolicDimTest, CanonicalForm) {
+  EXPECT_EQ(Canonical("seq*batch"), "batch*seq");
+  EXPECT_EQ(Canonical("1 + seq"), "seq + 1");
+  EXPECT_EQ(Canonical("(a + b)*(a - b)"), "a*a - b*b");
+  EXPECT_EQ(Canonical("2*(seq + 1) - seq - 2"), "seq");
+  EXPECT_EQ(Canonical("seq - seq"), "0");
+  EXPECT_TRUE(SymbolicDim::Parse("3*4").is_constant());
+  EXPECT_EQ(SymbolicDim::Parse("3*4").constant_value(), 12);
+  // Names that are not expressions are opaque symbols.
+  EXPECT_EQ(Canonical("batch size"), "batch size");
+  EXPECT_EQ(
+      (SymbolicDim::Parse("batch size") * SymbolicDim(2)).ToString(),
+      "2*batch size");
+
+  SymbolicDim a = SymbolicDim::Symbol("a");
+  SymbolicDim b = SymbolicDim::Symbol("b");
+  EXPECT_EQ(a * b + SymbolicDim(1), b * a + SymbolicDim(1));
+  EXPECT_FALSE((a * SymbolicDim::Unknown()).is_known());
+  EXPECT_EQ(SymbolicDim::Unknown().ToString(), "");
+}
+
+TEST(SymbolicDimTest, FloorDivision) {
+  EXPECT_EQ(Canonical("6*a*b // (2*a)"), "3*b");
+  EXPECT_EQ(Canonical("(2*a + 3) // 2"), "a + 1");
+  EXPECT_EQ(Canonical("(seq + 1) // 2"), "(seq + 1)//2");
+  EXPECT_EQ(Canonical("(3*seq + 5) // 2"), "(seq + 1)//2 + seq + 2");
+  EXPECT_EQ(Canonical("a // b"), "a//b");
+  EXPECT_EQ(Canonical("2 * (a // 3)"), "2*(a//3)");
+  EXPECT_EQ(Canonical("-(a // 3)"), "-(a//3)");
+  EXPECT_EQ(Canonical("a // (b * c)"), "a//(b*c)");
+  EXPECT_FALSE(
+      SymbolicDim::FloorDiv(SymbolicDim::Symbol("a"), SymbolicDim(0))
+          .is_known());
+  EXPECT_FALSE(
+      SymbolicDim::ExactDiv(SymbolicDim::Symbol("a"), SymbolicDim(2))
+          .is_known());
+
+  // Canonical text reads back as the same expression.
+  for (const char* text :
+       {"(3*seq + 5) // 2", "2 * (a // 3)", "-(a // 3) + b", "a // (b*c)"}) {
+    SymbolicDim dim = SymbolicDim::Parse(text);
+    EXPECT_EQ(SymbolicDim::Parse(dim.ToString()), dim) << text;
+  }
+}
+
+static SymbolicDim FromParam(const std::string& param) {
+  TensorShapeProto::Dimension dim;
+  dim.set_dim_param(param);
+  return SymbolicDim::FromDimension(dim);
+}
+
+TEST(SymbolicDimTest, ParamNames) {
+  SymbolicDim size = SymbolicDim::Symbol("size");
+  EXPECT_EQ(Canonical("batch-size"), "batch-size");
+  EXPECT_EQ((FromParam("batch-size") + size).ToString(), "batch-size + size");
+  EXPECT_EQ(FromParam("batch-size") + size - size, FromParam("batch-size"));
+  EXPECT_NE(FromParam("batch-size") + size, SymbolicDim::Symbol("batch"));
+  // Only canonical text is read as an expression.
+  EXPECT_EQ(FromParam("seq + 1"), SymbolicDim::Parse("seq + 1"));
+  EXPECT_EQ(FromParam("(batch - size) + size").ToString(),
+            "(batch - size) + size");
+  EXPECT_NE(FromParam("(batch - size) + size"), SymbolicDim::Symbol("batch"));
+}
+
+TEST(SymbolicDimTest, Positive) {
+  EXPECT_TRUE(SymbolicDim::Parse("seq + 1").is_positive());
+  EXPECT_TRUE(SymbolicDim::Parse("2*a*b + a + 3").is_positive());
+  EXPECT_TRUE(SymbolicDim(1).is_positive());
+  EXPECT_FALSE(SymbolicDim::Parse("seq").is_positive());
+  EXPECT_FALSE(SymbolicDim::Parse("seq - 1").is_positive());
+  EXPECT_FALSE(SymbolicDim::Parse("a - b + 2").is_positive());
+  EXPECT_FALSE(SymbolicDim::Parse("(seq - 2)//2 + 1").is_positive());
+  EXPECT_FALSE(SymbolicDim(0).is_positive());
+  EXPECT_FALSE(SymbolicDim::Unknown().is_positive());
+}
+
+TEST(SymbolicDimTest, Limits) {
+  SymbolicDim big(std::numeric_limits<int64_t>::max());
+  EXPECT_FALSE((big + SymbolicDim(1)).is_known());
+  EXPECT_FALSE((big * SymbolicDim::Symbol("a") * SymbolicDim(2)).is_known());
+
+  SymbolicDim sum;
+  for (int i = 0; i < 32; ++i) {
+    sum = sum + SymbolicDim::Symbol("s" + std::to_string(i));
+  }
+  EXPECT_FALSE(sum.is_known());
+  EXPECT_EQ(Canonical(std::string(100, '(') + "a" + std::string(100, ')')),
+            std::string(100, '(') + "a" + std::string(100, ')'));
+}
+
+static void AddTensor(
+    ValueInfoProto* value_info,
+    const std::string& name,
+    const std::vector<std::string>& dims) {
+  value_info->set_name(name);
+  auto* tensor_type = value_info->mutable_type()->mutable_tensor_type();
+  tensor_type->set_elem_type(TensorProto::FLOAT);
+  auto* shape = tensor_type->mutable_shape();
+  for (const auto& dim : dims) {
+    SymbolicDim::Parse(dim).ToDimension(shape->add_dim());
+  }
+}
+
+static NodeProto* AddNode(
+    GraphProto* graph,
+    const std::string& op_type,
+    const std::vector<std::string>& inputs,
+    const std::string& output) {
+  NodeProto* node = graph->add_node();
+  node->set_op_type(op_type);
+  for (const auto& input : inputs) {
+    node->add_input(input);
+  }
+  node->add_output(output);
+  return node;
+}
+
+static std::vector<std::string> InferredDims(
+    const ModelProto& model,
+    const std::string& name) {
+  for (const auto& value_info : model.graph().value_info()) {
+    if (value_info.name() != name) {
+      continue;
+    }
+    std::vector<std::string> dims;
+    for (const auto& dim : value_info.type().tensor_type().shape().dim()) {
+      dims.push_back(
+          dim.has_dim_value() ? std::to_string(dim.dim_value())
+                              : dim.dim_param());
+    }
+    return dims;
+  }
+  return {"<not inferred>"};
+}
+
+TEST(SymbolicDimTest, ShapeInference) {
+  ModelProto model;
+  model.set_ir_version(IR_VERSION);
+  auto* opset = model.add_opset_import();
+  opset->set_domain(ONNX_DOMAIN);
+  opset->set_version(13);
+  GraphProto* graph = model.mutable_graph();
+  AddTensor(graph->add_input(), "X", {"batch", "seq", "64"});
+  AddTensor(graph->add_input(), "Y", {"batch", "1", "64"});
+
+  AttributeProto axis;
+  axis.set_name("axis");
+  axis.set_type(AttributeProto::INT);
+  axis.set_i(2);
+  *AddNode(graph, "Flatten", {"X"}, "flat")->add_attribute() = axis;
+  axis.set_i(1);
+  *AddNode(graph, "Concat", {"X", "Y"}, "cat")->add_attribute() = axis;
+
+  TensorProto* target = graph->add_initializer();
+  target->set_name("target");
+  target->set_data_type(TensorProto::INT64);
+  target->add_dims(2);
+  target->add_int64_data(0);
+  target->add_int64_data(-1);
+  AddTensor(graph->add_input(), "target", {"2"});
+  graph->mutable_input(2)->mutable_type()->mutable_tensor_type()->set_elem_type(
+      TensorProto::INT64);
+  AddNode(graph, "Reshape", {"cat", "target"}, "reshaped");
+  AddTensor(graph->add_input(), "Z", {"2", "C", "H", "10"});
+  AttributeProto blocksize;
+  blocksize.set_name("blocksize");
+  blocksize.set_type(AttributeProto::INT);
+  blocksize.set_i(10);
+  *AddNode(graph, "DepthToSpace", {"Z"}, "depth")->add_attribute() =
+      blocksize;
+
+  shape_inference::InferShapes(model);
+  EXPECT_EQ(
+      InferredDims(model, "flat"),
+      std::vector<std::string>({"batch*seq", "64"}));
+  EXPECT_EQ(
+      InferredDims(model, "cat"),
+      std::vector<std::string>({"batch", "seq + 1", "64"}));
+  EXPECT_EQ(
+      InferredDims(model, "reshaped"),
+      std::vector<std::string>({"batch", "64*seq + 64"}));
+  EXPECT_EQ(
+      InferredDims(model, "depth"),
+      std::vector<std::string>({"2", "C//100", "10*H", "100"}));
+}
+
+} // namespace Test
+} // namespace ONNX_NAMESPACE
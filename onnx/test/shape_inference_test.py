@@ -10,6 +10,8 @@ from typing import Sequence, Union, Text, Tuple, List, Any, Optional
 import onnx.shape_inference
 import unittest
 import os
+import shutil
+import tempfile
 import numpy as np  # type: ignore
 
 
@@ -207,6 +209,23 @@ class TestShapeInference(unittest.TestCase):
             [])
         self._assert_inferred(graph, [make_tensor_value_info('z', TensorProto.FLOAT, ("a", 2))])
 
+    def test_concat_param_axis(self):  # type: () -> None
+        graph = self._make_graph(
+            [("x", TensorProto.FLOAT, ("a", 2)),
+             ("y", TensorProto.FLOAT, ("b", 2)),
+             ("z", TensorProto.FLOAT, (3, 2))],
+            [make_node("Concat", ['x', 'y', 'z'], ['out'], axis=0)],
+            [])
+        self._assert_inferred(graph, [make_tensor_value_info('out', TensorProto.FLOAT, ("a + b + 3", 2))])  # type: ignore
+
+    def test_concat_param_axis_hyphenated(self):  # type: () -> None
+        graph = self._make_graph(
+            [("x", TensorProto.FLOAT, ("batch-size", 2)),
+             ("y", TensorProto.FLOAT, ("size", 2))],
+            [make_node("Concat", ['x', 'y'], ['z'], axis=0)],
+            [])
+        self._assert_inferred(graph, [make_tensor_value_info('z', TensorProto.FLOAT, ("batch-size + size", 2))])  # type: ignore
+
     def test_reshape_dynamic_shape(self):  # type: () -> None
         graph = self._make_graph(
             [('x', TensorProto.UINT8, (2, 4, 3)),
@@ -925,7 +944,7 @@ class TestShapeInference(unittest.TestCase):
             [('x', TensorProto.FLOAT, (2, 'N', 4, 5))],
             [make_node('Flatten', ['x'], ['z'], axis=2)],
             [])
-        self._assert_inferred(graph, [make_tensor_value_info('z', TensorProto.FLOAT, (None, 20))])  # type: ignore
+        self._assert_inferred(graph, [make_tensor_value_info('z', TensorProto.FLOAT, ('2*N', 20))])  # type: ignore
 
     def test_space_to_depth(self):  # type: () -> None
         b = 10
@@ -941,7 +960,7 @@ class TestShapeInference(unittest.TestCase):
             [('x', TensorProto.FLOAT, (2, 'N', 100, 100))],
             [make_node('SpaceToDepth', ['x'], ['z'], blocksize=b)],
             [])
-        self._assert_inferred(graph, [make_tensor_value_info('z', TensorProto.FLOAT, (2, None, 10, 10))])  # type: ignore
+        self._assert_inferred(graph, [make_tensor_value_info('z', TensorProto.FLOAT, (2, '100*N', 10, 10))])  # type: ignore
 
     def test_depth_to_space(self):  # type: () -> None
         b = 10
@@ -951,6 +970,14 @@ class TestShapeInference(unittest.TestCase):
             [])
         self._assert_inferred(graph, [make_tensor_value_info('z', TensorProto.FLOAT, (2, 3, 100, 100))])
 
+    def test_depth_to_space_unknown_dim(self):  # type: () -> None
+        b = 10
+        graph = self._make_graph(
+            [('x', TensorProto.FLOAT, (2, 'C', 'H', 10))],
+            [make_node('DepthToSpace', ['x'], ['z'], blocksize=b, mode='DCR')],
+            [])
+        self._assert_inferred(graph, [make_tensor_value_info('z', TensorProto.FLOAT, (2, 'C//100', '10*H', 100))])  # type: ignore
+
     def _rnn_forward(self, seqlen, batchsize, inpsize, hiddensize):  # type: (int, int, int, int) -> None
         graph = self._make_graph(
             [('x', TensorProto.FLOAT, (seqlen, batchsize, inpsize)),
@@ -3232,6 +3259,100 @@ class TestShapeInference(unittest.TestCase):
         )
         self._assert_inferred(graph, [make_tensor_value_info('Y', TensorProto.FLOAT, (25, 48, 16, 16))])
 
+    def test_infer_shapes_path(self):  # type: () -> None
+        graph = self._make_graph(
+            [("X", TensorProto.FLOAT, (2, 3, 4))],
+            [make_node("Transpose", ["X"], ["Y"], perm=[1, 0, 2])],
+            [])
+        model = helper.make_model(graph, producer_name='onnx-test')
+        temp_dir = tempfile.mkdtemp()
+        model_path = os.path.join(temp_dir, 'model.onnx')
+        inferred_path = os.path.join(temp_dir, 'inferred.onnx')
+        onnx.save(model, model_path)
+        onnx.shape_inference.infer_shapes_path(model_path, inferred_path)
+        inferred_model = onnx.load(inferred_path)
+        checker.check_model(inferred_model)
+        self.assertIn(make_tensor_value_info("Y", TensorProto.FLOAT, (3, 2, 4)),
+                      inferred_model.graph.value_info)
+        shutil.rmtree(temp_dir)
+
+    def test_data_propagation(self):  # type: () -> None
+        graph = helper.make_graph(
+            [make_node('Shape', ['X'], ['shape']),
+             make_node('Gather', ['shape', 'index'], ['batch']),
+             make_node('Concat', ['batch', 'minus_one'], ['target'], axis=0),
+             make_node('Reshape', ['X', 'target'], ['Y'])],
+            'test',
+            [make_tensor_value_info('X', TensorProto.FLOAT, ('batch', 'seq', 64)),
+             make_tensor_value_info('index', TensorProto.INT64, (1,)),
+             make_tensor_value_info('minus_one', TensorProto.INT64, (1,))],
+            [],
+            initializer=[make_tensor('index', TensorProto.INT64, (1,), (0,)),
+                         make_tensor('minus_one', TensorProto.INT64, (1,), (-1,))])
+        model = helper.make_model(graph, producer_name='onnx-test')
+        inferred_model = onnx.shape_inference.infer_shapes(model, data_prop=True)
+        checker.check_model(inferred_model)
+        # batch may be 0 at runtime, so the -1 entry is not inferred.
+        self.assertIn(make_tensor_value_info('Y', TensorProto.FLOAT, ('batch', None)),  # type: ignore
+                      inferred_model.graph.value_info)
+
+        inferred_model = onnx.shape_inference.infer_shapes(model)
+        self.assertIn(make_tensor_value_info('Y', TensorProto.FLOAT, None),
+                      inferred_model.graph.value_info)
+
+    def test_infer_shapes_for_bindings(self):  # type: () -> None
+        graph = helper.make_graph(
+            [make_node('Relu', ['X'], ['Y']),
+             make_node('Transpose', ['Y'], ['Z'])],
+            'test',
+            [make_tensor_value_info('X', TensorProto.FLOAT, ('N', 3))],
+            [])
+        model = helper.make_model(graph, producer_name='onnx-test')
+        results = onnx.shape_inference.infer_shapes_for_bindings(
+            model, [{'X': (2, 3)}, {'X': (8, 3)}, {}])
+        self.assertEqual(results[0], [make_tensor_value_info('Y', TensorProto.FLOAT, (2, 3)),
+                                      make_tensor_value_info('Z', TensorProto.FLOAT, (3, 2))])
+        self.assertEqual(results[1], [make_tensor_value_info('Y', TensorProto.FLOAT, (8, 3)),
+                                      make_tensor_value_info('Z', TensorProto.FLOAT, (3, 8))])
+        self.assertEqual(results[2], [make_tensor_value_info('Y', TensorProto.FLOAT, ('N', 3)),
+                                      make_tensor_value_info('Z', TensorProto.FLOAT, (3, 'N'))])
+        self.assertEqual(len(model.graph.value_info), 0)
+
+    def test_estimate_cost(self):  # type: () -> None
+        graph = helper.make_graph(
+            [make_node('MatMul', ['X', 'W'], ['Y']),
+             make_node('Relu', ['Y'], ['Z'])],
+            'test',
+            [make_tensor_value_info('X', TensorProto.FLOAT, (2, 3))],
+            [make_tensor_value_info('Z', TensorProto.FLOAT, (2, 4))],
+            initializer=[make_tensor('W', TensorProto.FLOAT, (3, 4), [0.0] * 12)])
+        model = helper.make_model(graph, producer_name='onnx-test')
+        cost = onnx.shape_inference.estimate_cost(model)
+        self.assertEqual(cost['flops'], 2 * 3 * 8 + 8)
+        self.assertEqual(cost['param_bytes'], 48)
+        self.assertEqual(cost['activation_bytes_read'], 24 + 32)
+        self.assertEqual(cost['activation_bytes_written'], 32 + 32)
+        self.assertTrue(cost['complete'])
+        self.assertEqual(cost['num_unestimated_nodes'], 0)
+
+    def test_plan_memory(self):  # type: () -> None
+        graph = helper.make_graph(
+            [make_node('Relu', ['X'], ['A']),
+             make_node('Relu', ['A'], ['B']),
+             make_node('Add', ['A', 'B'], ['C'])],
+            'test',
+            [make_tensor_value_info('X', TensorProto.FLOAT, (4, 4))],
+            [make_tensor_value_info('C', TensorProto.FLOAT, (4, 4))])
+        model = helper.make_model(graph, producer_name='onnx-test')
+        plan = onnx.shape_inference.plan_memory(model)
+        self.assertEqual([(t['name'], t['first_use'], t['last_use'], t['offset'])
+                          for t in plan['tensors']],
+                         [('X', -1, 0, 0), ('A', 0, 2, 64), ('B', 1, 2, 0), ('C', 2, 3, 128)])
+        self.assertEqual(plan['peak_bytes'], 192)
+        self.assertEqual(plan['peak_node'], 2)
+        self.assertEqual(plan['arena_bytes'], 192)
+        self.assertTrue(plan['complete'])
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -142,6 +142,13 @@ class TestLoadExternalDataSingleFile(TestLoadExternalDataBase):
         attribute_tensor = model.graph.node[0].attribute[0].t
         self.assertTrue(np.allclose(to_array(attribute_tensor), self.attribute_value))
 
+    def test_check_model_truncated_data_file(self):  # type: () -> None
+        checker.check_model(self.model_filename)
+        # The second tensor starts at offset 4096, so it no longer fits.
+        with open(os.path.join(self.temp_dir, "tensors.bin"), 'r+b') as data_file:
+            data_file.truncate(4096)
+        self.assertRaises(checker.ValidationError, checker.check_model, self.model_filename)
+
     def test_save_external_single_file_data(self):  # type: () -> None
         model = onnx.load_model(self.model_filename)
 
@@ -0,0 +1,399 @@
+// Benchmarks of the checker, shape inference, optimizer, version converter
+// and IR conversion over synthetic models of increasing size.
+//
+// Model families (the benchmark argument is the size parameter):
+//   ResNet/n         chain of n residual Conv blocks
+//   Transformer/n    n attention + feed-forward layers with 8 heads each
+//   Initializers/n   n small initializers folded into a chain of Adds
+//   ControlFlow/n    Loop/If bodies nested n levels deep
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "onnx/checker.h"
+#include "onnx/common/ir_pb_converter.h"
+#include "onnx/optimizer/optimize.h"
+#include "onnx/shape_inference/implementation.h"
+#include "onnx/version_converter/convert.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace {
+
+const int kOpsetVersion = 11;
+
+void setTensorType(
+    TypeProto* type,
+    int32_t elem_type,
+    const std::vector<int64_t>& dims) {
+  TypeProto_Tensor* tensor_type = type->mutable_tensor_type();
+  tensor_type->set_elem_type(elem_type);
+  TensorShapeProto* shape = tensor_type->mutable_shape();
+  for (int64_t dim : dims) {
+    shape->add_dim()->set_dim_value(dim);
+  }
+}
+
+void addValueInfo(
+    google::protobuf::RepeatedPtrField<ValueInfoProto>* infos,
+    const std::string& name,
+    const std::vector<int64_t>& dims,
+    int32_t elem_type = TensorProto_DataType_FLOAT) {
+  ValueInfoProto* value_info = infos->Add();
+  value_info->set_name(name);
+  setTensorType(value_info->mutable_type(), elem_type, dims);
+}
+
+// Float initializer filled with zeros, stored in raw_data. It is also listed
+// as a graph input, which the IR importer expects.
+void addInitializer(
+    GraphProto* graph,
+    const std::string& name,
+    const std::vector<int64_t>& dims) {
+  addValueInfo(graph->mutable_input(), name, dims);
+  TensorProto* tensor = graph->add_initializer();
+  tensor->set_name(name);
+  tensor->set_data_type(TensorProto_DataType_FLOAT);
+  int64_t size = 1;
+  for (int64_t dim : dims) {
+    tensor->add_dims(dim);
+    size *= dim;
+  }
+  tensor->mutable_raw_data()->assign(size * sizeof(float), '\0');
+}
+
+NodeProto* addNode(
+    GraphProto* graph,
+    const std::string& op_type,
+    const std::vector<std::string>& inputs,
+    const std::vector<std::string>& outputs) {
+  NodeProto* node = graph->add_node();
+  node->set_op_type(op_type);
+  for (const auto& input : inputs) {
+    node->add_input(input);
+  }
+  for (const auto& output : outputs) {
+    node->add_output(output);
+  }
+  return node;
+}
+
+void addIntsAttribute(
+    NodeProto* node,
+    const std::string& name,
+    const std::vector<int64_t>& values) {
+  AttributeProto* attr = node->add_attribute();
+  attr->set_name(name);
+  attr->set_type(AttributeProto::INTS);
+  for (int64_t value : values) {
+    attr->add_ints(value);
+  }
+}
+
+ModelProto createModel(int opset_version = kOpsetVersion) {
+  ModelProto model;
+  model.set_ir_version(IR_VERSION);
+  OperatorSetIdProto* opset = model.add_opset_import();
+  opset->set_domain("");
+  opset->set_version(opset_version);
+  model.mutable_graph()->set_name("bench");
+  return model;
+}
+
+// Residual blocks of Conv -> Relu -> Conv -> Add -> Relu on a 16 channel
+// 32x32 feature map.
+ModelProto createResNet(int64_t blocks, int opset_version = kOpsetVersion) {
+  const int64_t channels = 16;
+  ModelProto model = createModel(opset_version);
+  GraphProto* graph = model.mutable_graph();
+  addValueInfo(graph->mutable_input(), "x0", {1, channels, 32, 32});
+  std::string x = "x0";
+  for (int64_t i = 0; i < blocks; ++i) {
+    const std::string id = std::to_string(i);
+    std::string conv_out = x;
+    for (int j = 0; j < 2; ++j) {
+      const std::string suffix = id + "_" + std::to_string(j);
+      addInitializer(graph, "w" + suffix, {channels, channels, 3, 3});
+      addInitializer(graph, "b" + suffix, {channels});
+      NodeProto* conv = addNode(
+          graph,
+          "Conv",
+          {conv_out, "w" + suffix, "b" + suffix},
+          {"conv" + suffix});
+      addIntsAttribute(conv, "kernel_shape", {3, 3});
+      addIntsAttribute(conv, "pads", {1, 1, 1, 1});
+      conv_out = "conv" + suffix;
+      if (j == 0) {
+        addNode(graph, "Relu", {conv_out}, {"relu" + suffix});
+        conv_out = "relu" + suffix;
+      }
+    }
+    addNode(graph, "Add", {conv_out, x}, {"sum" + id});
+    x = "x" + std::to_string(i + 1);
+    addNode(graph, "Relu", {"sum" + id}, {x});
+  }
+  addValueInfo(graph->mutable_output(), x, {1, channels, 32, 32});
+  return model;
+}
+
+// Multi-head self-attention followed by a feed-forward block, per layer.
+ModelProto createTransformer(int64_t layers) {
+  const int64_t seq = 128;
+  const int64_t hidden = 256;
+  const int64_t heads = 8;
+  const int64_t head_dim = hidden / heads;
+  ModelProto model = createModel();
+  GraphProto* graph = model.mutable_graph();
+  addValueInfo(graph->mutable_input(), "h0", {seq, hidden});
+  addInitializer(graph, "scale", {});
+  std::string h = "h0";
+  for (int64_t l = 0; l < layers; ++l) {
+    const std::string id = std::to_string(l);
+    std::vector<std::string> head_outputs;
+    for (int64_t k = 0; k < heads; ++k) {
+      const std::string hid = id + "_" + std::to_string(k);
+      for (const char* proj : {"q", "k", "v"}) {
+        addInitializer(graph, proj + ("w" + hid), {hidden, head_dim});
+        addNode(graph, "MatMul", {h, proj + ("w" + hid)}, {proj + hid});
+      }
+      addIntsAttribute(
+          addNode(graph, "Transpose", {"k" + hid}, {"kt" + hid}),
+          "perm",
+          {1, 0});
+      addNode(graph, "MatMul", {"q" + hid, "kt" + hid}, {"qk" + hid});
+      addNode(graph, "Div", {"qk" + hid, "scale"}, {"scaled" + hid});
+      addNode(graph, "Softmax", {"scaled" + hid}, {"attn" + hid});
+      addNode(graph, "MatMul", {"attn" + hid, "v" + hid}, {"head" + hid});
+      head_outputs.push_back("head" + hid);
+    }
+    NodeProto* concat = addNode(graph, "Concat", head_outputs, {"heads" + id});
+    AttributeProto* axis = concat->add_attribute();
+    axis->set_name("axis");
+    axis->set_type(AttributeProto::INT);
+    axis->set_i(1);
+    addInitializer(graph, "wo" + id, {hidden, hidden});
+    addNode(graph, "MatMul", {"heads" + id, "wo" + id}, {"proj" + id});
+    addNode(graph, "Add", {"proj" + id, h}, {"res" + id});
+    addInitializer(graph, "w1_" + id, {hidden, 4 * hidden});
+    addInitializer(graph, "b1_" + id, {4 * hidden});
+    addInitializer(graph, "w2_" + id, {4 * hidden, hidden});
+    addNode(graph, "MatMul", {"res" + id, "w1_" + id}, {"ff1" + id});
+    addNode(graph, "Add", {"ff1" + id, "b1_" + id}, {"ff1b" + id});
+    addNode(graph, "Relu", {"ff1b" + id}, {"ffr" + id});
+    addNode(graph, "MatMul", {"ffr" + id, "w2_" + id}, {"ff2" + id});
+    h = "h" + std::to_string(l + 1);
+    addNode(graph, "Add", {"ff2" + id, "res" + id}, {h});
+  }
+  addValueInfo(graph->mutable_output(), h, {seq, hidden});
+  return model;
+}
+
+ModelProto createManyInitializers(int64_t count) {
+  ModelProto model = createModel();
+  GraphProto* graph = model.mutable_graph();
+  addValueInfo(graph->mutable_input(), "y0", {64});
+  std::string y = "y0";
+  for (int64_t i = 0; i < count; ++i) {
+    const std::string id = std::to_string(i);
+    addInitializer(graph, "c" + id, {64});
+    y = "y" + std::to_string(i + 1);
+    addNode(graph, "Add", {"y" + id, "c" + id}, {y});
+  }
+  addValueInfo(graph->mutable_output(), y, {64});
+  return model;
+}
+
+// Body of a Loop whose If branches each hold the next level of nesting.
+// The innermost branches apply Relu to the loop-carried value.
+void fillLoopBody(GraphProto* body, int64_t depth, const std::string& prefix) {
+  body->set_name(prefix + "loop");
+  addValueInfo(
+      body->mutable_input(), prefix + "iter", {}, TensorProto_DataType_INT64);
+  addValueInfo(
+      body->mutable_input(), prefix + "cond", {}, TensorProto_DataType_BOOL);
+  addValueInfo(body->mutable_input(), prefix + "x", {16});
+  addNode(body, "Identity", {prefix + "cond"}, {prefix + "cond_out"});
+  NodeProto* if_node =
+      addNode(body, "If", {prefix + "cond"}, {prefix + "x_out"});
+  for (const char* branch : {"then_branch", "else_branch"}) {
+    const std::string branch_prefix = prefix + branch[0];
+    AttributeProto* attr = if_node->add_attribute();
+    attr->set_name(branch);
+    attr->set_type(AttributeProto::GRAPH);
+    GraphProto* branch_graph = attr->mutable_g();
+    branch_graph->set_name(branch_prefix + "branch");
+    const std::string out = branch_prefix + "out";
+    addValueInfo(branch_graph->mutable_output(), out, {16});
+    if (depth <= 1) {
+      addNode(branch_graph, "Relu", {prefix + "x"}, {out});
+      continue;
+    }
+    NodeProto* loop = addNode(
+        branch_graph, "Loop", {"", prefix + "cond", prefix + "x"}, {out});
+    AttributeProto* loop_body = loop->add_attribute();
+    loop_body->set_name("body");
+    loop_body->set_type(AttributeProto::GRAPH);
+    fillLoopBody(loop_body->mutable_g(), depth - 1, branch_prefix);
+  }
+  addValueInfo(
+      body->mutable_output(),
+      prefix + "cond_out",
+      {},
+      TensorProto_DataType_BOOL);
+  addValueInfo(body->mutable_output(), prefix + "x_out", {16});
+}
+
+ModelProto createControlFlow(int64_t depth) {
+  ModelProto model = createModel();
+  GraphProto* graph = model.mutable_graph();
+  addValueInfo(graph->mutable_input(), "trip", {}, TensorProto_DataType_INT64);
+  addValueInfo(graph->mutable_input(), "cond", {}, TensorProto_DataType_BOOL);
+  addValueInfo(graph->mutable_input(), "x", {16});
+  NodeProto* loop = addNode(graph, "Loop", {"trip", "cond", "x"}, {"y"});
+  AttributeProto* body = loop->add_attribute();
+  body->set_name("body");
+  body->set_type(AttributeProto::GRAPH);
+  fillLoopBody(body->mutable_g(), depth, "l");
+  addValueInfo(graph->mutable_output(), "y", {16});
+  return model;
+}
+
+struct ModelFamily {
+  const char* name;
+  std::function<ModelProto(int64_t)> create;
+  int64_t min_size;
+  int64_t max_size;
+};
+
+const std::vector<ModelFamily>& modelFamilies() {
+  static const std::vector<ModelFamily> families = {
+      {"ResNet", [](int64_t n) { return createResNet(n); }, 8, 512},
+      {"Transformer", createTransformer, 1, 32},
+      {"Initializers", createManyInitializers, 64, 16384},
+      {"ControlFlow", createControlFlow, 1, 8},
+  };
+  return families;
+}
+
+void reportModelSize(benchmark::State& state, const ModelProto& model) {
+  state.counters["nodes"] = model.graph().node_size();
+  state.counters["bytes"] = static_cast<double>(model.ByteSizeLong());
+}
+
+void checkModel(benchmark::State& state, const ModelFamily& family) {
+  const ModelProto model = family.create(state.range(0));
+  for (auto _ : state) {
+    checker::check_model(model);
+  }
+  reportModelSize(state, model);
+}
+
+void inferShapes(benchmark::State& state, const ModelFamily& family) {
+  const ModelProto model = family.create(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    ModelProto inferred = model;
+    state.ResumeTiming();
+    shape_inference::InferShapes(inferred);
+  }
+  reportModelSize(state, model);
+}
+
+void importModel(benchmark::State& state, const ModelFamily& family) {
+  const ModelProto model = family.create(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ImportModelProto(model));
+  }
+  reportModelSize(state, model);
+}
+
+void exportModel(benchmark::State& state, const ModelFamily& family) {
+  const ModelProto model = family.create(state.range(0));
+  std::shared_ptr<Graph> graph(ImportModelProto(model));
+  for (auto _ : state) {
+    ModelProto exported;
+    ExportModelProto(&exported, graph);
+    benchmark::DoNotOptimize(exported);
+  }
+  reportModelSize(state, model);
+}
+
+void optimize(
+    benchmark::State& state,
+    const ModelFamily& family,
+    const std::string& pass) {
+  const ModelProto model = family.create(state.range(0));
+  const std::vector<std::string> passes = {pass};
+  for (auto _ : state) {
+    try {
+      benchmark::DoNotOptimize(optimization::Optimize(model, passes));
+    } catch (const std::exception& e) {
+      state.SkipWithError(e.what());
+      break;
+    }
+  }
+  reportModelSize(state, model);
+}
+
+// Every node of the ResNet chain has an adapter between opsets 8 and 9.
+void convertVersion(benchmark::State& state) {
+  const ModelProto model = createResNet(state.range(0), 8);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(version_conversion::ConvertVersion(model, 9));
+  }
+  reportModelSize(state, model);
+}
+
+void registerBenchmarks() {
+  using Fn = void (*)(benchmark::State&, const ModelFamily&);
+  const std::vector<std::pair<const char*, Fn>> benchmarks = {
+      {"CheckModel", checkModel},
+      {"InferShapes", inferShapes},
+      {"ImportModelProto", importModel},
+      {"ExportModelProto", exportModel},
+  };
+  for (const auto& family : modelFamilies()) {
+    for (const auto& bench : benchmarks) {
+      const std::string name =
+          std::string(bench.first) + "/" + family.name;
+      Fn fn = bench.second;
+      benchmark::RegisterBenchmark(
+          name.c_str(),
+          [fn, &family](benchmark::State& state) { fn(state, family); })
+          ->RangeMultiplier(4)
+          ->Range(family.min_size, family.max_size)
+          ->Unit(benchmark::kMillisecond);
+    }
+    for (const auto& pass : optimization::GetAvailablePasses()) {
+      const std::string name =
+          std::string("Optimize/") + pass + "/" + family.name;
+      benchmark::RegisterBenchmark(
+          name.c_str(),
+          [pass, &family](benchmark::State& state) {
+            optimize(state, family, pass);
+          })
+          ->RangeMultiplier(4)
+          ->Range(family.min_size, family.max_size)
+          ->Unit(benchmark::kMillisecond);
+    }
+  }
+  benchmark::RegisterBenchmark("ConvertVersion/ResNet", convertVersion)
+      ->RangeMultiplier(4)
+      ->Range(8, 512)
+      ->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  registerBenchmarks();
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}